@@ -32,6 +32,7 @@ GLD_SOURCES_PLACE_HOLDER += gldcore/gld_sock.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/globals.cpp gldcore/globals.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/gridlabd.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/gui.cpp gldcore/gui.h
+GLD_SOURCES_PLACE_HOLDER += gldcore/heap.cpp gldcore/heap.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/http_client.cpp gldcore/http_client.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/index.cpp gldcore/index.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/instance.cpp gldcore/instance.h
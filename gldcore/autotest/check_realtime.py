@@ -0,0 +1,29 @@
+# checks that a realtime test ran at wall-clock rate
+# syntax: python3 check_realtime.py CLOCKFILE PROFILE MINSTEPS
+import calendar, sys, time
+
+clockfile, profile, minsteps = sys.argv[1], sys.argv[2], int(sys.argv[3])
+with open(clockfile) as fh:
+	for line in fh:
+		if line.startswith("// started "):
+			started = float(line.split()[2])
+		elif "stoptime" in line:
+			stop = calendar.timegm(time.strptime(line.split('"')[1],"%Y-%m-%d %H:%M:%S UTC"))
+elapsed = time.time() - started
+if elapsed < stop - started - 1.0:
+	print(f"realtime run took {elapsed:.1f} s instead of {stop-started:.1f} s",file=sys.stderr)
+	sys.exit(1)
+
+steps = overruns = None
+with open(profile) as fh:
+	for line in fh:
+		if line.startswith("Steps paced"):
+			steps = int(line.split()[2])
+		elif line.startswith("Deadline overruns"):
+			overruns = int(line.split()[2])
+if steps is None or steps < minsteps:
+	print(f"realtime pacer paced {steps} steps instead of at least {minsteps}",file=sys.stderr)
+	sys.exit(1)
+if overruns > steps//10 + 1:
+	print(f"realtime pacer overran {overruns} of {steps} steps",file=sys.stderr)
+	sys.exit(1)
@@ -0,0 +1,13 @@
+# writes a clock block for a realtime test that starts now, or LEAD seconds from now,
+# and runs for the given number of seconds
+# syntax: python3 realtime_clock.py SECONDS [LEAD] > FILE.glm
+import sys, time
+
+now = int(time.time()) + ( int(sys.argv[2]) if len(sys.argv) > 2 else 0 )
+stop = now + int(sys.argv[1])
+print("clock {")
+print("\ttimezone \"UTC0\";")
+print(f"\tstarttime \"{time.strftime('%Y-%m-%d %H:%M:%S',time.gmtime(now))} UTC\";")
+print(f"\tstoptime \"{time.strftime('%Y-%m-%d %H:%M:%S',time.gmtime(stop))} UTC\";")
+print("}")
+print(f"// started {time.time()}")
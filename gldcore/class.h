@@ -224,6 +224,7 @@ typedef struct s_eventhandlers {
 	recalc - recalc function
 	update - deltamode update function
 	heartbeat - heartbeat function
+	syncbatch - batch sync function (optional, see <Batch sync functions>)
 	loadmethods - loadmethod list
 	parent - parent class
 	profiler - profiler structure
@@ -279,6 +280,8 @@ struct s_class_list {
 	FUNCTIONADDR update;
 	// Field: 
 	FUNCTIONADDR heartbeat;
+	// Field: syncbatch
+	FUNCTIONADDR syncbatch;
 	// Field: loadmethods
 	LOADMETHOD *loadmethods;
 	// Field: parent
@@ -646,6 +649,7 @@ private:
 	FUNCTIONADDR recalc;
 	FUNCTIONADDR update;
 	FUNCTIONADDR heartbeat;
+	FUNCTIONADDR syncbatch;
 	LOADMETHOD *loadmethods;
 	CLASS *parent;
 	GldProfiler profiler;
@@ -401,6 +401,16 @@ int GldCmdarg::profile(int argc, const char *argv[])
 	return 0;
 }
 
+DEPRECATED static int memory_report(void *main, int argc, const char *argv[])
+{
+	return ((GldMain*)main)->get_cmdarg()->memory_report(argc,argv);
+}
+int GldCmdarg::memory_report(int argc, const char *argv[])
+{
+	global_memory_report = !global_memory_report;
+	return 0;
+}
+
 DEPRECATED static int mt_profile(void *main, int argc, const char *argv[])
 {
 	return ((GldMain*)main)->get_cmdarg()->mt_profile(argc,argv);
@@ -2189,6 +2199,7 @@ DEPRECATED static CMDARG main_commands[] = {
 	{"debug",		NULL,	debug,			NULL, "Toggles display of debug messages" },
 	{"debugger",	NULL,	debugger,		NULL, "Enables the debugger" },
 	{"dumpall",		NULL,	dumpall,		NULL, "Dumps the global variable list" },
+	{"memory-report", NULL,	memory_report,	NULL, "Toggles output of the memory report at init and exit" },
 	{"mt_profile",	NULL,	mt_profile,		"<n-threads>", "Analyses multithreaded performance profile" },
 	{"profile",		NULL,	profile,		NULL, "Toggles performance profiling of core and modules while simulation runs" },
 	{"quiet",		"q",	quiet,			NULL, "Toggles suppression of all but error and fatal messages" },
@@ -166,6 +166,7 @@ public:
 	int modhelp(int argc, const char *argv[]);
 	int modlist(int argc, const char *argv[]);
 	int modtest(int argc, const char *argv[]);
+	int memory_report(int argc, const char *argv[]);
 	int mt_profile(int argc, const char *argv[]);
 	int origin(int argc, const char *argv[]);
 	int output(int argc, const char *argv[]);
@@ -44,6 +44,17 @@
 #define COMPARE_SIN(T) int compare_tc_##T##_in(void* x,void* a,void* b) { return strcmp((char*)x,(char*)a)>=0 && b!=NULL && strcmp((char*)x,(char*)b)<=0; }
 #define COMPARE_SNI(T) int compare_tc_##T##_ni(void* x,void* a,void* b) { return !(strcmp((char*)x,(char*)a)>=0 && b!=NULL && strcmp((char*)x,(char*)b)<=0); }
 
+#define COMPAREOPN(T) COMPARE_NEQ(T) COMPARE_NLE(T) COMPARE_NGE(T) COMPARE_NNE(T) COMPARE_NLT(T) COMPARE_NGT(T) COMPARE_NIN(T) COMPARE_NNI(T)
+#define INTERNVALUE(X) ((*(INTERN*)(X))?(*(INTERN*)(X))->value:"")
+#define COMPARE_NEQ(T) int compare_tc_##T##_eq(void* x,void* a,void* b) { return *(INTERN*)x==*(INTERN*)a; }
+#define COMPARE_NLE(T) int compare_tc_##T##_le(void* x,void* a,void* b) { return strcmp(INTERNVALUE(x),INTERNVALUE(a))<=0; }
+#define COMPARE_NGE(T) int compare_tc_##T##_ge(void* x,void* a,void* b) { return strcmp(INTERNVALUE(x),INTERNVALUE(a))>=0; }
+#define COMPARE_NNE(T) int compare_tc_##T##_ne(void* x,void* a,void* b) { return *(INTERN*)x!=*(INTERN*)a; }
+#define COMPARE_NLT(T) int compare_tc_##T##_lt(void* x,void* a,void* b) { return strcmp(INTERNVALUE(x),INTERNVALUE(a))<0; }
+#define COMPARE_NGT(T) int compare_tc_##T##_gt(void* x,void* a,void* b) { return strcmp(INTERNVALUE(x),INTERNVALUE(a))>0; }
+#define COMPARE_NIN(T) int compare_tc_##T##_in(void* x,void* a,void* b) { return strcmp(INTERNVALUE(x),INTERNVALUE(a))>=0 && b!=NULL && strcmp(INTERNVALUE(x),INTERNVALUE(b))<=0; }
+#define COMPARE_NNI(T) int compare_tc_##T##_ni(void* x,void* a,void* b) { return !(strcmp(INTERNVALUE(x),INTERNVALUE(a))>=0 && b!=NULL && strcmp(INTERNVALUE(x),INTERNVALUE(b))<=0); }
+
 /* basic ops */
 COMPAREOPF(double)
 COMPAREOPF(float)
@@ -53,3 +64,4 @@ COMPAREOPI(uint64)
 COMPAREOPB(bool)
 COMPAREOPS(string)
 COMPAREOPO(object)
+COMPAREOPN(intern)
@@ -16,6 +16,22 @@ static int delta_objectcount = 0; /* qualified object count */
 static MODULE **delta_modulelist = NULL; /* qualified module list */
 static int delta_modulecount = 0; /* qualified module count */
 
+/* localized deltamode regions (see global_deltamode_region_rate) */
+typedef struct s_deltaregion {
+	const char *name; /* groupid shared by the objects in the region */
+	bool idle; /* no object in the region requested deltamode on its last update */
+	bool due; /* region objects are updated in the current timestep */
+	bool busy; /* an object in the region requested deltamode in the current timestep */
+	unsigned int idle_steps; /* timesteps since the last update of the region */
+	DT dt; /* time elapsed since the last update of the region, used as its timestep */
+} DELTAREGION;
+static DELTAREGION *delta_regionlist = NULL; /* region list */
+static int delta_regioncount = 0; /* region count */
+static int *delta_objectregion = NULL; /* region of each qualified object */
+static int *delta_idregion = NULL; /* region of each object by id (-1 if not qualified) */
+static unsigned int delta_idcount = 0; /* size of the object id region map */
+static bool delta_regionbusy = false; /* some region requested deltamode in the last timestep */
+
 void delta_modecheck(const char*)
 {
 	if ( global_deltamode_allowed == TRUE )
@@ -31,6 +47,114 @@ DELTAPROFILE *delta_getprofile(void)
 	return &profile;
 }
 
+/** Assign the qualified objects to regions by groupid
+
+	Objects in a region are only updated every global_deltamode_region_rate
+	timesteps while none of them requests deltamode and another region does,
+	so a disturbance in one region does not force every other region to run
+	at the deltamode timestep.  Objects without a groupid are always updated.
+
+	@return SUCCESS or FAILED
+ **/
+static STATUS delta_region_init(void)
+{
+	int n, m;
+	delta_regionlist = (DELTAREGION*)malloc(sizeof(DELTAREGION)*delta_objectcount);
+	delta_objectregion = (int*)malloc(sizeof(int)*delta_objectcount);
+	delta_idcount = object_get_count();
+	delta_idregion = (int*)malloc(sizeof(int)*delta_idcount);
+	if ( delta_regionlist==NULL || delta_objectregion==NULL || delta_idregion==NULL )
+	{
+		output_error("unable to allocate memory for deltamode region list");
+		/* TROUBLESHOOT
+		  Deltamode operation requires more memory than is available.
+		  Try freeing up memory by making more heap available or making the model smaller. 
+		 */
+		return FAILED;
+	}
+	for ( n=0 ; n<(int)delta_idcount ; n++ )
+	{
+		delta_idregion[n] = -1;
+	}
+	for ( n=0 ; n<delta_objectcount ; n++ )
+	{
+		const char *name = delta_objectlist[n]->groupid;
+		for ( m=0 ; m<delta_regioncount ; m++ )
+		{
+			if ( strcmp(delta_regionlist[m].name,name)==0 )
+			{
+				break;
+			}
+		}
+		if ( m==delta_regioncount )
+		{
+			memset(&delta_regionlist[m],0,sizeof(DELTAREGION));
+			delta_regionlist[m].name = name;
+			delta_regioncount++;
+			IN_MYCONTEXT output_debug("deltamode region '%s' created", name);
+		}
+		delta_objectregion[n] = m;
+		if ( delta_objectlist[n]->id < delta_idcount )
+		{
+			delta_idregion[delta_objectlist[n]->id] = m;
+		}
+	}
+	output_verbose("deltamode objects assigned to %d regions updated every %d timesteps when quiescent", delta_regioncount, global_deltamode_region_rate);
+	return SUCCESS;
+}
+
+/** Get the region of a qualified object
+
+	@return the region, or NULL if regions are not enabled or the object is not qualified
+ **/
+static DELTAREGION *delta_region_find(OBJECT *obj)
+{
+	if ( delta_idregion==NULL || obj==NULL || obj->id>=delta_idcount || delta_idregion[obj->id]<0 )
+	{
+		return NULL;
+	}
+	return &delta_regionlist[delta_idregion[obj->id]];
+}
+
+/** Determine whether an object is held in the current timestep
+
+	Modules that update their deltamode objects in their own interupdate
+	must skip objects that are held.
+
+	@return true if the object's region is not updated in this timestep
+ **/
+bool delta_region_held(OBJECT *obj)
+{
+	DELTAREGION *region = delta_region_find(obj);
+	return region!=NULL && ! region->due;
+}
+
+/** Get the timestep of an object in the current timestep
+
+	An object in a region that was held is updated over the time elapsed
+	since the region's last update rather than the deltamode timestep.
+
+	@return the timestep to use for the object's update
+ **/
+DT delta_region_timestep(OBJECT *obj, DT timestep)
+{
+	DELTAREGION *region = delta_region_find(obj);
+	return region!=NULL ? region->dt : timestep;
+}
+
+/** Report the result of a module-level object update
+
+	Any request to stay in deltamode or iterate keeps the object's region active.
+ **/
+void delta_region_report(OBJECT *obj, SIMULATIONMODE mode)
+{
+	DELTAREGION *region = delta_region_find(obj);
+	if ( region!=NULL && mode!=SM_EVENT )
+	{
+		region->busy = true;
+	}
+}
+
 /** Initialize the delta mode code
 
 	This call must be completed before the first call to any delta mode code.
@@ -202,6 +326,12 @@ STATUS delta_init(void)
 	rankcount = NULL;
 	free(ranklist);
 	ranklist = NULL;
+
+	/* assign objects to regions for localized deltamode */
+	if ( global_deltamode_region_rate>0 && delta_region_init()==FAILED )
+	{
+		return FAILED;
+	}
 Success:
 	profile.t_init += clock() - t;
 	return SUCCESS;
@@ -292,6 +422,14 @@ DT delta_update(void)
 	/* Initialize the forced "post-update" timestep variable */
 	delta_forced_iteration = global_deltamode_forced_extra_timesteps;
 
+	/* all regions start out active */
+	for ( n=0 ; n<delta_regioncount ; n++ )
+	{
+		delta_regionlist[n].idle = false;
+		delta_regionlist[n].idle_steps = 0;
+	}
+	delta_regionbusy = false;
+
 	/* process updates until mode is switched or 1 hour elapses */
 	for ( global_deltaclock=0; global_deltaclock<global_deltamode_maximumtime; global_deltaclock+=timestep )
 	{
@@ -316,25 +454,66 @@ DT delta_update(void)
 		/* main object update loop */
 		realtime_run_schedule();
 
+		/* pace sub-second timesteps in realtime mode */
+		if ( global_run_realtime > 0 && global_deltaclock > 0 )
+		{
+			realtime_pacer_wait_delta(global_clock,global_deltaclock);
+		}
+
+		/* idle regions are only updated every global_deltamode_region_rate timesteps
+		   while the disturbance that keeps deltamode running is in another region */
+		for ( n=0 ; n<delta_regioncount ; n++ )
+		{
+			DELTAREGION *region = &delta_regionlist[n];
+			region->idle_steps++;
+			region->due = ( ! region->idle || ! delta_regionbusy || region->name[0]=='\0'
+				|| region->idle_steps>=(unsigned int)global_deltamode_region_rate );
+			region->dt = region->idle_steps*timestep;
+		}
+
 		/* Begin deltamode iteration loop */
 		while (delta_iteration_remaining>0) /* Iterate on this delta timestep */
 		{
 			/* Assume we are ready to go on, initially */
 			interupdate_mode = SM_EVENT;
 
+			/* Only the last iteration of the timestep determines whether a region stays active */
+			for ( n=0 ; n<delta_regioncount ; n++ )
+			{
+				delta_regionlist[n].busy = false;
+			}
+
 			/* Loop through objects with their individual updates */
 			for ( n=0 ; n<delta_objectcount ; n++ )
 			{
 				d_obj = delta_objectlist[n];	/* Shouldn't need NULL checks, since they were done above */
 				d_oclass = d_obj->oclass;
 
+				/* Hold the state of objects in idle regions */
+				if ( delta_objectregion!=NULL && ! delta_regionlist[delta_objectregion[n]].due )
+				{
+					if ( delta_iteration_count==0 )
+					{
+						profile.t_skipped++;
+					}
+					continue;
+				}
+
 				/* See if the object is in service or not */
 				if ((d_obj->in_svc_double <= global_delta_curr_clock) && (d_obj->out_svc_double >= global_delta_curr_clock))
 				{
 					if ( d_oclass->update )	/* Make sure it exists - init should handle this */
 					{
 						/* Call the object-level interupdate */
-						interupdate_mode_result = (SIMULATIONMODE)d_oclass->update(d_obj,global_clock,global_deltaclock,timestep,delta_iteration_count);
+						/* Objects in a region that was held catch up over the time elapsed since their last update */
+						interupdate_mode_result = (SIMULATIONMODE)d_oclass->update(d_obj,global_clock,global_deltaclock,
+							delta_objectregion!=NULL ? delta_regionlist[delta_objectregion[n]].dt : timestep,delta_iteration_count);
+
+						/* Any request to stay in deltamode or iterate keeps the region active */
+						if ( delta_objectregion!=NULL && interupdate_mode_result!=SM_EVENT )
+						{
+							delta_regionlist[delta_objectregion[n]].busy = true;
+						}
 
 						/* Check the status and handle appropriately */
 						switch ( interupdate_mode_result ) {
@@ -420,6 +599,22 @@ DT delta_update(void)
 			return DT_INVALID;
 		}
 
+		/* Regions updated in this timestep become idle unless an object requested deltamode */
+		delta_regionbusy = false;
+		for ( n=0 ; n<delta_regioncount ; n++ )
+		{
+			DELTAREGION *region = &delta_regionlist[n];
+			if ( region->due )
+			{
+				region->idle = ! region->busy;
+				region->idle_steps = 0;
+			}
+			if ( region->busy )
+			{
+				delta_regionbusy = true;
+			}
+		}
+
 		// We have finished the current timestep. Call delta_clockUpdate.
 		clockupdate_result = delta_clockupdate(timestep, interupdate_mode);
 
@@ -27,6 +27,7 @@
 	t_count - count of updates
 	t_max - maximum delta time (ns)
 	t_min - minimum delta time (ns)
+	t_skipped - count of object updates skipped in quiescent regions
 	module_list - list of active module in deltamode
 
 	This structure stores all the deltamode profile data
@@ -42,6 +43,7 @@ typedef struct s_deltaprofile {
 	unsigned int64 t_count; 
 	unsigned int64 t_max;	
 	unsigned int64 t_min;	
+	unsigned int64 t_skipped;
 	char module_list[1024]; 
 } DELTAPROFILE;
 
@@ -138,6 +140,38 @@ DEPRECATED DELTAPROFILE *delta_getprofile(void);
  */
 DEPRECATED void delta_modecheck(const char *);
 
+/*	Function: delta_region_held
+
+	This function determines whether a deltamode object is held in the
+	current timestep because its region is quiescent.  Modules that update
+	their own deltamode objects should skip held objects.
+
+	Return:
+	true - the object's state is held in this timestep
+	false - the object must be updated
+ */
+bool delta_region_held(struct s_object_list *obj);
+
+/*	Function: delta_region_timestep
+
+	This function gets the timestep to use when updating a deltamode object.
+	Objects in a quiescent region are updated over the time elapsed since
+	their region was last updated.
+
+	Return:
+	the time elapsed since the object's last update, or timestep if the
+	object is not in a region
+ */
+DT delta_region_timestep(struct s_object_list *obj, DT timestep);
+
+/*	Function: delta_region_report
+
+	This function reports the result of a module-level deltamode object
+	update so that the object's region stays active when the object
+	requests deltamode or an iteration.
+ */
+void delta_region_report(struct s_object_list *obj, SIMULATIONMODE mode);
+
 #ifdef __cplusplus
 }
 #endif
@@ -87,6 +87,8 @@
 
 #include "gldcore.h"
 #include <sys/resource.h>
+#include <algorithm>
+#include <vector>
 
 SET_MYCONTEXT(DMC_EXEC)
 
@@ -396,6 +398,9 @@ GldExec::GldExec(GldMain *main)
 	object_heartbeats = NULL;
 	n_object_heartbeats = 0;
 	max_object_heartbeats = 0;
+	syncbatch_obj = NULL;
+	syncbatch_t2 = NULL;
+	syncbatch_size = 0;
 	memset(commit_list,0,sizeof(commit_list));
 	create_scripts = NULL;
 	init_scripts = NULL;
@@ -431,6 +436,8 @@ GldExec::GldExec(GldMain *main)
 GldExec::~GldExec(void)
 {
 	if ( object_heartbeats ) free(object_heartbeats);
+	if ( syncbatch_obj ) free(syncbatch_obj);
+	if ( syncbatch_t2 ) free(syncbatch_t2);
 	free_simplelinklist(commit_list[0]);
 	free_simplelinklist(commit_list[1]);
 	free_simplelist(create_scripts);
@@ -619,6 +626,36 @@ void GldExec::initranks(void)
 	setranks(passlist);
 }
 
+/* orders objects without a class batch sync first, then objects with one grouped by class */
+static bool syncbatch_order(void *a, void *b)
+{
+	CLASS *ca = ((OBJECT*)a)->oclass, *cb = ((OBJECT*)b)->oclass;
+	int ka = ca->syncbatch ? ca->id+1 : 0;
+	int kb = cb->syncbatch ? cb->id+1 : 0;
+	return ka < kb;
+}
+
+/* gather the objects of classes that have a batch sync function into contiguous runs */
+static void group_syncbatch(INDEX *index)
+{
+	int i;
+	for ( i = index->first_used ; i <= index->last_used ; i++ )
+	{
+		GLLIST *list = index->ordinal[i];
+		LISTITEM *item;
+		size_t n = 0;
+		if ( list == NULL || list->size < 2 )
+			continue;
+		std::vector<void*> data;
+		data.reserve(list->size);
+		for ( item = list->first ; item != NULL ; item = item->next )
+			data.push_back(item->data);
+		std::stable_sort(data.begin(),data.end(),syncbatch_order);
+		for ( item = list->first ; item != NULL ; item = item->next )
+			item->data = data[n++];
+	}
+}
+
 STATUS GldExec::setup_ranks(void)
 {
 	OBJECT *obj;
@@ -674,6 +711,11 @@ STATUS GldExec::setup_ranks(void)
 
 			/* shuffle the objects in the index */
 			index_shuffle(ranks[i]);
+
+		if ( global_sync_batchsize > 0 )
+
+			/* keep objects that can be batch synced together */
+			group_syncbatch(ranks[i]);
 	}
 
 	return SUCCESS;
@@ -787,8 +829,6 @@ void GldExec::do_checkpoint(void)
 // implement new ss_do_object_sync for pthreads
 void GldExec::ss_do_object_sync(int thread, void *item)
 {
-	struct thread_data *thread_data = get_thread_data();
-	struct sync_data *data = &thread_data->data[thread];
 	OBJECT *obj = (OBJECT *) item;
 	TIMESTAMP this_t;
 	char b[64];
@@ -861,6 +901,15 @@ void GldExec::ss_do_object_sync(int thread, void *item)
 	else 
 		this_t = TS_NEVER; /* already out of service */
 
+	ss_do_object_sync_result(thread,obj,this_t);
+}
+
+// update the thread sync data with the next time of an object
+void GldExec::ss_do_object_sync_result(int thread, OBJECT *obj, TIMESTAMP this_t)
+{
+	struct thread_data *thread_data = get_thread_data();
+	struct sync_data *data = &thread_data->data[thread];
+
 	/* check for "soft" event (events that are ignored when stopping) */
 	if (this_t < -1)
 		this_t = -this_t;
@@ -908,6 +957,60 @@ void GldExec::ss_do_object_sync(int thread, void *item)
 	}
 }
 
+// synchronize a run of objects of the same class using the class batch sync function
+unsigned int GldExec::ss_do_object_sync_batch(int thread, LISTITEM **item, unsigned int limit)
+{
+	LISTITEM *ptr = *item, *last = NULL;
+	OBJECT *obj = (OBJECT*)ptr->data;
+	CLASS *oclass = obj->oclass;
+	PASSCONFIG passconfig = passtype[pass];
+	OBJECT **objs;
+	TIMESTAMP *t2;
+	unsigned int n = 0, m, k;
+	char b[64];
+
+	if ( oclass->syncbatch == NULL || syncbatch_obj == NULL || global_sync_batchsize <= 0 )
+		return 0;
+#ifdef _DEBUG
+	if ( global_sync_dumpfile[0] != '\0' )
+		return 0;
+#endif
+
+	/* collect the run of objects that can be batched */
+	objs = syncbatch_obj + thread*syncbatch_size;
+	t2 = syncbatch_t2 + thread*syncbatch_size;
+	for ( ; ptr != NULL && n < limit && n < syncbatch_size && n < (unsigned int)global_sync_batchsize ; ptr = ptr->next )
+	{
+		obj = (OBJECT*)ptr->data;
+		if ( obj->oclass != oclass || ! object_sync_batchable(obj,global_clock,passconfig) )
+			break;
+		objs[n++] = obj;
+		last = ptr;
+	}
+	if ( n == 0 )
+		return 0;
+
+	/* sync the run and process the results as ss_do_object_sync() does */
+	m = object_sync_batch(objs,n,global_clock,passconfig,t2);
+	for ( k = 0 ; k < m ; k++ )
+	{
+		if ( t2[k] == global_clock )
+		{
+			IN_MYCONTEXT output_verbose("%s: object %s calling for re-sync", simtime(), object_name(objs[k], b, 63));
+		}
+		ss_do_object_sync_result(thread,objs[k],t2[k]);
+	}
+
+	/* a failed object ends the run early */
+	if ( m < n )
+	{
+		for ( last = *item, k = 1 ; k < m ; k++ )
+			last = last->next;
+	}
+	*item = last;
+	return m;
+}
+
 // implement new ss_do_object_sync_list for pthreads
 void *GldExec::ss_do_object_sync_list(void *threadarg)
 {
@@ -1734,9 +1837,17 @@ void *GldExec::obj_syncproc(OBJSYNCDATA *data)
 		pthread_mutex_unlock(&startlock[i]);
 
 		// process the list for this thread
-		for ( s = data->ls, n = 0 ; s != NULL || n < data->nObj ; s = s->next, n++ ) 
+		for ( s = data->ls, n = 0 ; s != NULL && n < data->nObj ; s = s->next, n++ ) 
 		{
-			my_instance->get_exec()->ss_do_object_sync(data->n, s->data);
+			unsigned int m = my_instance->get_exec()->ss_do_object_sync_batch(data->n, &s, data->nObj-n);
+			if ( m == 0 )
+			{
+				my_instance->get_exec()->ss_do_object_sync(data->n, s->data);
+			}
+			else
+			{
+				n += m-1;
+			}
 		}
 
 		// signal completed condition
@@ -1857,6 +1968,11 @@ void GldExec::mls_suspend(void)
 	}
 	IN_MYCONTEXT output_debug("sched update_");
 	sched_update(global_clock,global_mainloopstate=MLS_PAUSED);
+	rv = pthread_cond_broadcast(&mls_svr_signal);
+	if ( rv != 0 && rv != EINVAL )
+	{
+		output_error("gldcore/exec.c/GldExec::mls_suspend(): pthread_cond_broadcast() error %d (%s)", rv, strerror(rv));
+	}
 	IN_MYCONTEXT output_debug("wait loop_");
 	while ( global_clock==TS_ZERO || (global_clock>=global_mainlooppauseat && global_mainlooppauseat<TS_NEVER) ) {
 		if (loopctr > 0)
@@ -1956,6 +2072,52 @@ void GldExec::mls_statewait(unsigned states)
 	}
 }
 
+/** Resume the main loop until it pauses again at or after \p ts
+
+	The pause time is posted and the caller waits on the main loop
+	signal in a single lock, so a controller can advance the
+	simulation one step at a time without polling.
+ **/
+void GldExec::mls_step(TIMESTAMP ts)
+{
+	if ( mls_destroyed )
+	{
+		IN_MYCONTEXT output_debug("gldcore/exec.c/exec_mls_step(): cannot step mutex after it was destroyed");
+		return;
+	}
+	if ( ! mls_created )
+	{
+		IN_MYCONTEXT output_debug("gldcore/exec.c/exec_mls_step(): cannot step mutex before it was created");
+		return;
+	}
+	int rv = pthread_mutex_lock(&mls_svr_lock);
+	if ( rv != 0 )
+	{
+		output_error("gldcore/exec.c/GldExec::mls_step(): pthread_mutex_lock() error %d (%s)", rv, strerror(rv));
+		return;
+	}
+	global_mainlooppauseat = ts;
+	rv = pthread_cond_broadcast(&mls_svr_signal);
+	if ( rv != 0 )
+	{
+		output_error("gldcore/exec.c/GldExec::mls_step(): pthread_cond_broadcast() error %d (%s)", rv, strerror(rv));
+	}
+	while ( global_mainloopstate != MLS_DONE && ( global_mainloopstate != MLS_PAUSED || global_clock < ts ) )
+	{
+		rv = pthread_cond_wait(&mls_svr_signal, &mls_svr_lock);
+		if ( rv != 0 && rv != EINVAL )
+		{
+			output_error("gldcore/exec.c/GldExec::mls_step(): pthread_cond_wait() error %d (%s)", rv, strerror(rv));
+			break;
+		}
+	}
+	rv = pthread_mutex_unlock(&mls_svr_lock);
+	if ( rv != 0 )
+	{
+		output_error("gldcore/exec.c/GldExec::mls_step(): pthread_mutex_unlock() error %d (%s)", rv, strerror(rv));
+	}
+}
+
 void GldExec::mls_done(void)
 {
 	if ( mls_destroyed )
@@ -2272,6 +2434,10 @@ STATUS GldExec::exec_start(void)
 		 */
 		return FAILED;
 	}
+	if ( global_memory_report )
+	{
+		heap_report("init");
+	}
 
 	/* establish rank index if necessary */
 	if ( ranks == NULL && setup_ranks() == FAILED )
@@ -2343,6 +2509,23 @@ STATUS GldExec::exec_start(void)
 		{ 
 			thread_data->data[j].status = SUCCESS;
 		}
+
+		/* allocate class batch sync buffers */
+		if ( global_sync_batchsize > 0 )
+		{
+			syncbatch_size = global_sync_batchsize;
+			syncbatch_obj = (OBJECT**)malloc(sizeof(OBJECT*)*global_threadcount*syncbatch_size);
+			syncbatch_t2 = (TIMESTAMP*)malloc(sizeof(TIMESTAMP)*global_threadcount*syncbatch_size);
+			if ( syncbatch_obj == NULL || syncbatch_t2 == NULL )
+			{
+				output_error("batch sync memory allocation failed");
+				/* TROUBLESHOOT
+					The buffers used to synchronize objects in batches could not be allocated.
+					Reduce the value of the sync_batchsize global or set it to 0 to disable batch sync.
+				 */
+				return FAILED;
+			}
+		}
 	}
 	else
 	{
@@ -2369,16 +2552,14 @@ STATUS GldExec::exec_start(void)
 		{
 			global_stoptime = TS_NEVER;
 		}
+		realtime_pacer_start(global_clock,global_run_realtime==1);
 	}
 
 	/*** GET FIRST SIGNAL FROM MASTER HERE ****/
 	if ( global_multirun_mode == MRM_SLAVE )
 	{
-		pthread_cond_broadcast(&mls_inst_signal); // tell slaveproc() it's time to get rolling
 		IN_MYCONTEXT output_debug("GldExec::start(), slave waiting for first time signal");
-		pthread_mutex_lock(&mls_inst_lock);
-		pthread_cond_wait(&mls_inst_signal, &mls_inst_lock);
-		pthread_mutex_unlock(&mls_inst_lock);
+		instance_slave_resume_controller(); // tell slaveproc() it's time to get rolling
 		// will have copied data down and updated step_to with slave_cache
 		//global_clock = exec_sync_get(NULL); // copy time signal to gc
 		IN_MYCONTEXT output_debug("GldExec::start(), slave received first time signal of %lli", global_clock);
@@ -2494,43 +2675,23 @@ STATUS GldExec::exec_start(void)
 			if ( global_run_realtime == 0 && global_clock >= global_enter_realtime )
 			{
 				global_run_realtime = 1;
-			}
 
-			if ( global_run_realtime > 0 && iteration_counter > 0 )
-			{
-				double metric=0;
-				struct timeval tv;
-				gettimeofday(&tv, NULL);
-				unsigned int udiff = 1000000 - tv.tv_usec;
-				if ( global_run_realtime == 1 ) // lock onto system clock
+				/* lock onto the system clock, skipping ahead if the simulation is behind it */
+				realtime_pacer_start(global_clock,true);
+				if ( global_clock < realtime_now() )
 				{
-					int diff = global_clock - tv.tv_sec;
-					if ( diff < 0 )
-					{
-						IN_MYCONTEXT output_verbose("skipping %d seconds to catch up", -diff);
-						global_realtime_metric = 0.0;
-					}
-					else if ( diff > 0 )
-					{
-						global_realtime_metric = 1.0;
-						IN_MYCONTEXT output_verbose("sleeping %d seconds to catch up", diff);
-						sleep(diff);
-						gettimeofday(&tv, NULL);
-						udiff = 1000000 - tv.tv_usec;
-					}
-					global_clock = tv.tv_sec + 1;
-				}
-				else
-				{
-					global_clock++;
-					metric = (udiff)/1000000.0;
-					global_realtime_metric = global_realtime_metric*realtime_metric_decay + metric*(1-realtime_metric_decay);
-				}
-				if ( udiff >= 0 )
-				{
-					IN_MYCONTEXT output_verbose("waiting %d usec to synchronize", udiff);
-					usleep(udiff);
+					IN_MYCONTEXT output_verbose("skipping %lld seconds to catch up", (long long)(realtime_now()-global_clock));
+					global_clock = realtime_now();
 				}
+			}
+
+			/* realtime control of global clock, unless an object must be updated again at the current time,
+			   e.g., to enter deltamode before the next second */
+			if ( global_run_realtime > 0 && iteration_counter > 0 && sync_get(NULL) > global_clock )
+			{
+				double idle = 0;
+				global_clock = realtime_pacer_wait(global_clock+1,&idle);
+				global_realtime_metric = global_realtime_metric*realtime_metric_decay + idle*(1-realtime_metric_decay);
 				wlock_sync();
 				sync_reset(NULL);
 				sync_set(NULL,global_clock,false);
@@ -2545,7 +2706,7 @@ STATUS GldExec::exec_start(void)
 			}
 
 			/* operate delta mode if necessary (but only when event mode is active, e.g., not right after init) */
-			/* note that delta mode cannot be supported for realtime simulation */
+			/* in realtime mode, delta_update() paces each deltamode timestep */
 			global_deltaclock = 0;
 
 			/* determine whether any modules seek delta mode */
@@ -2711,9 +2872,12 @@ STATUS GldExec::exec_start(void)
 						{
 							for ( ptr = ranks[pass]->ordinal[i]->first ; ptr != NULL ; ptr=ptr->next ) 
 							{
+								if ( ss_do_object_sync_batch(0, &ptr, syncbatch_size) == 0 )
+								{
+									ss_do_object_sync(0, ptr->data);
+								}
 								OBJECT *obj = (OBJECT*)(ptr->data);
-								ss_do_object_sync(0, ptr->data);					
-								
+
 								if (obj->valid_to == TS_INVALID)
 								{
 									//Get us out of the loop so others don't exec on bad status
@@ -2862,11 +3026,7 @@ STATUS GldExec::exec_start(void)
 				IN_MYCONTEXT output_debug("step_to = %lli", sync_get(NULL));
 				IN_MYCONTEXT output_debug("GldExec::start(), slave waiting for looped time signal");
 
-				pthread_cond_broadcast(&mls_inst_signal);
-
-				pthread_mutex_lock(&mls_inst_lock);
-				pthread_cond_wait(&mls_inst_signal, &mls_inst_lock);
-				pthread_mutex_unlock(&mls_inst_lock);
+				instance_slave_resume_controller();
 
 				IN_MYCONTEXT output_debug("GldExec::start(), slave received looped time signal (%lli)", sync_get(NULL));
 			}
@@ -2930,6 +3090,12 @@ STATUS GldExec::exec_start(void)
 				throw("commit script(s) failed");
 			}
 
+			/* send committed values to subscribers, if any */
+			if ( sync_get(NULL) != global_clock )
+			{
+				server_publish(global_clock);
+			}
+
 			/* run scheduled dump, if any */
 			run_dump();
 			
@@ -2994,7 +3160,7 @@ STATUS GldExec::exec_start(void)
 	IN_MYCONTEXT output_debug("*** main loop ended at %lli; stoptime=%lli, n_events=%i, exitcode=%i ***", sync_get(NULL), global_stoptime, sync_getevents(NULL), getexitcode());
 	if(global_multirun_mode == MRM_MASTER)
 	{
-		instance_master_done(TS_NEVER); // tell everyone to pack up and go home
+		instance_dispose(); // tell everyone to pack up and go home
 	}
 
 	//sjin: GetMachineCycleCount
@@ -3070,6 +3236,8 @@ STATUS GldExec::exec_start(void)
 		output_profile("  Model time            %8.1f seconds/thread (%.1f%%)", sync_time,sync_time/elapsed_wall*100);
 		if ( dp->t_count>0 )
 			output_profile("  Deltamode time        %8.1f seconds/thread (%.1f%%)", delta_runtime,delta_runtime/elapsed_wall*100);	
+		if ( dp->t_skipped>0 )
+			output_profile("  Deltamode held        %8llu object updates", (unsigned long long)dp->t_skipped);
 		output_profile("Simulation time         %8.0f days", elapsed_sim/24);
 		if (sim_speed>10.0)
 			output_profile("Simulation speed         %7.0lfk object.hours/second", sim_speed);
@@ -3105,6 +3273,7 @@ STATUS GldExec::exec_start(void)
 			output_profile("Total deltamode runtime %8.1lf s (100%%)", delta_runtime);
 			output_profile("Simulation rate         %8.1lf x realtime", delta_simtime/delta_runtime/1000);
 		}
+		realtime_pacer_report();
 		output_profile("\n");
 		object_synctime_profile_dump(NULL);
 	}
@@ -3179,6 +3348,48 @@ STATUS GldExec::test(struct sync_data *data, /**< the synchronization state data
 	return data->status;
 }
 
+/** Check a model path received by slave_node_proc()
+
+	Only letters, digits and the characters '_', '-', '.', '+' and the path
+	separators are accepted, and no path may start with '-'.
+ **/
+static bool slave_node_safe_path(const char *path)
+{
+	if ( path[0] == '-' )
+	{
+		return false;
+	}
+	for ( const char *c = path ; *c != '\0' ; c++ )
+	{
+		if ( ! isalnum(*c) && strchr("_-.+/",*c) == NULL
+#ifdef WIN32
+			&& strchr("\\:",*c) == NULL
+#endif
+			)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/** Check a command line option received by slave_node_proc()
+
+	Only the options sent by instance_cnx_socket() are accepted.
+ **/
+static bool slave_node_safe_option(const char *option)
+{
+	const char *allowed[] = {"--profile", "--relax", "--debug", "--verbose", "--warn", "--quiet", "--avlbalance"};
+	for ( size_t n = 0 ; n < sizeof(allowed)/sizeof(allowed[0]) ; n++ )
+	{
+		if ( strcmp(option,allowed[n]) == 0 )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 void *GldExec::slave_node_proc(void *args)
 {
 	SOCKET **args_in = (SOCKET **)args;
@@ -3187,10 +3398,12 @@ void *GldExec::slave_node_proc(void *args)
 	bool *done_ptr = (bool *)(args_in[0]);
 	struct sockaddr_in *addrin = (struct sockaddr_in *)(args_in[3]);
 
+	// the connection socket and argument block are allocated per connection by slave_node()
+	free(args_in[2]);
+	free(args_in);
+
 	char buffer[1024], response[1024], addrstr[17], *paddrstr, *token_to;
-#ifdef WIN32
 	char *params;
-#endif
 	char dirname[256], filename[256];
 	unsigned int64 mtr_port, id;
 	const char *token[5]={
@@ -3341,7 +3554,8 @@ void *GldExec::slave_node_proc(void *args)
 		char temp[256];
 		sprintf(temp, "%%d offset and %%d len for \'%%%lus\'", tok_len);
 		IN_MYCONTEXT output_debug(temp, offset, tok_len, buffer+offset);
-		memcpy(dirname, buffer+offset, (tok_len > sizeof(dirname) ? sizeof(dirname) : tok_len));
+		memcpy(dirname, buffer+offset, (tok_len >= sizeof(dirname) ? sizeof(dirname)-1 : tok_len));
+		dirname[tok_len >= sizeof(dirname) ? sizeof(dirname)-1 : tok_len] = 0;
 	} else {
 		dirname[0] = 0;
 	}
@@ -3361,7 +3575,8 @@ void *GldExec::slave_node_proc(void *args)
 	if (tok_len > 0)
 	{
 		char temp[256];
-		memcpy(filename, buffer+offset, (tok_len > sizeof(filename) ? sizeof(filename) : tok_len));
+		if ( tok_len >= sizeof(filename) ) tok_len = sizeof(filename)-1;
+		memcpy(filename, buffer+offset, tok_len);
 		filename[tok_len]=0;
 		sprintf(temp, "%%d offset and %%d len for \'%%%lus\'", tok_len);
 		IN_MYCONTEXT output_debug(temp, offset, tok_len, buffer+offset);
@@ -3416,10 +3631,8 @@ void *GldExec::slave_node_proc(void *args)
 		IN_MYCONTEXT output_debug("id = %llu", id);
 	}
 
-#ifdef WIN32
 	// then zero or more CL args
 	params = 1 + token_to;
-#endif
 
 	// if unable to locate model file,
 	//	* request model
@@ -3443,18 +3656,98 @@ void *GldExec::slave_node_proc(void *args)
 		IN_MYCONTEXT output_debug("snp(): connect to %s:%d", addrstr, mtr_port);
 	}
 
-#ifdef WIN32
-	// write, system() --slave command
-	sprintf(filepath, "%s%s%s", dirname, (dirname[0] ? "\\" : ""), filename);
+	// the dir, file and options come from the peer, so only plain paths and the options
+	// that instance_cnx_socket() sends are accepted, and the slave is started without a shell
+	if ( ! slave_node_safe_path(dirname) || filename[0] == 0 || ! slave_node_safe_path(filename) )
+	{
+		output_error("slave_node_proc(): command instruction model path '%s' '%s' is not allowed", dirname, filename);
+		closesocket(masterfd);
+		free(addrin);
+		return 0;
+	}
+	const int maxopts = 8;
+	char options[1024], *option[maxopts], *last = NULL;
+	int n_options = 0;
+	strncpy(options, params, sizeof(options)-1);
+	options[sizeof(options)-1] = 0;
+	for ( char *next = strtok_r(options," \t\r\n",&last) ; next != NULL ; next = strtok_r(NULL," \t\r\n",&last) )
+	{
+		if ( n_options == maxopts || ! slave_node_safe_option(next) )
+		{
+			output_error("slave_node_proc(): command instruction option '%s' is not allowed", next);
+			closesocket(masterfd);
+			free(addrin);
+			return 0;
+		}
+		option[n_options++] = next;
+	}
+
+	char filepath[1024], ippath[64], idstr[32];
+	snprintf(filepath, sizeof(filepath)-1, "%s%s%s", dirname, (dirname[0] ? "/" : ""), filename);
 	IN_MYCONTEXT output_debug("filepath = %s", filepath);
-	sprintf(ippath, "--slave %s:%d", addrstr, mtr_port);
+	snprintf(ippath, sizeof(ippath)-1, "%s:%d", addrstr, (int)mtr_port);
 	IN_MYCONTEXT output_debug("ippath = %s", ippath);
-	sprintf(cmd, "%s%sgridlabd.exe %s --id %" FMT_INT64 "d %s %s",
-		(global_execdir[0] ? global_execdir : ""), (global_execdir[0] ? "\\" : ""), params, id, ippath, filepath);//addrstr, mtr_port, filepath);//,
+	snprintf(idstr, sizeof(idstr)-1, "%" FMT_INT64 "d", id);
+#ifdef WIN32
+	char cmd[2048];
+	int len = snprintf(cmd, sizeof(cmd)-1, "%s%sgridlabd.exe %s --id %s --slave %s %s",
+		(global_execdir[0] ? global_execdir : ""), (global_execdir[0] ? "\\" : ""), params, idstr, ippath, filepath);
+	if ( len < 0 || len >= (int)sizeof(cmd)-1 )
+	{
+		output_error("slave_node_proc(): slave command is too long");
+		closesocket(masterfd);
+		free(addrin);
+		return 0;
+	}
 	IN_MYCONTEXT output_debug("system(\"%s\")", cmd);
 
+	// the slave runs in the foreground of this connection thread so the node can serve several masters or slaves at once
 	rv = my_instance->subcommand("%s",cmd);
+#else
+	char program[1024];
+	if ( snprintf(program, sizeof(program)-1, "%s%sgridlabd", (global_execdir[0] ? global_execdir : ""), (global_execdir[0] ? "/" : "")) >= (int)sizeof(program)-1 )
+	{
+		output_error("slave_node_proc(): slave program path is too long");
+		closesocket(masterfd);
+		free(addrin);
+		return 0;
+	}
+	char *argv[maxopts+8];
+	int argc = 0;
+	argv[argc++] = program;
+	for ( int n = 0 ; n < n_options ; n++ )
+	{
+		argv[argc++] = option[n];
+	}
+	argv[argc++] = (char*)"--id";
+	argv[argc++] = idstr;
+	argv[argc++] = (char*)"--slave";
+	argv[argc++] = ippath;
+	argv[argc++] = filepath;
+	argv[argc] = NULL;
+	IN_MYCONTEXT output_debug("execvp(\"%s\") with %d options", program, n_options);
+
+	// the slave runs in the foreground of this connection thread so the node can serve several masters or slaves at once
+	pid_t pid = fork();
+	if ( pid == 0 )
+	{
+		execvp(program,argv);
+		_exit(XC_PRCERR);
+	}
+	else if ( pid < 0 )
+	{
+		output_error("slave_node_proc(): unable to start slave instance (%s)", strerror(errno));
+		rv = -1;
+	}
+	else
+	{
+		int status = 0;
+		pid_t done;
+		while ( (done=waitpid(pid,&status,0)) < 0 && errno == EINTR ) {}
+		rv = ( done == pid && WIFEXITED(status) ) ? WEXITSTATUS(status) : -1;
+	}
 #endif
+	IN_MYCONTEXT output_verbose("slave instance '%s' exited with code %d", filepath, rv);
 
 	// cleanup
 	closesocket(masterfd);
@@ -3472,8 +3765,7 @@ void GldExec::slave_node()
 {
 	static bool node_done = FALSE;
 	static SOCKET sockfd = -1;
-	static SOCKET cnx;
-	SOCKET *args[4];
+	SOCKET **args;
 	struct sockaddr_in server_addr;
 	struct sockaddr_in *inaddr = NULL;
 	int inaddrsz;
@@ -3531,9 +3823,6 @@ void GldExec::slave_node()
 	FD_ZERO(&master_fdset);
 	FD_SET(sockfd, &master_fdset);
 	
-	args[0] = (SOCKET *)&node_done;
-	args[1] = (SOCKET *)&sockfd;
-
 	IN_MYCONTEXT output_debug("esn(): starting loop");
 	while (!node_done)
 	{
@@ -3554,20 +3843,26 @@ void GldExec::slave_node()
 		} 
 		else if (rct > 0)
 		{
-			if ( ! inaddr ) inaddr = (struct sockaddr_in*)malloc(inaddrsz);
+			// each connection thread owns its own arguments, address, and socket
+			inaddr = (struct sockaddr_in*)malloc(inaddrsz);
+			args = (SOCKET**)malloc(4*sizeof(SOCKET*));
+			args[0] = (SOCKET *)&node_done;
+			args[1] = (SOCKET *)&sockfd;
+			args[2] = (SOCKET *)malloc(sizeof(SOCKET));
 			args[3] = (SOCKET *)inaddr;
 			//IN_MYCONTEXT output_debug("esn(): got client");
 			memset(inaddr, 0, inaddrsz);
-			cnx = accept(sockfd, (struct sockaddr *)inaddr, (socklen_t*)&inaddrsz);
-			args[2] = (SOCKET *)&cnx;
+			*args[2] = accept(sockfd, (struct sockaddr *)inaddr, (socklen_t*)&inaddrsz);
 			IN_MYCONTEXT output_debug("esn(): accepted client");
-			if (-1 == (int64)(args[2]))
+			if (-1 == (int64)(*args[2]))
 			{
 				output_error("unable to accept connection");
 				perror("accept()");
 				node_done = TRUE;
 				closesocket(sockfd);
 				free(inaddr);
+				free(args[2]);
+				free(args);
 				return;
 			}
 
@@ -3584,16 +3879,17 @@ void GldExec::slave_node()
 				closesocket(sockfd);
 				closesocket(*(SOCKET*)(args[2]));
 				free(inaddr);
+				free(args[2]);
+				free(args);
 				return;
 			}
+			inaddr = NULL;
 			//IN_MYCONTEXT output_debug("esn(): thread created");
 			if ( pthread_detach(slave_thread) )
 			{
 				output_error("slavenode unable to detach connection thread");
 				node_done = TRUE;
 				closesocket(sockfd);
-				closesocket(*(SOCKET*)(args[2]));
-				free(inaddr);
 				return;
 			}
 			//IN_MYCONTEXT output_debug("esn(): thread detached");
@@ -238,6 +238,21 @@ private:
 	 */
 	OBJECT **object_heartbeats;
 
+	/* Field: syncbatch_obj
+		Per-thread object buffers for class batch sync calls
+	 */
+	OBJECT **syncbatch_obj;
+
+	/* Field: syncbatch_t2
+		Per-thread next time buffers for class batch sync calls
+	 */
+	TIMESTAMP *syncbatch_t2;
+
+	/* Field: syncbatch_size
+		Number of objects per thread in the batch sync buffers
+	 */
+	unsigned int syncbatch_size;
+
 	/* Field: n_object_heartbeats
 		Number of object heartbeat data items
 	 */
@@ -548,6 +563,23 @@ public:
 	*/
 	void ss_do_object_sync(int thread, void *item);
 
+	/*	Method: ss_do_object_sync_batch
+			Synchronize a run of objects of the same class using the class batch sync function
+
+		At most limit objects are synchronized, so a thread does not run past the
+		end of its slice of the rank list.  On return *item refers to the last
+		object synchronized.
+
+		Returns:
+			Number of objects synchronized, or 0 if *item cannot be batched
+	*/
+	unsigned int ss_do_object_sync_batch(int thread, LISTITEM **item, unsigned int limit);
+
+	/*	Method: ss_do_object_sync_result
+			Update the thread sync data with the next time of an object
+	*/
+	void ss_do_object_sync_result(int thread, OBJECT *obj, TIMESTAMP this_t);
+
 	/*	Method: 
 			
 		Returns:
@@ -744,6 +776,13 @@ public:
 	*/
 	void mls_statewait(unsigned states);
 
+	/*	Method: mls_step
+			Resume the main loop and wait until it pauses at or after \p ts, or is done
+		Returns:
+			Nothing
+	*/
+	void mls_step(TIMESTAMP ts);
+
 	/*	Method: 
 			
 		Returns:
@@ -95,6 +95,7 @@ typedef enum e_status {FAILED=FALSE, SUCCESS=TRUE} STATUS;
 #include "find.h"
 #include "globals.h"
 #include "gui.h"
+#include "heap.h"
 #include "http_client.h"
 #include "index.h"
 #include "instance.h"
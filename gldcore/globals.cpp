@@ -200,6 +200,11 @@ DEPRECATED static KEYWORD jcf_keys[] = {
 	{"RADIANS",		JCF_RADIANS,	NULL}
 };
 
+DEPRECATED static KEYWORD rtp_keys[] = {
+	{"CATCHUP",		RTP_CATCHUP,	rtp_keys+1},
+	{"SKIP",		RTP_SKIP,		NULL},
+};
+
 DEPRECATED static struct s_varmap {
 	const char *name;
 	PROPERTYTYPE type;
@@ -258,6 +263,8 @@ DEPRECATED static struct s_varmap {
 	{"trace", PT_char1024, &global_trace, PA_PUBLIC, "trace function list"},
 	{"gdb_window", PT_bool, &global_gdb_window, PA_PUBLIC, "gdb window enable flag"},
 	{"tmp", PT_char1024, &global_tmp, PA_PUBLIC, "temporary folder name"},
+	{"input_cache", PT_char1024, &global_input_cache, PA_PUBLIC, "folder in which #input conversions are cached (\"none\" disables the cache)"},
+	{"input_prefetch", PT_bool, &global_input_prefetch, PA_PUBLIC, "start the #input conversions of a file in parallel before it is parsed"},
 	{"force_compile", PT_int32, &global_force_compile, PA_PUBLIC, "force recompile enable flag"},
 	{"nolocks", PT_bool, &global_nolocks, PA_PUBLIC, "locking disable flag"},
 	{"skipsafe", PT_bool, &global_skipsafe, PA_PUBLIC, "skip sync safe enable flag"},
@@ -267,9 +274,16 @@ DEPRECATED static struct s_varmap {
 	{"platform",PT_char8, global_platform, PA_REFERENCE, "operating platform"},
 	{"suppress_repeat_messages",PT_bool, &global_suppress_repeat_messages, PA_PUBLIC, "suppress repeated messages enable flag"},
 	{"maximum_synctime",PT_int32, &global_maximum_synctime, PA_PUBLIC, "maximum sync time for deltamode"},
+	{"sync_batchsize",PT_int32, &global_sync_batchsize, PA_PUBLIC, "maximum number of objects per class batch sync call (0 disables batch sync)"},
 	{"run_realtime",PT_bool, &global_run_realtime, PA_PUBLIC, "realtime enable flag"},
 	{"enter_realtime",PT_timestamp, &global_enter_realtime, PA_PUBLIC, "timestamp to transition to realtime mode"},
 	{"realtime_metric",PT_double, &global_realtime_metric, PA_REFERENCE, "realtime performance metric (0=worst, 1=best)"},
+	{"realtime_policy",PT_enumeration, &global_realtime_policy, PA_PUBLIC, "realtime policy for steps that miss their deadline", rtp_keys},
+	{"realtime_busywait",PT_int32, &global_realtime_busywait, PA_PUBLIC, "time before each realtime deadline spent polling instead of sleeping (in microseconds)"},
+	{"realtime_overruns",PT_int32, &global_realtime_overruns, PA_REFERENCE, "number of realtime steps that missed their deadline"},
+	{"property_lookup_check",PT_bool, &global_property_lookup_check, PA_PUBLIC, "report properties looked up by name during sync"},
+	{"memory_report",PT_bool, &global_memory_report, PA_PUBLIC, "output the memory report at init and exit"},
+	{"memory_report_threshold",PT_int64, &global_memory_report_threshold, PA_PUBLIC, "per-instance size above which the memory report flags an account (in bytes)"},
 	{"no_deprecate",PT_bool, &global_suppress_deprecated_messages, PA_PUBLIC, "suppress deprecated usage message enable flag"},
 #ifdef _DEBUG
 	{"sync_dumpfile",PT_char1024, &global_sync_dumpfile, PA_PUBLIC, "sync event dump file name"},
@@ -301,6 +315,8 @@ DEPRECATED static struct s_varmap {
 	{"master_port", PT_int64, &global_master_port, PA_PUBLIC, "master server port number"},
 	{"multirun_mode", PT_enumeration, &global_multirun_mode, PA_PUBLIC, "multirun enable flag", mrm_keys},
 	{"multirun_conn", PT_enumeration, &global_multirun_connection, PA_PUBLIC, "unused", mrc_keys},
+	{"multirun_lookahead", PT_bool, &global_multirun_lookahead, PA_PUBLIC, "only synchronize slaves when their inputs change or their next event is reached"},
+	{"multirun_tolerance", PT_double, &global_multirun_tolerance, PA_PUBLIC, "relative change in linked values below which the master stops iterating with its slaves"},
 	{"signal_timeout", PT_int32, &global_signal_timeout, PA_PUBLIC, "unused"},
 	{"slave_port", PT_int16, &global_slave_port, PA_PUBLIC, "unused"},
 	{"slave_id", PT_int64, &global_slave_id, PA_PUBLIC, "unused"},
@@ -325,6 +341,7 @@ DEPRECATED static struct s_varmap {
 	{"deltamode_iteration_limit", PT_int32, &global_deltamode_iteration_limit, PA_PUBLIC, "iteration limit for each delta timestep (object and interupdate)"},
 	{"deltamode_forced_extra_timesteps",PT_int32, &global_deltamode_forced_extra_timesteps, PA_PUBLIC, "forced extra deltamode timesteps before returning to event-driven mode"},
 	{"deltamode_forced_always",PT_bool, &global_deltamode_forced_always, PA_PUBLIC, "forced deltamode for debugging -- prevents event-driven mode"},
+	{"deltamode_region_rate",PT_int32, &global_deltamode_region_rate, PA_PUBLIC, "deltamode timesteps between updates of objects in quiescent regions (groupid), 0 updates every object every timestep"},
 	{"run_powerworld", PT_bool, &global_run_powerworld, PA_PUBLIC, "boolean that that says your system is set up correctly to run with PowerWorld"},
 	{"bigranks", PT_bool, &global_bigranks, PA_PUBLIC, "enable fast/blind set_rank operations"},
 	{"exename", PT_char1024, &global_execname, PA_REFERENCE, "argv[0] value"},
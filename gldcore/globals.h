@@ -339,6 +339,12 @@ GLOBAL char global_tmp[1024] /**< location for temp files */
 							INIT("/tmp");
 #endif
 
+/* Variable: global_input_cache */
+GLOBAL char1024 global_input_cache INIT(""); /**< folder in which #input conversions are cached ("" uses the input_cache folder in tmp, "none" disables the cache) */
+
+/* Variable: global_input_prefetch */
+GLOBAL bool global_input_prefetch INIT(true); /**< start the #input conversions of a file in parallel before it is parsed */
+
 /* Variable: global_force_compile */
 GLOBAL int global_force_compile INIT(0); /** flag to force recompile of GLM file even when up to date */
 
@@ -396,6 +402,9 @@ GLOBAL int global_minimum_timestep INIT(1); /**< the minimum timestep allowed */
 /* Variable: global_maximum_synctime */
 GLOBAL int global_maximum_synctime INIT(60); /**< the maximum time allotted to any single sync call */
 
+/* Variable: global_sync_batchsize */
+GLOBAL int global_sync_batchsize INIT(256); /**< the maximum number of objects passed to a class batch sync call (0 disables batch sync) */
+
 /* Variable: global_platform */
 GLOBAL char global_platform[8] /**< the host operating platform */
 #ifdef WIN32
@@ -421,6 +430,30 @@ GLOBAL TIMESTAMP global_enter_realtime INIT(TS_NEVER); /**< The simulation trans
 /* Variable: global_realtime_metric */
 GLOBAL double global_realtime_metric INIT(0); /**< realtime performance metric (0=poor, 1=great) */
 
+/* Enum: REALTIMEPOLICY */
+typedef enum {
+	RTP_CATCHUP=0, /**< late steps are run without waiting until the schedule is recovered */
+	RTP_SKIP=1, /**< late steps are skipped and the clock jumps to the current deadline */
+} REALTIMEPOLICY;
+
+/* Variable: global_realtime_policy */
+GLOBAL enumeration global_realtime_policy INIT(RTP_CATCHUP); /**< realtime policy for steps that miss their deadline */
+
+/* Variable: global_realtime_busywait */
+GLOBAL int32 global_realtime_busywait INIT(0); /**< time before each realtime deadline spent polling the clock instead of sleeping (in microseconds) */
+
+/* Variable: global_realtime_overruns */
+GLOBAL int32 global_realtime_overruns INIT(0); /**< number of realtime steps that missed their deadline */
+
+/* Variable: global_property_lookup_check */
+GLOBAL bool global_property_lookup_check INIT(false); /**< report properties looked up by name during sync */
+
+/* Variable: global_memory_report */
+GLOBAL bool global_memory_report INIT(false); /**< output the memory report at init and exit */
+
+/* Variable: global_memory_report_threshold */
+GLOBAL int64 global_memory_report_threshold INIT(16384); /**< per-instance size above which the memory report flags an account (in bytes) */
+
 #ifdef _DEBUG /** @todo: consider making global_sync_dumpfile always available */
 /* Variable: global_sync_dumpfile */
 GLOBAL char global_sync_dumpfile[1024] INIT(""); /**< enable sync event dump file */
@@ -562,6 +595,9 @@ GLOBAL unsigned int global_deltamode_forced_extra_timesteps INIT(0);	/**< Deltam
 /* Variable:  */
 GLOBAL bool global_deltamode_forced_always INIT(false);	/**< Deltamode flag - prevents exit from deltamode (no SM_EVENT) -- mainly for debugging purposes */
 
+/* Variable:  */
+GLOBAL int32 global_deltamode_region_rate INIT(0);	/**< Deltamode timesteps between updates of objects in quiescent regions (0 updates all objects every timestep) */
+
 /* Variable:  */
 GLOBAL char global_master[1024] INIT(""); /**< master hostname */
 
@@ -591,6 +627,12 @@ typedef enum {
 /* Variable:  */
 GLOBAL MULTIRUNCONNECTION global_multirun_connection INIT(MRC_NONE);	/**< multirun mode connection */
 
+/* Variable:  */
+GLOBAL bool global_multirun_lookahead INIT(false);	/**< only synchronize slaves when their inputs change or their next event is reached */
+
+/* Variable:  */
+GLOBAL double global_multirun_tolerance INIT(0.0);	/**< relative change in linked values below which slaves are considered converged (0 exchanges once per iteration) */
+
 /* Variable:  */
 GLOBAL int32 global_signal_timeout INIT(5000); /**< signal timeout in milliseconds (-1 is infinite) */
 
@@ -161,6 +161,7 @@ typedef enum e_status {FAILED=FALSE, SUCCESS=TRUE} STATUS;
 #include "gld_sock.h"
 #include "globals.h"
 #include "gui.h"
+#include "heap.h"
 #include "http_client.h"
 #include "index.h"
 #include "instance.h"
@@ -1233,6 +1234,41 @@ inline DEPRECATED bool *gl_get_bool(OBJECT *obj, /**< object to set dependency *
 /** Link to double precision deltamode clock (offset by global_clock) **/
 #define gl_globaldeltaclock DEPRECATED (*(callback->global_delta_curr_clock))
 
+/** Determine whether a deltamode object is held because its region is quiescent
+	@see delta_region_held()
+ **/
+inline bool gl_delta_region_held(OBJECT *obj) { return callback->deltaregion.is_held(obj); };
+
+/** Get the deltamode timestep of an object, which is longer when its region was held
+	@see delta_region_timestep()
+ **/
+inline DT gl_delta_region_timestep(OBJECT *obj, DT timestep) { return callback->deltaregion.timestep(obj,timestep); };
+
+/** Report the deltamode update result of an object to its region
+	@see delta_region_report()
+ **/
+inline void gl_delta_region_report(OBJECT *obj, SIMULATIONMODE mode) { callback->deltaregion.report(obj,mode); };
+
+/** Find or create the memory account of a module data structure
+	@see heap_account()
+ **/
+inline HEAPACCOUNT *gl_heap_account(const char *module, const char *name, int64 instance=0) { return callback->heap.account(HA_MODULE,module,name,instance); };
+
+/** Record an allocation in a memory account
+	@see heap_add()
+ **/
+inline void gl_heap_add(HEAPACCOUNT *account, int64 size) { callback->heap.add(account,size); };
+
+/** Record the release of an allocation from a memory account
+	@see heap_remove()
+ **/
+inline void gl_heap_remove(HEAPACCOUNT *account, int64 size) { callback->heap.remove(account,size); };
+
+/** Set the number of allocations and bytes held in a memory account
+	@see heap_set()
+ **/
+inline void gl_heap_set(HEAPACCOUNT *account, int64 count, int64 size) { callback->heap.set(account,count,size); };
+
 /** Link to stop time of the simulation **/
 #define gl_globalstoptime DEPRECATED (*(callback->global_stoptime))
 
@@ -1566,6 +1602,10 @@ inline size_t nextpow2(register size_t x)
 ///
 #define SYNC_CATCHALL(C) catch (const char *msg) { gl_error("sync_" #C "(obj=%d;%s): %s", obj->id, obj->name?obj->name:"unnamed", msg); return TS_INVALID; } catch (...) { gl_error("sync_" #C "(obj=%d;%s): unhandled exception", obj->id, obj->name?obj->name:"unnamed"); return TS_INVALID; }
 ///
+/// Catchall for syncbatch (k is the index of the object that failed)
+///
+#define SYNCBATCH_CATCHALL(C) catch (const char *msg) { gl_error("syncbatch_" #C "(obj=%d;%s): %s", obj->id, obj->name?obj->name:"unnamed", msg); return k; } catch (...) { gl_error("syncbatch_" #C "(obj=%d;%s): unhandled exception", obj->id, obj->name?obj->name:"unnamed"); return k; }
+///
 /// Catchall for init
 ///
 #define INIT_CATCHALL(C) catch (const char *msg) { gl_error("init_" #C "(obj=%d;%s): %s", obj->id, obj->name?obj->name:"unnamed", msg); return 0; } catch (...) { gl_error("init_" #C "(obj=%d;%s): unhandled exception", obj->id, obj->name?obj->name:"unnamed"); return 0; }
@@ -1910,6 +1950,73 @@ public: // manipulation
 	}
 };
 
+/*	Class: gld_intern
+
+	Interned string encapsulation
+
+	An interned string holds only a handle to a shared copy of its value,
+	so objects that publish one as a PT_intern property pay the cost of a 
+	pointer instead of a fixed-size character buffer.  Identical values
+	share the same handle and assigning a new value never modifies the
+	shared copy.  Interned values are only released at exit, so use
+	PT_intern only for values drawn from a bounded set, e.g., values given
+	in the model or its input files, and not for values computed at runtime.
+ */
+class gld_intern
+{
+private: // data
+	INTERNSTRING *ref;
+public:
+
+	// Constructor: gld_intern(void)
+	inline gld_intern(void) : ref(NULL) {};
+
+	// Constructor: gld_intern(const char *s)
+	inline gld_intern(const char *s) : ref(callback->intern.get(s)) {};
+
+public:
+
+	// Operator: = (const char *s)
+	inline gld_intern &operator=(const char *s) { ref = callback->intern.get(s); return *this; };
+
+	// Operator: const char*
+	inline operator const char*(void) const { return get_string(); };
+
+public:
+
+	// Method: get_string
+	inline const char *get_string(void) const { return ref ? ref->value : ""; };
+
+	// Method: get_length
+	inline size_t get_length(void) const { return ref ? ref->len : 0; };
+
+	// Method: is_empty
+	inline bool is_empty(void) const { return ref == NULL; };
+
+	// Method: set_string
+	inline void set_string(const char *s) { ref = callback->intern.get(s); };
+
+	// Method: erase
+	inline void erase(void) { ref = NULL; };
+
+public:
+
+	// Operator: ==
+	inline bool operator==(const gld_intern &s) const { return ref == s.ref; };
+
+	// Operator: !=
+	inline bool operator!=(const gld_intern &s) const { return ref != s.ref; };
+
+	// Operator: ==
+	inline bool operator==(const char *s) const { return strcmp(get_string(),s)==0; };
+
+	// Operator: !=
+	inline bool operator!=(const char *s) const { return strcmp(get_string(),s)!=0; };
+
+	// Method: operator[]
+	inline char operator[](size_t n) const { return n < get_length() ? ref->value[n] : '\0'; };
+};
+
 /*	Class: gld_clock
 
  	Date/time encapsulation
@@ -2667,6 +2774,28 @@ public:
 	inline void set_##X(size_t n, char c) { gld_wlock _lock(my()); X[n]=c; }; \
 	inline void set_##X(size_t n, char c, gld_wlock&) { X[n]=c; };  \
 
+// Define: GL_INTERN
+// Define an interned string property
+//
+// Methods:
+// size_t get_<name>_offset(void) - return the address of the value
+// const char* get_<name>() - get the value
+// gld_property get_<name>_property() - get the property of the value
+// const char* get_<name>(gld_rlock&) - get the value with a read lock
+// const char* get_<name>(gld_wlock&) - get the value with a write lock
+// char get_<name>(size_t n) - get a character
+// void set_<name>(const char *p) - set a value
+// void set_<name>(const char *p, gld_wlock&) - set a value with a write lock 
+#define GL_INTERN(X) protected: gld_intern X; public: \
+	static inline size_t get_##X##_offset(void) { return (char*)&(defaults->X)-(char*)defaults; }; \
+	inline const char* get_##X(void) { return X.get_string(); }; \
+	inline gld_property get_##X##_property(void) { return gld_property(my(),#X); }; \
+	inline const char* get_##X(gld_rlock&) { return X.get_string(); }; \
+	inline const char* get_##X(gld_wlock&) { return X.get_string(); }; \
+	inline char get_##X(size_t n) { return X[n]; }; \
+	inline void set_##X(const char *p) { gld_wlock _lock(my()); X=p; }; \
+	inline void set_##X(const char *p, gld_wlock&) { X=p; }; \
+
 // Define: GL_ARRAY
 // Define an array property
 #define GL_ARRAY(T,X,S) protected: T X[S]; public: \
@@ -3208,7 +3337,7 @@ public:
 	inline bool is_set(void) { return pstruct.prop->ptype==PT_set; };
 
 	// Method: is_character
-	inline bool is_character(void) { switch(pstruct.prop->ptype) { case PT_char8: case PT_char32: case PT_char256: case PT_char1024: return true; default: return false;} };
+	inline bool is_character(void) { switch(pstruct.prop->ptype) { case PT_char8: case PT_char32: case PT_char256: case PT_char1024: case PT_intern: return true; default: return false;} };
 
 	// Method: is_random
 	inline bool is_random(void) { return pstruct.prop->ptype==PT_random; };
@@ -3395,6 +3524,68 @@ private: // exceptions
 	};
 };
 
+/* 	Class: gld_binding
+
+	Pre-bound property accessor
+
+	A binding resolves a property of a class once, usually during init, and
+	checks its type at that time.  It can then be used to access the property
+	of any object of that class without a name lookup, or to gather/scatter 
+	the values of many objects at once.
+ */
+class gld_binding {
+
+private: // data
+	PROPERTYBINDING *binding;
+
+public:
+
+	// Constructor: gld_binding(void)
+	inline gld_binding(void) : binding(NULL) {};
+
+	// Constructor: gld_binding(CLASS *oclass, const char *name, PROPERTYTYPE ptype=PT_void)
+	inline gld_binding(CLASS *oclass, const char *name, PROPERTYTYPE ptype=PT_void) : binding(callback->binding.bind(oclass,name,ptype)) {};
+
+public:
+
+	// Method: bind
+	inline bool bind(CLASS *oclass, const char *name, PROPERTYTYPE ptype=PT_void) { binding = callback->binding.bind(oclass,name,ptype); return binding != NULL; };
+
+	// Method: probe
+	//	Same as bind() but a missing property or type mismatch is not reported
+	inline bool probe(CLASS *oclass, const char *name, PROPERTYTYPE ptype=PT_void) { binding = callback->binding.probe(oclass,name,ptype); return binding != NULL; };
+
+	// Method: is_valid
+	inline bool is_valid(void) const { return binding != NULL; };
+
+	// Method: get_property
+	inline PROPERTY *get_property(void) const { return binding ? binding->prop : NULL; };
+
+	// Method: get_type
+	inline PROPERTYTYPE get_type(void) const { return binding ? binding->prop->ptype : PT_void; };
+
+	// Method: get_addr
+	inline void *get_addr(OBJECT *obj) const { return BINDADDR(obj,binding); };
+
+	// Method: get_double
+	inline double get_double(OBJECT *obj) const { return *(double*)BINDADDR(obj,binding); };
+
+	// Method: get_complex
+	inline complex get_complex(OBJECT *obj) const { return *(complex*)BINDADDR(obj,binding); };
+
+	// Method: get_enumeration
+	inline enumeration get_enumeration(OBJECT *obj) const { return *(enumeration*)BINDADDR(obj,binding); };
+
+	// Method: setp
+	template <class T> inline void setp(OBJECT *obj, const T &value) const { *(T*)BINDADDR(obj,binding) = value; };
+
+	// Method: gather
+	inline size_t gather(OBJECT **objs, size_t count, void *values) const { return callback->binding.gather(binding,objs,count,values); };
+
+	// Method: scatter
+	inline size_t scatter(OBJECT **objs, size_t count, const void *values) const { return callback->binding.scatter(binding,objs,count,values); };
+};
+
 /* 	Class: gld_global
 
 	Global variable container
@@ -3791,6 +3982,17 @@ int dllkill() { return do_kill(NULL); }
  */
 #define EXPORT_SYNC(X) EXPORT_SYNC_C(X,X)
 
+/*	Section: Batch sync functions
+
+	A class may export a batch sync function, syncbatch_<class>(OBJECT **objs, unsigned int n, TIMESTAMP t0, PASSCONFIG pass, TIMESTAMP *t1),
+	in addition to its per-object sync function.  The core calls it with runs of objects of the class that are in the same rank and pass,
+	and falls back to the per-object sync function for objects that need special handling (see <object_sync_batchable>).
+	The function calls the class sync method for each object, stores its next time in t1[], and returns n, or the index of the object
+	that failed using <SYNCBATCH_CATCHALL>.  Unlike the per-object sync, it must lock each object itself with gld_wlock when the class
+	uses PC_AUTOLOCK.  There is no export macro because the function must call the sync method with the arguments the class takes.
+	See syncbatch_ZIPload() in module/residential/zipload.cpp.
+ */
+
 /*	Define: EXPORT_ISA_C(classname,class)
 
 	This macro is used to implement the isa function of a class when the GridLAB-D class name differs from the C++ class name.
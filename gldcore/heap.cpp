@@ -0,0 +1,238 @@
+/* File: heap.cpp
+ * Copyright (C) 2026, Regents of the Leland Stanford Junior University
+ *
+ * Heap accounting keeps a running count of the memory used by each class,
+ * module data structure and core subsystem.  Accounts are created on first
+ * use and are never deleted.  The core accounts for object data, schedules
+ * and transforms; loadshapes and enduses are counted in the data of the
+ * objects that contain them.  Modules account for their own data structures
+ * using callback->heap.
+ */
+
+#include "gldcore.h"
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+SET_MYCONTEXT(DMC_MAIN)
+
+static HEAPACCOUNT *first_account = NULL;
+static LOCKVAR heap_lock = 0;
+static std::map<CLASS*,HEAPACCOUNT*> class_accounts;
+
+static const char *heap_typename(HEAPACCOUNTTYPE type)
+{
+	switch ( type ) {
+	case HA_CORE: return "core";
+	case HA_MODULE: return "module";
+	case HA_CLASS: return "class";
+	default: return "unknown";
+	}
+}
+
+HEAPACCOUNT *heap_account(HEAPACCOUNTTYPE type, const char *owner, const char *name, int64 instance)
+{
+	HEAPACCOUNT *account;
+	wlock(&heap_lock);
+	for ( account = first_account ; account != NULL ; account = account->next )
+	{
+		if ( account->type == type && strcmp(account->owner,owner) == 0 && strcmp(account->name,name) == 0 )
+		{
+			wunlock(&heap_lock);
+			return account;
+		}
+	}
+	account = (HEAPACCOUNT*)malloc(sizeof(HEAPACCOUNT));
+	if ( account == NULL )
+	{
+		wunlock(&heap_lock);
+		throw_exception("heap_account(type=%s, owner='%s', name='%s'): memory allocation failed", heap_typename(type), owner, name);
+	}
+	memset(account,0,sizeof(HEAPACCOUNT));
+	account->type = type;
+	strncpy(account->owner,owner,sizeof(account->owner)-1);
+	strncpy(account->name,name,sizeof(account->name)-1);
+	account->instance = instance;
+	account->next = first_account;
+	first_account = account;
+	wunlock(&heap_lock);
+	return account;
+}
+
+HEAPACCOUNT *heap_class_account(CLASS *oclass)
+{
+	rlock(&heap_lock);
+	std::map<CLASS*,HEAPACCOUNT*>::iterator item = class_accounts.find(oclass);
+	HEAPACCOUNT *account = ( item == class_accounts.end() ? NULL : item->second );
+	runlock(&heap_lock);
+	if ( account == NULL )
+	{
+		account = heap_account(HA_CLASS, oclass->module ? oclass->module->name : "core", oclass->name, sizeof(OBJECT)+oclass->size);
+		wlock(&heap_lock);
+		class_accounts[oclass] = account;
+		wunlock(&heap_lock);
+	}
+	return account;
+}
+
+void heap_add(HEAPACCOUNT *account, int64 size)
+{
+	if ( account == NULL )
+	{
+		return;
+	}
+	wlock(&heap_lock);
+	account->count++;
+	account->bytes += size;
+	if ( account->bytes > account->peak )
+	{
+		account->peak = account->bytes;
+	}
+	wunlock(&heap_lock);
+}
+
+void heap_remove(HEAPACCOUNT *account, int64 size)
+{
+	if ( account == NULL )
+	{
+		return;
+	}
+	wlock(&heap_lock);
+	account->count--;
+	account->bytes -= size;
+	wunlock(&heap_lock);
+}
+
+void heap_set(HEAPACCOUNT *account, int64 count, int64 size)
+{
+	if ( account == NULL )
+	{
+		return;
+	}
+	wlock(&heap_lock);
+	account->count = count;
+	account->bytes = size;
+	if ( account->bytes > account->peak )
+	{
+		account->peak = account->bytes;
+	}
+	wunlock(&heap_lock);
+}
+
+HEAPACCOUNT *heap_getfirst(void)
+{
+	return first_account;
+}
+
+int64 heap_gettotal(void)
+{
+	int64 total = intern_getsize();
+	rlock(&heap_lock);
+	for ( HEAPACCOUNT *account = first_account ; account != NULL ; account = account->next )
+	{
+		total += account->bytes;
+	}
+	runlock(&heap_lock);
+	return total;
+}
+
+static bool heap_larger(HEAPACCOUNT *a, HEAPACCOUNT *b)
+{
+	return a->bytes > b->bytes;
+}
+
+void heap_report(const char *when)
+{
+	// collect accounts in order of decreasing size
+	std::vector<HEAPACCOUNT*> accounts;
+	std::map<std::string,int64> owners;
+	rlock(&heap_lock);
+	for ( HEAPACCOUNT *account = first_account ; account != NULL ; account = account->next )
+	{
+		if ( account->peak > 0 )
+		{
+			accounts.push_back(account);
+			owners[account->owner] += account->bytes;
+		}
+	}
+	runlock(&heap_lock);
+	std::stable_sort(accounts.begin(),accounts.end(),heap_larger);
+	owners["core"] += intern_getsize();
+	int64 total = heap_gettotal();
+
+	output_profile("\nMemory report at %s", when);
+	output_profile("=================%s\n", std::string(strlen(when),'=').c_str());
+	output_profile("Type   Owner        Name                    Count   Size (kB)   Peak (kB) Each (kB)");
+	output_profile("------ ------------ -------------------- -------- ----------- ----------- ---------");
+	for ( std::vector<HEAPACCOUNT*>::iterator item = accounts.begin() ; item != accounts.end() ; item++ )
+	{
+		HEAPACCOUNT *account = *item;
+		char each[32] = "";
+		if ( account->instance > 0 )
+		{
+			snprintf(each,sizeof(each),"%9.1f%s",account->instance/1024.0,
+				global_memory_report_threshold > 0 && account->instance > global_memory_report_threshold ? "*" : "");
+		}
+		output_profile("%-6.6s %-12.12s %-20.20s %8lld %11.1f %11.1f %s",
+			heap_typename(account->type), account->owner, account->name,
+			account->count, account->bytes/1024.0, account->peak/1024.0, each);
+	}
+	if ( intern_getcount() > 0 )
+	{
+		output_profile("%-6.6s %-12.12s %-20.20s %8lld %11.1f %11.1f",
+			"core", "core", "interned strings", (int64)intern_getcount(), intern_getsize()/1024.0, intern_getsize()/1024.0);
+	}
+	output_profile("------ ------------ -------------------- -------- ----------- ----------- ---------");
+	output_profile("%-41.41s %8s %11.1f", "Total", "", total/1024.0);
+
+	output_profile("\nOwner         Size (kB) Share");
+	output_profile("------------ ----------- ------");
+	for ( std::map<std::string,int64>::iterator owner = owners.begin() ; owner != owners.end() ; owner++ )
+	{
+		output_profile("%-12.12s %11.1f %5.1f%%", owner->first.c_str(), owner->second/1024.0, total > 0 ? 100.0*owner->second/total : 0.0);
+	}
+
+	// flag oversized instances
+	bool flagged = false;
+	for ( std::vector<HEAPACCOUNT*>::iterator item = accounts.begin() ; item != accounts.end() ; item++ )
+	{
+		HEAPACCOUNT *account = *item;
+		if ( global_memory_report_threshold > 0 && account->instance > global_memory_report_threshold )
+		{
+			if ( ! flagged )
+			{
+				output_profile("\n* Instances larger than memory_report_threshold (%lld bytes):", global_memory_report_threshold);
+				flagged = true;
+			}
+			output_profile("  %s %s.%s uses %lld bytes per instance, %.1f%% of the total for %lld instances",
+				heap_typename(account->type), account->owner, account->name, account->instance,
+				total > 0 ? 100.0*account->bytes/total : 0.0, account->count);
+		}
+	}
+	output_profile("");
+}
+
+int heap_json(char *buffer, size_t size)
+{
+	size_t len = 0;
+	int n;
+#define PRINT(...) if ( (n=snprintf(buffer+len,size-len,__VA_ARGS__)) < 0 || (len+=n) >= size ) { runlock(&heap_lock); return -1; }
+	rlock(&heap_lock);
+	PRINT("{\"accounts\" : [");
+	for ( HEAPACCOUNT *account = first_account ; account != NULL ; account = account->next )
+	{
+		PRINT("%s\n\t{\"type\" : \"%s\", \"owner\" : \"%s\", \"name\" : \"%s\", \"count\" : %lld, \"bytes\" : %lld, \"peak\" : %lld, \"instance\" : %lld}",
+			account == first_account ? "" : ",",
+			heap_typename(account->type), account->owner, account->name,
+			account->count, account->bytes, account->peak, account->instance);
+	}
+	runlock(&heap_lock);
+	int64 total = heap_gettotal();
+	rlock(&heap_lock);
+	PRINT("\n\t],\n\"interned_strings\" : %lld,\n\"total\" : %lld,\n\"threshold\" : %lld}\n",
+		(int64)intern_getsize(), total, global_memory_report_threshold);
+	runlock(&heap_lock);
+#undef PRINT
+	return (int)len;
+}
@@ -0,0 +1,103 @@
+/* File: heap.h
+ * Copyright (C) 2026, Regents of the Leland Stanford Junior University
+ *
+ * Heap accounting keeps a running count of the memory used by each class,
+ * module data structure and core subsystem so the memory footprint of a
+ * model can be reported (see --memory-report).
+ */
+
+#ifndef _HEAP_H
+#define _HEAP_H
+
+#if ! defined _GLDCORE_H && ! defined _GRIDLABD_H
+#error "this header may only be included from gldcore.h or gridlabd.h"
+#endif
+
+#include "platform.h"
+#include "property.h"
+
+/*	Typedef: HEAPACCOUNTTYPE
+		HA_CORE - core subsystem (schedules, loadshapes, ...)
+		HA_MODULE - module data structure (solver matrices, buffers, ...)
+		HA_CLASS - object data of a class
+ */
+typedef enum {
+	HA_CORE		= 0,
+	HA_MODULE	= 1,
+	HA_CLASS	= 2,
+} HEAPACCOUNTTYPE;
+
+/*	Typedef: HEAPACCOUNT
+		Memory account of a class, module data structure or core subsystem
+ */
+typedef struct s_heapaccount {
+	HEAPACCOUNTTYPE type; /**< type of account */
+	char owner[64]; /**< module or core subsystem that owns the memory */
+	char name[64]; /**< name of the class or data structure */
+	int64 count; /**< number of live allocations */
+	int64 bytes; /**< number of bytes currently allocated */
+	int64 peak; /**< largest number of bytes allocated at any time */
+	int64 instance; /**< size of a single instance (0 if instances vary in size) */
+	struct s_heapaccount *next; /**< next account */
+} HEAPACCOUNT;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*	Function: heap_account
+		Find or create a memory account
+
+	Returns:
+		HEAPACCOUNT* - the account
+ */
+HEAPACCOUNT *heap_account(HEAPACCOUNTTYPE type, const char *owner, const char *name, int64 instance);
+
+/*	Function: heap_class_account
+		Get the memory account for objects of a class
+ */
+HEAPACCOUNT *heap_class_account(CLASS *oclass);
+
+/*	Function: heap_add
+		Record an allocation of size bytes in an account
+ */
+void heap_add(HEAPACCOUNT *account, int64 size);
+
+/*	Function: heap_remove
+		Record the release of size bytes from an account
+ */
+void heap_remove(HEAPACCOUNT *account, int64 size);
+
+/*	Function: heap_set
+		Set the number of allocations and bytes held in an account
+ */
+void heap_set(HEAPACCOUNT *account, int64 count, int64 size);
+
+/*	Function: heap_getfirst
+		Get the first memory account
+ */
+HEAPACCOUNT *heap_getfirst(void);
+
+/*	Function: heap_gettotal
+		Get the total number of bytes allocated in all accounts
+ */
+int64 heap_gettotal(void);
+
+/*	Function: heap_report
+		Output the memory report
+ */
+void heap_report(const char *when);
+
+/*	Function: heap_json
+		Write the memory accounts as a JSON object
+
+	Returns:
+		int - number of characters written, or -1 if the buffer is too small
+ */
+int heap_json(char *buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
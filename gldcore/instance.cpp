@@ -40,6 +40,36 @@ void printcontent(char *data, size_t len){
 #endif
 }
 
+/** instance_recv_all
+	Receive exactly len bytes from a socket.  Multirun messages are sent
+	back-to-back over a stream socket, so a single recv() may return a
+	partial message or run into the next one.
+	@returns the number of bytes received, 0 if the socket was closed, or <0 on error
+ **/
+int instance_recv_all(int sockfd, char *buffer, size_t len)
+{
+	size_t got = 0;
+	while ( got < len )
+	{
+		int rv = recv(sockfd, buffer+got, (int)(len-got), 0);
+		if ( rv <= 0 )
+		{
+			return rv;
+		}
+		got += rv;
+	}
+	return (int)got;
+}
+
+/** instance_message_size
+	Compute the size of a data message exchanged with an instance
+	@returns the message size in bytes
+ **/
+size_t instance_message_size(instance *inst)
+{
+	return strlen(MSG_DATA) + sizeof(MESSAGE) + inst->prop_size;
+}
+
 /** message_init
     Initialize a message cache for communication between master and slave.
 	This function zeros the buffer and sets the usage to the first data
@@ -101,55 +131,51 @@ void *instance_runproc_socket(void *ptr)
 	int running = 1;
 	int rv = 0;
 	instance *inst = (instance*)ptr;
+	size_t msgsize = instance_message_size(inst);
+	char *buffer = (char*)malloc(msgsize); // separate from inst->buffer, which the master uses to send
+	if ( buffer == NULL )
+	{
+		output_error("instance_runproc_socket(): memory allocation failed");
+		return 0;
+	}
 	inst->has_data = 0;
 
 	while(running){
-		rv = recv(inst->sockfd, inst->buffer, (int)(inst->buffer_size), 0);
-//		IN_MYCONTEXT output_debug("%d = recv(%d, %x, %d, 0)", rv, inst->sockfd, inst->buffer, inst->buffer_size);
+		rv = instance_recv_all(inst->sockfd, buffer, msgsize);
 		if(0 == rv){
-			output_error("instance_runproc_socket(): socket was closed before receiving data");
-			running = 0;
+			IN_MYCONTEXT output_verbose("instance_runproc_socket(): slave %d closed its socket", inst->id);
+			break;
 		} else if(0 > rv){
 			output_error("instance_runproc_socket(): error receiving data");
-			running = 0;
+			break;
 		}
 		pthread_mutex_lock(&inst->sock_lock);
-		if(0 == memcmp(inst->buffer, MSG_DATA, strlen(MSG_DATA))){
-			// got_data = 1;
-//			wlock(&inst->has_data_lock);
+		if(0 == memcmp(buffer, MSG_DATA, strlen(MSG_DATA))){
+			memcpy(inst->cache, buffer+strlen(MSG_DATA), sizeof(MESSAGE));
+			memcpy(inst->message->data_buffer, buffer+strlen(MSG_DATA)+sizeof(MESSAGE), inst->prop_size);
 			inst->has_data += 1;
-//			wunlock(&inst->has_data_lock);
 			//IN_MYCONTEXT output_debug("instance_runproc_socket(): found "MSG_DATA);
-			//IN_MYCONTEXT output_debug("instance_runproc_socket(): recv'd %d bytes", rv);
-		} else if(0 == memcmp(inst->buffer, MSG_ERR, strlen(MSG_ERR))){
+		} else if(0 == memcmp(buffer, MSG_ERR, strlen(MSG_ERR))){
 			output_error("instance_runproc_socket(): slave indicated an error occured"); // error occured
 			running = 0;
-		} else if(0 == memcmp(inst->buffer, MSG_DONE, strlen(MSG_DONE))){
+		} else if(0 == memcmp(buffer, MSG_DONE, strlen(MSG_DONE))){
 			IN_MYCONTEXT output_verbose("instance_runproc_socket(): slave indicated run completion"); // other side is done and is closing down
 			running = 0;
 		} else {
-			// stdio message
-			;
+			output_error("instance_runproc_socket(): unrecognized message from slave %d", inst->id);
+			running = 0;
 		}
-		memcpy(inst->cache, inst->buffer+strlen(MSG_DATA), sizeof(MESSAGE));
-		memcpy(inst->message->data_buffer, inst->buffer+strlen(MSG_DATA)+sizeof(MESSAGE), inst->prop_size);
-
-		/* copy to inst->somewhere */
-		//IN_MYCONTEXT output_debug("i_rp_s(): waiting to send broadcast %d", inst->sock_signal);
-		//pthread_mutex_lock(&inst->wait_lock);
-//		pthread_mutex_lock(&inst->sock_lock);
-//		pthread_cond_wait(&inst->wait_signal, &inst->wait_lock);
-//		pthread_cond_wait(&inst->wait_signal, &inst->sock_lock);
 		IN_MYCONTEXT output_debug("inst %d sending signal 0x%x", inst->id, &(inst->sock_signal));
 		pthread_cond_broadcast(&(inst->sock_signal));
-//		pthread_mutex_unlock(&inst->wait_lock);
 		pthread_mutex_unlock(&inst->sock_lock);
-		//IN_MYCONTEXT output_debug("i_rp_s(): sending broadcast %d", inst->sock_signal);
-		
-		
 	}
+
+	// wake the master if it is waiting on a slave that is gone
+	pthread_mutex_lock(&inst->sock_lock);
+	inst->has_data = -1;
 	pthread_cond_broadcast(&inst->sock_signal);
-	sock_created = 0;
+	pthread_mutex_unlock(&inst->sock_lock);
+	free(buffer);
 	return 0;
 }
 
@@ -325,28 +351,24 @@ int instance_master_wait_socket(instance *inst){
 
 	if(sock_created){
 		// wait for message
-//		wlock(&inst->has_data_lock);
+		int ok;
 		pthread_mutex_lock(&inst->sock_lock);
-		if(inst->has_data > 0){ // maybe 'while' this?
-//			wunlock(&inst->has_data_lock);
-			IN_MYCONTEXT output_debug("instance_master_wait_socket(): already has data for %d", inst->id);
-		} else {
-			//wunlock(&inst->has_data_lock);
-			//IN_MYCONTEXT output_debug("instance_master_wait_socket(): requesting unwait on %d", inst->sock_signal);
-			IN_MYCONTEXT output_debug("instance_master_wait_socket(): inst %d waiting on %x", inst->id, &inst->sock_signal);
-			//pthread_cond_broadcast(&inst->wait_signal);
-			
-//			pthread_mutex_lock(&inst->sock_lock);
-//			pthread_cond_broadcast(&inst->wait_signal);
+		while ( inst->has_data == 0 )
+		{
 			IN_MYCONTEXT output_debug("inst %d waiting on signal 0x%x", inst->id, &(inst->sock_signal));
 			pthread_cond_wait(&inst->sock_signal, &inst->sock_lock);
-			pthread_mutex_unlock(&inst->sock_lock);
-			
 		}
-//		wlock(&inst->has_data_lock);
-		inst->has_data -= 1;
-//		wunlock(&inst->has_data_lock);
+		ok = ( inst->has_data > 0 );
+		if ( ok )
+		{
+			inst->has_data -= 1;
+		}
 		pthread_mutex_unlock(&inst->sock_lock);
+		if ( ! ok )
+		{
+			output_error("instance_master_wait_socket(): slave %d is no longer connected", inst->id);
+			return 0;
+		}
 	} else {
 		IN_MYCONTEXT output_debug("instance_master_wait_socket(): no socket mutexes");
 		return 0;
@@ -364,6 +386,10 @@ int instance_master_wait(void)
 
 	for ( inst=instance_list ; inst!=NULL ; inst=inst->next )
 	{
+		if ( inst->idle )
+		{
+			continue;
+		}
 		IN_MYCONTEXT output_verbose("master waiting on slave %d", inst->id);
 #ifdef WIN32
 		if(inst->cnxtype == CI_MMAP){
@@ -447,6 +473,10 @@ void instance_master_done(TIMESTAMP t1)
 	instance *inst;
 	for ( inst=instance_list ; inst!=NULL ; inst=inst->next )
 	{
+		if ( inst->idle )
+		{
+			continue;
+		}
 		//IN_MYCONTEXT output_debug("master setting slave %d controller c->ts from %lli to t1 %lli", inst->cache->id, inst->cache->ts, t1);
 		// needs to be done in instance_write_slave, this is too late
 		inst->cache->ts = t1;
@@ -622,9 +652,6 @@ STATUS instance_initall(void)
 		global_multirun_mode = MRM_MASTER;
 		IN_MYCONTEXT output_verbose("entering multirun mode");
 		output_prefix_enable();
-		pthread_mutex_lock(&mls_inst_lock);
-		pthread_cond_wait(&mls_inst_signal, &mls_inst_lock);
-		
 	} else {
 		return SUCCESS;
 	}
@@ -703,10 +730,101 @@ TIMESTAMP instance_read_slave(instance *inst)
 	return t2;
 }
 
+/** instance_lookahead_idle
+	Determine whether a slave can skip the exchange at t1.  A slave's outputs
+	cannot change before the next time it reported, so it only needs to be
+	synchronized when that time is reached or the data sent to it changes.
+	@return non-zero if the slave does not need to be synchronized at t1
+ **/
+static int instance_lookahead_idle(instance *inst, TIMESTAMP t1)
+{
+	size_t size = (size_t)*(inst->message->data_size);
+
+	if ( ! global_multirun_lookahead || inst->sent == NULL )
+	{
+		return 0;
+	}
+	if ( t1 >= absolute_timestamp(inst->horizon) )
+	{
+		return 0;
+	}
+	return memcmp(inst->sent, inst->message->data_buffer, size) == 0;
+}
+
+/** instance_linkage_converged
+	Determine whether a linked value changed by no more than multirun_tolerance
+	since the last exchange.  Real and complex values are compared relative to
+	their magnitude, and other values must be unchanged.
+	@return non-zero if the value has converged
+ **/
+static int instance_linkage_converged(linkage *lnk, const char *last)
+{
+	PROPERTY *prop = lnk->target.prop;
+	if ( strcmp(last,lnk->addr) == 0 )
+	{
+		return 1;
+	}
+	if ( prop->ptype == PT_double || prop->ptype == PT_complex )
+	{
+		complex a(0,0), b(0,0);
+		if ( property_read(prop,prop->ptype==PT_double?(void*)&a.Re():(void*)&a,last) == 0
+			|| property_read(prop,prop->ptype==PT_double?(void*)&b.Re():(void*)&b,lnk->addr) == 0 )
+		{
+			return 0;
+		}
+		double m = ( a.Mag() > b.Mag() ? a.Mag() : b.Mag() );
+		return (a-b).Mag() <= global_multirun_tolerance * m;
+	}
+	return 0;
+}
+
+/** instance_converged
+	Determine whether the data exchanged with a slave at t1 has converged.
+	The first exchange at a time never converges because the master has
+	not yet solved with the slave's data.
+	@return non-zero if the master does not need to iterate with the slave again
+ **/
+static int instance_converged(instance *inst, TIMESTAMP t1)
+{
+	size_t size = (size_t)*(inst->message->data_size);
+	int converged = ( inst->exchanged != NULL && inst->last_exchange == t1 );
+	linkage *lnk;
+
+	if ( inst->exchanged == NULL )
+	{
+		inst->exchanged = (char*)malloc(size);
+		if ( inst->exchanged == NULL )
+		{
+			return 1;
+		}
+	}
+	for ( lnk=inst->write ; converged && lnk!=NULL ; lnk=lnk->next )
+	{
+		converged = instance_linkage_converged(lnk,inst->exchanged+(lnk->addr-inst->message->data_buffer));
+	}
+	for ( lnk=inst->read ; converged && lnk!=NULL ; lnk=lnk->next )
+	{
+		converged = instance_linkage_converged(lnk,inst->exchanged+(lnk->addr-inst->message->data_buffer));
+	}
+	memcpy(inst->exchanged, inst->message->data_buffer, size);
+	inst->last_exchange = t1;
+	return converged;
+}
+
 /** instance_syncall
     Synchronize all slave instances
 	@return the next time, TS_NEVER if slave is done, and TS_INVALID is sync failed.
 
+	When multirun_lookahead is enabled, slaves whose next time has not been
+	reached and whose input data has not changed since the last exchange are
+	not synchronized; their last reported next time stands.
+
+	When multirun_tolerance is positive, the master iterates at t1 until the
+	data exchanged with each slave changes by no more than that relative
+	tolerance, so a model cut into slaves gives the same results as the
+	uncut model.  Otherwise the data the master sends at t1 is the result of
+	its last solution, and values read from slaves lag by one iteration.
+
 	@todo It would be better to give each slave its own thread
 	so the readback doesn't have to wait until that last slave
 	signals it's done. This would be much more like the method
@@ -722,6 +840,7 @@ TIMESTAMP instance_syncall(TIMESTAMP t1)
 		TIMESTAMP t2 = TS_NEVER;
 		clock_t ts = (clock_t)exec_clock();
 		instance *inst;
+		int active = 0;
 
 		/* check to see if an instance was lost */
 		if ( instances_exited>0 )
@@ -736,25 +855,60 @@ TIMESTAMP instance_syncall(TIMESTAMP t1)
 		for ( inst=instance_list ; inst!=NULL ; inst=inst->next ){
 			inst->cache->ts = t1;
 			instance_write_slave(inst);
+			inst->idle = instance_lookahead_idle(inst,t1);
+			if ( inst->idle )
+			{
+				IN_MYCONTEXT output_debug("slave %d is idle until %" FMT_INT64 "d", inst->id, inst->horizon);
+				inst->skipped++;
+			}
+			else
+			{
+				inst->exchanges++;
+				active++;
+			}
 		}
 	
-		/* signal slaves to start */
-		instance_master_done(t1);
+		if ( active > 0 )
+		{
+			/* signal slaves to start */
+			instance_master_done(t1);
 	
-		wc = instance_master_wait();
-		if(wc != 0){
-			;
+			wc = instance_master_wait();
+			if(wc == 0){
+				output_error("instance_syncall(): lost synchronization with slaves");
+				return TS_INVALID;
+			}
 		}
 
 		/* read linkages from slaves */
 		for ( inst=instance_list ; inst!=NULL ; inst=inst->next )
 		{
-			TIMESTAMP t3 = 0;
-			
-			t3 = instance_read_slave(inst);
-			if ( t3 < t2 ){
-				t2 = t3;
+			if ( inst->idle )
+			{
+				/* the cache still holds the slave's last data */
+				inst->cache->ts = inst->horizon;
 			}
+			inst->horizon = instance_read_slave(inst);
+			if ( inst->horizon < t2 ){
+				t2 = inst->horizon;
+			}
+			if ( global_multirun_tolerance > 0 && ! inst->idle && ! instance_converged(inst,t1) )
+			{
+				IN_MYCONTEXT output_debug("slave %d has not converged at %" FMT_INT64 "d", inst->id, t1);
+				t2 = t1;
+			}
+			if ( global_multirun_lookahead && ! inst->idle )
+			{
+				if ( inst->sent == NULL )
+				{
+					inst->sent = (char*)malloc((size_t)*(inst->message->data_size));
+				}
+				if ( inst->sent != NULL )
+				{
+					memcpy(inst->sent, inst->message->data_buffer, (size_t)*(inst->message->data_size));
+				}
+			}
+			inst->idle = 0;
 		}
 	
 		IN_MYCONTEXT output_debug("instance sync time is %" FMT_INT64 "d", t2);
@@ -771,7 +925,14 @@ STATUS instance_dispose(){
 		instance_master_done(TS_NEVER);
 		for(inst = instance_list; inst != 0; inst = inst->next){
 			// release pthread and event resources
-			;
+			if ( global_multirun_lookahead )
+			{
+				IN_MYCONTEXT output_verbose("slave %d synchronized %" FMT_INT64 "u times, lookahead skipped %" FMT_INT64 "u", inst->id, inst->exchanges, inst->skipped);
+			}
+			free(inst->sent);
+			inst->sent = NULL;
+			free(inst->exchanged);
+			inst->exchanged = NULL;
 		}
 		return SUCCESS;
 	} else { // slave
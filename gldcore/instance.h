@@ -144,6 +144,18 @@ typedef struct s_instance {
 			int has_data_lock;
 		};
 	};
+
+	/* lookahead synchronization (master only) */
+	TIMESTAMP horizon;		///< next time the slave reported, before which its outputs cannot change
+	char *sent;				///< link data at the last exchange with the slave
+	int idle;				///< slave is not exchanged with in the current sync
+	unsigned int64 exchanges;	///< number of exchanges with the slave
+	unsigned int64 skipped;	///< number of exchanges skipped by lookahead
+
+	/* iterated synchronization (master only) */
+	TIMESTAMP last_exchange;	///< time of the last exchange with the slave
+	char *exchanged;		///< link data at the last exchange with the slave
+
 	struct s_instance *next;  ///<
 } instance; ///<
 
@@ -182,6 +194,9 @@ STATUS linkage_master_to_slave(char *buffer, linkage *lnk);
 STATUS linkage_slave_to_master(char *buffer, linkage *lnk);
 
 void printcontent(char *data, size_t len);
+int instance_recv_all(int sockfd, char *buffer, size_t len);
+size_t instance_message_size(instance *inst);
+void instance_slave_resume_controller(void);
 
 #ifdef __cplusplus
 }
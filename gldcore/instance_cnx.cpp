@@ -132,12 +132,17 @@ STATUS instance_cnx_socket(instance *inst){
 
 	strcpy(blank, "");
 
-	// prepare intermediate buffer
-	inst->buffer = (char *)malloc(inst->cachesize);
+	// prepare intermediate buffer (large enough for both the cache and a data message)
+	inst->buffer_size = inst->cachesize;
+	if ( instance_message_size(inst) > inst->buffer_size )
+	{
+		inst->buffer_size = instance_message_size(inst);
+	}
+	inst->buffer = (char *)malloc(inst->buffer_size);
 	if(0 == inst->buffer){
 		return FAILED;
 	} else {
-		memset(inst->buffer, 0, inst->cachesize);
+		memset(inst->buffer, 0, inst->buffer_size);
 	}
 
 	// un-mangle hostname
@@ -367,7 +372,7 @@ STATUS instance_cnx_socket(instance *inst){
 		return FAILED;
 	}
 	if(check_id != inst->cacheid){
-		output_error("instance_cnx_socket(): callback id mismatch");
+		output_error("instance_cnx_socket(): callback id mismatch (expected %" FMT_INT64 "d, received %" FMT_INT64 "d)", inst->cacheid, check_id);
 		IN_MYCONTEXT output_debug(" local: " FMT_INT64 "d", inst->cacheid);
 		IN_MYCONTEXT output_debug(" input: " FMT_INT64 "d", check_id);
 		send(inst->sockfd, rsp, (int)strlen(rsp), 0);
@@ -23,6 +23,42 @@ unsigned int slave_id;
 pthread_t slave_tid;
 static instance local_inst;
 
+// the slave controller and the main loop take turns running, guarded by mls_inst_lock
+typedef enum {
+	MLS_TURN_MAIN = 0,
+	MLS_TURN_CONTROLLER = 1,
+	MLS_TURN_ANY = 2, ///< do not wait for the turn to come back
+} MLSTURN;
+static MLSTURN mls_inst_turn = MLS_TURN_MAIN;
+static bool mls_controller_done = false;
+
+/** instance_slave_handoff
+	Give the turn to another thread and optionally wait for it to come back
+ **/
+static void instance_slave_handoff(MLSTURN to, MLSTURN wait_for)
+{
+	pthread_mutex_lock(&mls_inst_lock);
+	mls_inst_turn = to;
+	pthread_cond_broadcast(&mls_inst_signal);
+	if ( wait_for != MLS_TURN_ANY )
+	{
+		while ( mls_inst_turn != wait_for && ( wait_for == MLS_TURN_CONTROLLER || ! mls_controller_done ) )
+		{
+			pthread_cond_wait(&mls_inst_signal, &mls_inst_lock);
+		}
+	}
+	pthread_mutex_unlock(&mls_inst_lock);
+}
+
+/** instance_slave_resume_controller
+	Called by the slave main loop to let the controller exchange data with 
+	the master.  Returns when the controller has updated the next sync time.
+ **/
+void instance_slave_resume_controller(void)
+{
+	instance_slave_handoff(MLS_TURN_CONTROLLER,MLS_TURN_MAIN);
+}
+
 STATUS instance_slave_get_data(void *buffer, size_t offset, size_t sz){
 	if(0 == buffer){
 		output_error("instance_slave_get_data(): null buffer pointer");
@@ -301,7 +337,7 @@ int instance_slave_wait_socket(){
 	}
 
 	// read socket
-	rv = recv(local_inst.sockfd, local_inst.buffer, (int)local_inst.buffer_size, 0);
+	rv = instance_recv_all(local_inst.sockfd, local_inst.buffer, instance_message_size(&local_inst));
 	printcontent(local_inst.buffer, rv);
 //	IN_MYCONTEXT output_debug("instance_slave_wait_socket(): %d = recv(%d, %x, %d, 0)", rv, local_inst.sockfd, local_inst.buffer, (int)local_inst.buffer_size);
 	if(0 == rv){
@@ -450,7 +486,10 @@ void *instance_slaveproc(void *ptr)
 	IN_MYCONTEXT output_verbose("instance_slaveproc(): slave %d controller startup in progress", slave_id);
 
 	pthread_mutex_lock(&mls_inst_lock);
-	pthread_cond_wait(&mls_inst_signal, &mls_inst_lock);
+	while ( mls_inst_turn != MLS_TURN_CONTROLLER )
+	{
+		pthread_cond_wait(&mls_inst_signal, &mls_inst_lock);
+	}
 	pthread_mutex_unlock(&mls_inst_lock);
 
 	rv = instance_slave_link_properties();
@@ -465,7 +504,6 @@ void *instance_slaveproc(void *ptr)
 			/* stop the main loop and exit the slave controller */
 			output_error("instance_slaveproc(): slave %d controller wait failure, thread stopping", slave_id);
 			exec_setexitcode(XC_PRCERR);
-			pthread_cond_broadcast(&mls_inst_signal);
 			break;
 		}
 
@@ -484,21 +522,17 @@ void *instance_slaveproc(void *ptr)
 		// note, if TS_NEVER, we want the slave's exec loop to end normally
 		//IN_MYCONTEXT output_debug("slave %d controller resuming exec with %lli", slave_id, local_inst.cache->ts);
 		IN_MYCONTEXT output_debug("slave %d controller resuming exec with %lli", local_inst.cache->id, local_inst.cache->ts);
-		IN_MYCONTEXT output_debug("slave %d controller setting step_to %lli to cache->ts %lli", local_inst.cache->id, exec_sync_get(NULL), local_inst.cache->ts);
-		exec_sync_merge(NULL,(struct sync_data*)&local_inst.cache);
-
-		pthread_cond_broadcast(&mls_inst_signal);
-
 		if(local_inst.cache->ts == TS_NEVER){
 			break;
 		}
 
-		/* wait for main loop to pause */
-		IN_MYCONTEXT output_verbose("slave %d controller waiting for main to complete", slave_id);
+		/* the master's clock is a hard event for the slave */
+		IN_MYCONTEXT output_debug("slave %d controller setting step_to %lli to cache->ts %lli", local_inst.cache->id, exec_sync_get(NULL), local_inst.cache->ts);
+		exec_sync_set(NULL,local_inst.cache->ts,false);
 
-		pthread_mutex_lock(&mls_inst_lock);
-		pthread_cond_wait(&mls_inst_signal, &mls_inst_lock);
-		pthread_mutex_unlock(&mls_inst_lock);
+		/* resume the main loop and wait for it to pause */
+		IN_MYCONTEXT output_verbose("slave %d controller waiting for main to complete", slave_id);
+		instance_slave_handoff(MLS_TURN_MAIN,MLS_TURN_CONTROLLER);
 
 		/* @todo copy output linkages */
 		IN_MYCONTEXT output_debug("slave %d controller writing links", slave_id);
@@ -511,14 +545,18 @@ void *instance_slaveproc(void *ptr)
 		}
 //		IN_MYCONTEXT output_debug("continuing");
 
-		/* copy the next time stamp */
-		/* how about we copy the time we want to step to and see what the master says, instead? -MH */
-		exec_sync_reset((struct sync_data*)&local_inst.cache);
-		exec_sync_set((struct sync_data*)&local_inst.cache,0,false);
+		/* report the time the slave main loop wants to step to next */
+		local_inst.cache->ts = exec_sync_get(NULL);
 
 		instance_slave_done();
 	} while (global_clock != TS_NEVER && rv == SUCCESS);
 	IN_MYCONTEXT output_verbose("slave %" FMT_INT64 " completion state reached", local_inst.cacheid);
+
+	/* release the main loop for good */
+	pthread_mutex_lock(&mls_inst_lock);
+	mls_controller_done = true;
+	pthread_mutex_unlock(&mls_inst_lock);
+	instance_slave_handoff(MLS_TURN_MAIN,MLS_TURN_ANY);
 	pthread_exit(NULL);
 	return NULL;
 }
@@ -580,7 +618,7 @@ STATUS instance_slave_init_mem(){
 	
 	local_inst.name_size = *(local_inst.message->name_size);
 	local_inst.prop_size = *(local_inst.message->data_size);
-	exec_sync_merge(NULL,(void*)&local_inst.cache);
+	exec_sync_set(NULL,local_inst.cache->ts,false);
 
 	/* open slave signalling event */
 	sprintf(eventName,"GLD-%" FMT_INT64 "x-S", global_master_port);
@@ -675,8 +713,8 @@ STATUS instance_slave_init_socket(){
 		output_fatal("instance_slave_init_socket(): error sending slave handshake");
 		return FAILED;
 	}
-	// get response
-	rv = recv(local_inst.sockfd, cmd, 1024, 0);
+	// get response (the master sends the instance data right behind it)
+	rv = instance_recv_all(local_inst.sockfd, cmd, strlen(HS_RSP));
 	if(rv == 0){
 		output_fatal("instance_slave_init_socket(): socket closed before slave handshake response recv'd");
 		return FAILED;
@@ -694,7 +732,7 @@ STATUS instance_slave_init_socket(){
 	}
 
 	// recv instance struct
-	rv = recv(local_inst.sockfd, cmd, 1024, 0);
+	rv = instance_recv_all(local_inst.sockfd, cmd, strlen(MSG_INST)+sizeof(pickle));
 	if(rv == 0){
 		output_fatal("instance_slave_init_socket(): socket closed before instance data recv'd");
 		return FAILED;
@@ -713,16 +751,19 @@ STATUS instance_slave_init_socket(){
 	local_inst.buffer_size = local_inst.cachesize = pickle.cachesize;
 	local_inst.name_size = pickle.name_size;
 	local_inst.prop_size = pickle.prop_size;
+	if ( instance_message_size(&local_inst) > local_inst.buffer_size )
+	{
+		local_inst.buffer_size = instance_message_size(&local_inst);
+	}
 	local_inst.id = slave_id = pickle.id;
-	local_inst.buffer = (char *)malloc(local_inst.cachesize);
+	local_inst.buffer = (char *)malloc(local_inst.buffer_size);
 	local_inst.cache = (MESSAGE *)malloc(local_inst.cachesize);
-	memset(local_inst.buffer, 0, local_inst.cachesize);
+	memset(local_inst.buffer, 0, local_inst.buffer_size);
 	memset(local_inst.cache, 0, local_inst.cachesize);
 	local_inst.cache->name_size = (int16)local_inst.name_size;
 	local_inst.cache->data_size = (int16)local_inst.prop_size;
 	local_inst.cache->id = local_inst.id;
-	exec_sync_set((struct sync_data*)&local_inst.cache,pickle.ts,false);
-	exec_sync_merge(NULL,(struct sync_data*)&local_inst.cache);
+	exec_sync_set(NULL,pickle.ts,false);
 	if(0 == local_inst.buffer){
 		output_error("malloc() error with li.buffer");
 		return FAILED;
@@ -432,6 +432,16 @@ int GldJsonWriter::write_objects(FILE *fp)
 	OBJECT *obj;
 	len += write(",\n\t\"objects\" : {");
 
+	/* index transform targets so initial values can be written as transforms */
+	std::map<void*,TRANSFORM*> targets;
+	if ( (global_filesave_options&FSO_INITIAL) == FSO_INITIAL )
+	{
+		for ( TRANSFORM *xform = transform_getnext(NULL) ; xform != NULL ; xform = transform_getnext(xform) )
+		{
+			targets.insert(std::pair<void*,TRANSFORM*>((void*)xform->target,xform)); // first transform wins, as in transform_has_target()
+		}
+	}
+
 	/* scan each object in the model */
 	size_t buffer_size = 5000;
 	char *buffer = (char*)malloc(buffer_size);
@@ -493,8 +503,21 @@ int GldJsonWriter::write_objects(FILE *fp)
 			}
         	else if ( (global_filesave_options&FSO_INITIAL) == FSO_INITIAL )
         	{
-        		// initialization value is desired
-        		value = object_property_to_initial(obj,prop->name, buffer, buffer_size);
+        		// initialization value is desired, including any transform that drives it
+        		std::map<void*,TRANSFORM*>::iterator xform = targets.find(property_addr(obj,prop));
+        		if ( xform != targets.end() && transform_to_string(buffer,buffer_size,xform->second) > 0 )
+        		{
+        			value = buffer;
+        		}
+        		else if ( prop->ptype == PT_double )
+        		{
+        			// transforms are already indexed, so skip the object and transform searches done by initial_from_double()
+        			value = object_property_to_string(obj,prop->name, buffer, buffer_size);
+        		}
+        		else
+        		{
+        			value = object_property_to_initial(obj,prop->name, buffer, buffer_size);
+        		}
         	}
 			else if ( prop->ptype == PT_enduse )
 			{
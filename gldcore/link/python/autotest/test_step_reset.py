@@ -0,0 +1,17 @@
+import gridlabd
+
+gridlabd.command('-D')
+gridlabd.command('PYTHON')
+gridlabd.command('test_step_reset.glm')
+gridlabd.start('pause')
+
+start = gridlabd.reset()
+first = [gridlabd.step(start+hour*3600,['example.x','clock']) for hour in range(1,4)]
+assert(first[-1][0] == start+3*3600)
+assert(first[-1][1][1] == first[-1][0])
+
+start = gridlabd.reset()
+second = [gridlabd.step(start+hour*3600,['example.x','clock']) for hour in range(1,4)]
+assert(first == second)
+
+gridlabd.resume()
@@ -10,6 +10,9 @@
 #include <frameobject.h>
 #include "python_embed.h"
 #include "python_property.h"
+#include <map>
+#include <string>
+#include <vector>
 
 static PyObject *gridlabd_exception(const char *format, ...);
 
@@ -25,6 +28,7 @@ static PyObject *gridlabd_warning(PyObject *self, PyObject *args);
 static PyObject *gridlabd_error(PyObject *self, PyObject *args);
 
 static PyObject *gridlabd_reset(PyObject *self, PyObject *args);
+static PyObject *gridlabd_snapshot(PyObject *self, PyObject *args);
 static PyObject *gridlabd_command(PyObject *self, PyObject *args);
 
 static PyObject *gridlabd_start(PyObject *self, PyObject *args);
@@ -33,6 +37,7 @@ static PyObject *gridlabd_cancel(PyObject *self, PyObject *args);
 static PyObject *gridlabd_pause(PyObject *self, PyObject *args);
 static PyObject *gridlabd_pauseat(PyObject *self, PyObject *args);
 static PyObject *gridlabd_resume(PyObject *self, PyObject *args);
+static PyObject *gridlabd_step(PyObject *self, PyObject *args);
 
 static PyObject *gridlabd_module(PyObject *self, PyObject *args);
 static PyObject *gridlabd_add(PyObject *self, PyObject *args);
@@ -69,6 +74,7 @@ static PyMethodDef module_methods[] = {
     {"error", gridlabd_error, METH_VARARGS, "Output an error message"},
     // simulation control
     {"reset", gridlabd_reset, METH_VARARGS, "Reset the simulation to initial conditions"},
+    {"snapshot", gridlabd_snapshot, METH_VARARGS, "Save the current state of the paused simulation as the reset point"},
     {"command", gridlabd_command, METH_VARARGS, "Send a command argument to the GridLAB-D instance"},
     {"start", gridlabd_start, METH_VARARGS, "Start the GridLAB-D instance"},
     {"wait", gridlabd_wait, METH_VARARGS, "Wait for the GridLAB-D instance to stop"},
@@ -76,6 +82,7 @@ static PyMethodDef module_methods[] = {
     {"pause", gridlabd_pause, METH_VARARGS, "Pause the GridLAB-D instance"},
     {"pauseat",gridlabd_pauseat, METH_VARARGS, "Pause the GridLAB-D instance at a specified time"},
     {"resume",gridlabd_resume, METH_VARARGS, "Resume the GridLAB-D instance"},
+    {"step",gridlabd_step, METH_VARARGS, "Advance the GridLAB-D instance to a specified time and get observations"},
     // model editing
     {"module", gridlabd_module, METH_VARARGS, "Load a python GridLAB-D module"},
     {"add", gridlabd_add, METH_VARARGS, "Add an element to the current model"}, 
@@ -446,9 +453,138 @@ static int return_code = 0;
 #endif
 static pthread_t main_thread;
 
+//
+// Snapshot of the simulation state used by reset()
+//
+// The snapshot holds the values of all published object properties that are
+// stored by value, the object clocks and random states, the global variables
+// (including module globals), and the main loop sync event.  Properties whose
+// storage is held outside the object (strings, arrays, python objects) and
+// state kept privately by modules (e.g., open player files) are not restored.
+//
+static struct s_snapshot {
+    std::vector< std::pair<void*,size_t> > items;
+    std::vector<char> data;
+    struct sync_data sync;
+} reset_snapshot;
+
+static bool snapshot_restorable(PROPERTY *prop)
+{
+    switch ( prop->ptype ) {
+    case PT_double:
+    case PT_complex:
+    case PT_enumeration:
+    case PT_set:
+    case PT_int16:
+    case PT_int32:
+    case PT_int64:
+    case PT_char8:
+    case PT_char32:
+    case PT_char256:
+    case PT_char1024:
+    case PT_object:
+    case PT_bool:
+    case PT_timestamp:
+    case PT_real:
+    case PT_float:
+    case PT_random:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static void snapshot_add(void *addr, size_t size)
+{
+    reset_snapshot.items.push_back(std::pair<void*,size_t>(addr,size));
+    reset_snapshot.data.insert(reset_snapshot.data.end(),(char*)addr,(char*)addr+size);
+}
+
+// must be called while the main loop is paused
+static size_t snapshot_save(void)
+{
+    reset_snapshot.items.clear();
+    reset_snapshot.data.clear();
+    for ( OBJECT *obj = object_get_first() ; obj != NULL ; obj = object_get_next(obj) )
+    {
+        snapshot_add(&obj->clock,sizeof(obj->clock));
+        snapshot_add(&obj->valid_to,sizeof(obj->valid_to));
+        snapshot_add(&obj->rng_state,sizeof(obj->rng_state));
+        for ( PROPERTY *prop = class_get_first_property_inherit(obj->oclass) ; prop != NULL ; prop = class_get_next_property_inherit(prop) )
+        {
+            if ( snapshot_restorable(prop) )
+            {
+                snapshot_add((char*)(obj+1)+(int64)(prop->addr),property_size(prop));
+            }
+        }
+    }
+    for ( GLOBALVAR *var = global_getnext(NULL) ; var != NULL ; var = global_getnext(var) )
+    {
+        if ( var->prop->addr == (void*)&global_mainloopstate || var->prop->addr == (void*)&global_mainlooppauseat )
+        {
+            continue;
+        }
+        if ( var->prop->addr != NULL && snapshot_restorable(var->prop) )
+        {
+            snapshot_add(var->prop->addr,property_size(var->prop));
+        }
+    }
+    reset_snapshot.sync.step_to = TS_NEVER;
+    reset_snapshot.sync.hard_event = 0;
+    reset_snapshot.sync.status = SUCCESS;
+    my_instance->get_exec()->sync_merge(&reset_snapshot.sync,NULL);
+    return reset_snapshot.data.size();
+}
+
+// must be called while the main loop is paused
+static void snapshot_restore(void)
+{
+    const char *data = &reset_snapshot.data[0];
+    for ( std::vector< std::pair<void*,size_t> >::iterator item = reset_snapshot.items.begin() ; item != reset_snapshot.items.end() ; item++ )
+    {
+        memcpy(item->first,data,item->second);
+        data += item->second;
+    }
+
+    // keep the main loop paused at the restored clock and resume from the saved sync event
+    global_mainlooppauseat = global_clock;
+    my_instance->get_exec()->sync_reset(NULL);
+    my_instance->get_exec()->sync_merge(NULL,&reset_snapshot.sync);
+}
+
+//
+// >>> gridlabd.reset()
+//
+// Returns: (long) global_clock
+//
 static PyObject *gridlabd_reset(PyObject *self, PyObject *args)
 {
-    return gridlabd_exception("reset not implemented yet");
+    if ( gridlabd_module_status != GMS_RUNNING || global_mainloopstate != MLS_PAUSED )
+    {
+        return gridlabd_exception("cannot reset unless paused");
+    }
+    if ( reset_snapshot.items.empty() )
+    {
+        return gridlabd_exception("cannot reset without a snapshot (use start('pause') or snapshot())");
+    }
+    WriteLock wlock;
+    snapshot_restore();
+    return PyLong_FromLongLong(global_clock);
+}
+
+//
+// >>> gridlabd.snapshot()
+//
+// Returns: (long) size of the snapshot in bytes
+//
+static PyObject *gridlabd_snapshot(PyObject *self, PyObject *args)
+{
+    if ( gridlabd_module_status != GMS_RUNNING || global_mainloopstate != MLS_PAUSED )
+    {
+        return gridlabd_exception("cannot take snapshot unless paused");
+    }
+    WriteLock wlock;
+    return PyLong_FromSize_t(snapshot_save());
 }
 
 //
@@ -712,19 +848,31 @@ static PyObject *gridlabd_start(PyObject *self, PyObject *args)
         return gridlabd_exception("unable to start gridlabd in this module instance");
 #else
         save_environ();
-        exec_mls_create();
         gridlabd_module_status = GMS_STARTED;
         global_multirun_mode = MRM_LIBRARY;
+        if ( strcmp(command,"pause") == 0 )
+        {
+            // pause the main loop before the first event
+            global_mainlooppauseat = TS_ZERO;
+        }
         pthread_create(&main_thread, NULL, gridlabd_main, NULL);
         pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, 0);
-        while ( gridlabd_module_status == GMS_STARTED )
+        while ( gridlabd_module_status == GMS_STARTED 
+            || ( gridlabd_module_status == GMS_RUNNING && global_mainloopstate == MLS_INIT ) )
         {
             usleep(100);
         }
-        exec_mls_statewait(~MLS_INIT);
-        if ( strcmp(command,"pause") == 0 )
+        if ( strcmp(command,"pause") == 0 && gridlabd_module_status == GMS_RUNNING )
         {
-            exec_mls_suspend();
+            // the post-init state is the reset point
+            Py_BEGIN_ALLOW_THREADS
+            my_instance->get_exec()->mls_step(TS_ZERO);
+            Py_END_ALLOW_THREADS
+            if ( global_mainloopstate == MLS_PAUSED )
+            {
+                WriteLock wlock;
+                snapshot_save();
+            }
         }
         if ( gridlabd_module_status != GMS_RUNNING )
         {
@@ -836,12 +984,12 @@ static PyObject *gridlabd_pauseat(PyObject *self, PyObject *args)
         return NULL;
     }
     TIMESTAMP ts = convert_to_timestamp(value);
-    exec_mls_resume(ts);
-    if ( global_mainloopstate != MLS_RUNNING )
+    if ( global_mainloopstate != MLS_DONE )
     {
-        exec_mls_statewait(MLS_RUNNING);
+        Py_BEGIN_ALLOW_THREADS
+        my_instance->get_exec()->mls_step(ts);
+        Py_END_ALLOW_THREADS
     }
-    exec_mls_statewait(MLS_PAUSED);
     if ( PyErr_Occurred() )
     {
         return NULL;
@@ -875,6 +1023,161 @@ static PyObject *gridlabd_resume(PyObject *self, PyObject *args)
 
 }
 
+//
+// Observations are resolved once and kept by name, so repeated steps only
+// read the values
+//
+typedef struct s_observation {
+    PROPERTY *prop;
+    void *addr;
+    OBJECT *obj; // NULL for globals
+} OBSERVATION;
+static std::map<std::string,OBSERVATION> observations;
+
+static OBSERVATION *find_observation(const char *name)
+{
+    std::map<std::string,OBSERVATION>::iterator item = observations.find(name);
+    if ( item != observations.end() )
+    {
+        return &(item->second);
+    }
+    OBSERVATION observation = {NULL,NULL,NULL};
+    GLOBALVAR *var = global_find(name);
+    if ( var != NULL )
+    {
+        observation.prop = var->prop;
+        observation.addr = var->prop->addr;
+    }
+    else
+    {
+        const char *dot = strrchr(name,'.');
+        if ( dot == NULL )
+        {
+            return NULL;
+        }
+        std::string objname(name,dot-name);
+        observation.obj = object_find_name(objname.c_str());
+        if ( observation.obj == NULL )
+        {
+            return NULL;
+        }
+        observation.prop = object_get_property(observation.obj,dot+1,NULL);
+        if ( observation.prop == NULL )
+        {
+            return NULL;
+        }
+        observation.addr = (char*)(observation.obj+1)+(int64)(observation.prop->addr);
+    }
+    return &(observations[name] = observation);
+}
+
+static PyObject *get_observation(OBSERVATION *observation)
+{
+    switch ( observation->prop->ptype ) {
+    case PT_double:
+    case PT_random:
+        return PyFloat_FromDouble(*(double*)observation->addr);
+    case PT_real:
+        return PyFloat_FromDouble(*(real*)observation->addr);
+    case PT_float:
+        return PyFloat_FromDouble(*(float*)observation->addr);
+    case PT_complex:
+        return PyComplex_FromDoubles(((complex*)observation->addr)->Re(),((complex*)observation->addr)->Im());
+    case PT_int16:
+        return PyLong_FromLong(*(int16*)observation->addr);
+    case PT_int32:
+        return PyLong_FromLong(*(int32*)observation->addr);
+    case PT_int64:
+    case PT_timestamp:
+        return PyLong_FromLongLong(*(int64*)observation->addr);
+    case PT_bool:
+        return PyBool_FromLong(*(bool*)observation->addr);
+    default:
+        {
+            char value[1024] = "";
+            if ( property_write(observation->prop,observation->addr,value,sizeof(value)) < 0 )
+            {
+                Py_INCREF(Py_None);
+                return Py_None;
+            }
+            return Py_BuildValue("s",value);
+        }
+    }
+}
+
+//
+// >>> gridlabd.step(timestamp[,observations])
+//
+// The timestamp may be an integer or a date/time string.  Observations are a
+// list of global names or 'object.property' names.
+//
+// Returns: (tuple) global_clock and the list of observed values
+//
+static PyObject *gridlabd_step(PyObject *self, PyObject *args)
+{
+    if ( gridlabd_module_status != GMS_RUNNING )
+    {
+        return gridlabd_exception("cannot step unless running");
+    }
+    PyObject *when, *names = NULL;
+    if ( ! PyArg_ParseTuple(args, "O|O", &when, &names) )
+    {
+        return NULL;
+    }
+    TIMESTAMP ts;
+    if ( PyLong_Check(when) )
+    {
+        ts = PyLong_AsLongLong(when);
+    }
+    else if ( PyUnicode_Check(when) )
+    {
+        restore_environ();
+        ts = convert_to_timestamp(PyUnicode_AsUTF8(when));
+    }
+    else
+    {
+        return gridlabd_exception("step time must be a timestamp or a date/time string");
+    }
+    if ( ts == TS_INVALID )
+    {
+        return gridlabd_exception("step time is not valid");
+    }
+    std::vector<OBSERVATION*> list;
+    if ( names != NULL && names != Py_None )
+    {
+        PyObject *seq = PySequence_Fast(names,"observations must be a list of names");
+        if ( seq == NULL )
+        {
+            return NULL;
+        }
+        for ( Py_ssize_t n = 0 ; n < PySequence_Fast_GET_SIZE(seq) ; n++ )
+        {
+            const char *name = PyUnicode_AsUTF8(PySequence_Fast_GET_ITEM(seq,n));
+            OBSERVATION *observation = name ? find_observation(name) : NULL;
+            if ( observation == NULL )
+            {
+                Py_DECREF(seq);
+                return name ? gridlabd_exception("observation '%s' not found", name) : NULL;
+            }
+            list.push_back(observation);
+        }
+        Py_DECREF(seq);
+    }
+    if ( global_mainloopstate != MLS_DONE )
+    {
+        Py_BEGIN_ALLOW_THREADS
+        my_instance->get_exec()->mls_step(ts);
+        Py_END_ALLOW_THREADS
+    }
+    PyObject *values = PyList_New(list.size());
+    ReadLock rlock;
+    for ( size_t n = 0 ; n < list.size() ; n++ )
+    {
+        PyList_SET_ITEM(values,n,get_observation(list[n]));
+    }
+    return Py_BuildValue("(LN)",(long long)global_clock,values);
+}
+
 //
 // >>> gridlabd.save(filename)
 //
@@ -66,6 +66,7 @@ gridlabd = Extension('gridlabd',
 		'gldcore/find.cpp',
 		'gldcore/globals.cpp',
 		'gldcore/gui.cpp',
+		'gldcore/heap.cpp',
 		'gldcore/http_client.cpp',
 		'gldcore/index.cpp',
 		'gldcore/instance.cpp',
@@ -23,12 +23,12 @@ int linkage_create_writer(instance *inst, char *fromobj, char *fromvar, char *to
 	lnk->type = LT_MASTERTOSLAVE;
 
 	/* copy local info */
-	lnk->local.obj = fromobj;
-	lnk->local.prop = fromvar;
+	lnk->local.obj = strdup(fromobj);
+	lnk->local.prop = strdup(fromvar);
 
 	/* copy remote info */
-	lnk->remote.obj = toobj;
-	lnk->remote.prop = tovar;
+	lnk->remote.obj = strdup(toobj);
+	lnk->remote.prop = strdup(tovar);
 
 	/* attach to instance cache */
 	if ( !instance_add_linkage(inst, lnk) )
@@ -60,12 +60,12 @@ int linkage_create_reader(instance *inst, char *fromobj, char *fromvar, char *to
 	lnk->type = LT_SLAVETOMASTER;
 
 	/* copy local info */
-	lnk->local.obj = toobj;
-	lnk->local.prop = tovar;
+	lnk->local.obj = strdup(toobj);
+	lnk->local.prop = strdup(tovar);
 
 	/* copy remote info */
-	lnk->remote.obj = fromobj;
-	lnk->remote.prop = fromvar;
+	lnk->remote.obj = strdup(fromobj);
+	lnk->remote.prop = strdup(fromvar);
 
 	/* attach to instance cache */
 	if ( !instance_add_linkage(inst, lnk) )
@@ -80,6 +80,34 @@ int linkage_create_reader(instance *inst, char *fromobj, char *fromvar, char *to
 	}
 }
 
+/** linkage_get_value
+	Write the value of a linked property to the message buffer.  Real and
+	complex values are written at full precision when they fit, so that
+	values exchanged repeatedly converge like the values of a single model.
+	@returns the number of characters written, 0 on failure
+ **/
+static int linkage_get_value(linkage *lnk, int size)
+{
+	PROPERTY *prop = lnk->target.prop;
+	void *addr = GETADDR(lnk->target.obj,prop);
+	const char *unit = ( prop->unit ? prop->unit->name : NULL );
+	int len = -1;
+	if ( prop->ptype == PT_double && ! isnan(*(double*)addr) )
+	{
+		len = snprintf(lnk->addr,size,"%.15lg%s%s",*(double*)addr,unit?" ":"",unit?unit:"");
+	}
+	else if ( prop->ptype == PT_complex && ((complex*)addr)->Notation() != A && ((complex*)addr)->Notation() != R )
+	{
+		complex *z = (complex*)addr;
+		len = snprintf(lnk->addr,size,"%.15lg%+.15lg%c%s%s",z->Re(),z->Im(),z->Notation()==I?'i':'j',unit?" ":"",unit?unit:"");
+	}
+	if ( len > 0 && len < size )
+	{
+		return len;
+	}
+	return object_get_value_by_addr(lnk->target.obj, addr, lnk->addr, size, prop);
+}
+
 /** linkage_master_to_slave
     Updates the instance cache for a master->slave linkage.
 	@returns 1 on success, 0 on failure
@@ -104,7 +132,7 @@ STATUS linkage_master_to_slave(char *buffer, linkage *lnk)
 	switch ( global_multirun_mode ) {
 		case MRM_MASTER:
 //			rv = class_property_to_string(lnk->target.prop,GETADDR(lnk->target.obj,lnk->target.prop),(char *)((int64)lnk->addr),size);
-			rv = object_get_value_by_addr(lnk->target.obj, GETADDR(lnk->target.obj,lnk->target.prop), (char*)((int64)lnk->addr), size, lnk->target.prop);
+			rv = linkage_get_value(lnk, size);
 			IN_MYCONTEXT output_debug("prop %s, addr %x, addr2 %x, val %s", lnk->target.prop->name, GETADDR(lnk->target.obj,lnk->target.prop), (char *)((int64)lnk->addr), lnk->addr);
 			break;
 		case MRM_SLAVE:
@@ -150,7 +178,7 @@ STATUS linkage_slave_to_master(char *buffer, linkage *lnk)
 		break;
 	case MRM_SLAVE:
 //		rv = class_property_to_string(lnk->target.prop,GETADDR(lnk->target.obj,lnk->target.prop),(char *)((int64)lnk->addr),size);
-		rv = object_get_value_by_addr(lnk->target.obj, GETADDR(lnk->target.obj,lnk->target.prop), (char*)((int64)lnk->addr), size, lnk->target.prop);
+		rv = linkage_get_value(lnk, size);
 		IN_MYCONTEXT output_debug("prop %s, addr %x, addr2 %x, val %s", lnk->target.prop->name, GETADDR(lnk->target.obj,lnk->target.prop), (char *)((int64)lnk->addr), lnk->addr);
 		break;
 	default:
@@ -81,11 +81,15 @@ GldLoader::GldLoader(GldMain *main)
 	last_term = NULL;
 	last_term_buffer = NULL;
 	last_term_buffer_size = 1024;
+	import_hits = 0;
+	import_misses = 0;
+	import_time = 0;
 }
 
 GldLoader::~GldLoader(void)
 {
 	if ( last_term_buffer ) free(last_term_buffer);
+	import_cleanup();
 	// TODO: cleanup other allocated items
 }
 
@@ -438,6 +442,14 @@ int GldLoader::mkdirs(const char *path)
 				return -1;
 			}
 		}
+		// relative paths may need their first component too
+		if ( *tmp && access(tmp, F_OK) && (rc=mkdir(tmp, 0775)) && errno != EEXIST )
+		{
+			output_error("cannot create directory '%s': %s", tmp, strerror(errno));
+			free(tmp);
+			tmp = NULL;
+			return -1;
+		}
 		// add back components creating them as we go
 		for ( pos = tmp+strlen(tmp) ; pos < end ; pos = tmp+strlen(tmp) )
 		{
@@ -5158,6 +5170,24 @@ int GldLoader::schedule(PARSER)
 	DONE;
 }
 
+/** split_linkage_name
+	Split a linkage 'object:property' reference at the last ':'
+	@returns true on success, false if the reference is malformed
+ **/
+static bool split_linkage_name(const char *ref, char *obj, size_t objlen, char *prop, size_t proplen)
+{
+	const char *colon = strrchr(ref,':');
+	if ( colon == NULL || colon == ref || colon[1] == '\0' 
+		|| (size_t)(colon-ref) >= objlen || strlen(colon+1) >= proplen )
+	{
+		return false;
+	}
+	strncpy(obj,ref,colon-ref);
+	obj[colon-ref] = '\0';
+	strcpy(prop,colon+1);
+	return true;
+}
+
 int GldLoader::linkage_term(PARSER,::instance *inst)
 {
 	int startline = linenum;
@@ -5165,24 +5195,34 @@ int GldLoader::linkage_term(PARSER,::instance *inst)
 	char fromvar[64];
 	char toobj[64];
 	char tovar[64];
+	char from[128], to[128];
 	START;
 	if WHITE ACCEPT;
-	if ( TERM(name(HERE,fromobj,sizeof(fromobj))) && LITERAL(":") && TERM(name(HERE,fromvar,sizeof(fromvar)))
-		&& (WHITE,LITERAL("->")) && (WHITE,TERM(name(HERE,toobj,sizeof(toobj)))) && LITERAL(":") && TERM(name(HERE,tovar,sizeof(tovar)))
-		&& LITERAL(";"))
+	// object names may contain ':' so the property is split at the last ':'
+	if ( TERM(name(HERE,from,sizeof(from))) && (WHITE,LITERAL("->")) && (WHITE,TERM(name(HERE,to,sizeof(to)))) && LITERAL(";") )
 	{
-		if ( linkage_create_writer(inst,fromobj,fromvar,toobj,tovar) ) ACCEPT
+		if ( ! split_linkage_name(from,fromobj,sizeof(fromobj),fromvar,sizeof(fromvar))
+			|| ! split_linkage_name(to,toobj,sizeof(toobj),tovar,sizeof(tovar)) )
+		{
+			syntax_error(filename,startline,"linkage '%s -> %s' must be of the form 'object:property -> object:property'", from, to);
+			REJECT;
+		}
+		else if ( linkage_create_writer(inst,fromobj,fromvar,toobj,tovar) ) ACCEPT
 		else {
 			syntax_error(filename,startline,"linkage to write '%s:%s' to '%s:%s' is not valid", fromobj, fromvar, toobj, tovar);
 			REJECT;
 		}
 		DONE;
 	}
-	OR if ( TERM(name(HERE,toobj,sizeof(toobj))) && LITERAL(":") && TERM(name(HERE,tovar,sizeof(tovar)))
-		&& (WHITE,LITERAL("<-")) && (WHITE,TERM(name(HERE,fromobj,sizeof(fromobj)))) && LITERAL(":") && TERM(name(HERE,fromvar,sizeof(fromvar)))
-		&& LITERAL(";"))
+	OR if ( TERM(name(HERE,to,sizeof(to))) && (WHITE,LITERAL("<-")) && (WHITE,TERM(name(HERE,from,sizeof(from)))) && LITERAL(";") )
 	{
-		if ( linkage_create_reader(inst,fromobj,fromvar,toobj,tovar) ) ACCEPT
+		if ( ! split_linkage_name(from,fromobj,sizeof(fromobj),fromvar,sizeof(fromvar))
+			|| ! split_linkage_name(to,toobj,sizeof(toobj),tovar,sizeof(tovar)) )
+		{
+			syntax_error(filename,startline,"linkage '%s <- %s' must be of the form 'object:property <- object:property'", to, from);
+			REJECT;
+		}
+		else if ( linkage_create_reader(inst,fromobj,fromvar,toobj,tovar) ) ACCEPT
 		else {
 			syntax_error(filename,startline,"linkage to read '%s:%s' from '%s:%s' is not valid", fromobj, fromvar, toobj, tovar);
 			REJECT;
@@ -6555,8 +6595,10 @@ const char *GldLoader::for_replay(void)
 	{
 		output_verbose("forloop in var '%s' replay complete", forvar, forloop);
 		if ( forloop ) free(forloop);
+		forloop = NULL;
 		lastfor = NULL;
 		if ( forvar ) free(forvar);
+		forvar = NULL;
 		forvalue = NULL;
 		forbuffer.clear();
 		forbufferline = forbuffer.end();
@@ -8094,6 +8136,7 @@ STATUS GldLoader::loadall_glm(const char *fname) /**< a pointer to the first cha
 	}
 	IN_MYCONTEXT output_verbose("file '%s' is %d bytes long", file,fsize);
 	add_depend(filename,file);
+	import_prefetch(file);
 
 	/* removed malloc check since it doesn't malloc any more */
 	buffer[0] = '\0';
@@ -8192,8 +8235,95 @@ TECHNOLOGYREADINESSLEVEL GldLoader::calculate_trl(void)
 	return technology_readiness_level;
 }
 
-/** convert a non-GLM file to GLM, if possible */
-bool GldLoader::load_import(const char *from, char *to, int len)
+// 64-bit FNV-1a hashing used to address the #input cache
+#define IMPORT_HASH_PRIME 0x100000001b3ULL
+static void import_hash(uint64_t hash[2], const void *data, size_t len)
+{
+	const unsigned char *p = (const unsigned char*)data;
+	for ( size_t n = 0 ; n < len ; n++ )
+	{
+		hash[0] = (hash[0]^p[n]) * IMPORT_HASH_PRIME;
+		hash[1] = (hash[1]^p[n]) * IMPORT_HASH_PRIME;
+	}
+	// separate fields so that concatenations do not collide
+	unsigned char sep[sizeof(len)];
+	memcpy(sep,&len,sizeof(len));
+	for ( size_t n = 0 ; n < sizeof(sep) ; n++ )
+	{
+		hash[0] = (hash[0]^sep[n]) * IMPORT_HASH_PRIME;
+		hash[1] = (hash[1]^sep[n]) * IMPORT_HASH_PRIME;
+	}
+}
+static bool import_hash_file(uint64_t hash[2], const char *filename)
+{
+	FILE *fp = fopen(filename,"rb");
+	if ( fp == NULL )
+	{
+		return false;
+	}
+	char buffer[65536];
+	size_t len;
+	while ( (len=fread(buffer,1,sizeof(buffer),fp)) > 0 )
+	{
+		import_hash(hash,buffer,len);
+	}
+	bool ok = ! ferror(fp);
+	fclose(fp);
+	return ok;
+}
+static bool import_copy(const char *from, const char *to)
+{
+	FILE *in = fopen(from,"rb");
+	if ( in == NULL )
+	{
+		return false;
+	}
+	FILE *out = fopen(to,"wb");
+	if ( out == NULL )
+	{
+		fclose(in);
+		return false;
+	}
+	char buffer[65536];
+	size_t len;
+	bool ok = true;
+	while ( ok && (len=fread(buffer,1,sizeof(buffer),in)) > 0 )
+	{
+		ok = ( fwrite(buffer,1,len,out) == len );
+	}
+	ok = ok && ! ferror(in);
+	fclose(in);
+	return ( fclose(out) == 0 ) && ok;
+}
+static double import_clock(void)
+{
+	struct timeval now;
+	gettimeofday(&now,NULL);
+	return now.tv_sec + now.tv_usec*1e-6;
+}
+
+/* get the modification time and size of a file to convert, so that a prefetched
+   conversion is discarded when the file is changed (e.g., by a #system macro) */
+static void import_stat(const char *filename, int64 &mtime, int64 &size)
+{
+	struct stat info;
+	if ( stat(filename,&info) != 0 )
+	{
+		mtime = size = -1;
+		return;
+	}
+#if defined __APPLE__
+	mtime = (int64)info.st_mtimespec.tv_sec*1000000000 + info.st_mtimespec.tv_nsec;
+#elif defined WIN32
+	mtime = (int64)info.st_mtime*1000000000;
+#else
+	mtime = (int64)info.st_mtim.tv_sec*1000000000 + info.st_mtim.tv_nsec;
+#endif
+	size = (int64)info.st_size;
+}
+
+/** prepare the conversion of a non-GLM file to GLM */
+bool GldLoader::import_setup(const char *from, const char *load_options, IMPORTJOB &job)
 {
 	const char *ext = strrchr(from,'.');
 	if ( ext == NULL )
@@ -8206,60 +8336,321 @@ bool GldLoader::load_import(const char *from, char *to, int len)
 		ext++;
 	}
 	char converter_name[1024], converter_path[1024];
-	sprintf(converter_name,"%s2glm.py",ext);
+	snprintf(converter_name,sizeof(converter_name),"%s2glm.py",ext);
 	if ( find_file(converter_name, NULL, R_OK, converter_path, sizeof(converter_path)) == NULL )
 	{
 		output_error("load_import(from='%s',...): converter %s2glm.py not found", from, ext);
 		return false;
 	}
-	if ( strlen(from) >= (size_t)(len-1) )
-	{
-		output_error("load_import(from='%s',...): 'from' is too long to handle", from);
-		return false;
-	}
-	strcpy(to,from);
-	char *glmext = strrchr(to,'.');
-	if ( glmext == NULL )
-		strcat(to,".glm");
-	else
-		strcpy(glmext,".glm");
-	char load_options[1024] = "";
-	char load_options_var[64];
-	sprintf(load_options_var,"%s_load_options",ext);
-	global_getvar(load_options_var,load_options,sizeof(load_options));
-	char *unquoted = load_options;
-	if ( load_options[0] == '"' )
+	std::string to(from);
+	to.resize(to.rfind('.'));
+	to.append(".glm");
+	std::string options(load_options);
+	if ( options.size() > 0 && options[0] == '"' )
 	{
-		int len = strlen(load_options);
-		load_options[len-1] = '\0';
-		unquoted++;
+		options = options.substr(1,options.size()-2);
 	}
-	char *out = strncmp(unquoted,"-o ",3)==0 ? unquoted : strstr(unquoted," -o ");
+	const char *unquoted = options.c_str();
+	const char *out = strncmp(unquoted,"-o ",3)==0 ? unquoted : strstr(unquoted," -o ");
 	if ( out )
 	{	// copy user-specified output glm name
 		while ( isspace(out[0]) ) out++;
 		if ( strchr(out,' ') )
 		{
-			strcpy(to,strchr(out,' ')+1);
-			char *end = strchr(to,' ');
-			if ( end ) *end = '\0';
+			to = strchr(out,' ')+1;
+			to.resize(to.find(' ')==std::string::npos ? to.size() : to.find(' '));
 		}
 		else
 		{
 			output_warning("-o option filename missing");
 		}
-		output_verbose("changing output to '%s'", to);
+		output_verbose("changing output to '%s'", to.c_str());
 	}
-	int rc = my_instance->subcommand("%s %s -i %s -o %s %s",(const char*)global_pythonexec,converter_path,from,to,unquoted);
-	if ( rc != 0 )
+	job.from = from;
+	job.to = to;
+	job.options = options;
+	job.converter = converter_path;
+	job.cache = "";
+	job.pipes = NULL;
+	job.hit = false;
+	job.start = 0;
+	import_stat(from,job.mtime,job.size);
+
+	// the cache is addressed by the content of everything that determines the output
+	if ( strcmp(global_input_cache,"none") == 0 )
+	{
+		return true;
+	}
+	char cachedir[sizeof(global_tmp)+sizeof(global_input_cache)];
+	if ( strcmp(global_input_cache,"") == 0 )
+	{
+		snprintf(cachedir,sizeof(cachedir),"%s/input_cache",global_tmp);
+	}
+	else
+	{
+		snprintf(cachedir,sizeof(cachedir),"%s",(const char*)global_input_cache);
+	}
+	uint64_t hash[2] = {0xcbf29ce484222325ULL,0x84222325cbf29ce4ULL};
+	char version[1024];
+	snprintf(version,sizeof(version),"%d.%d.%d-%d-%s",global_version_major,global_version_minor,global_version_patch,global_version_build,global_version_branch);
+	import_hash(hash,version,strlen(version));
+	import_hash(hash,job.options.c_str(),job.options.size());
+	import_hash(hash,job.to.c_str(),job.to.size());
+	if ( ! import_hash_file(hash,converter_path) || ! import_hash_file(hash,from) )
 	{
-		output_error("%s: return code %d",converter_path,rc);
+		output_verbose("load_import(from='%s',...): unable to read input, conversion will not be cached", from);
+		return true;
+	}
+	if ( mkdirs(cachedir) != 0 )
+	{
+		output_warning("load_import(from='%s',...): unable to create input cache folder '%s', conversion will not be cached", from, cachedir);
+		/* TROUBLESHOOT
+			The folder given by the <code>input_cache</code> global variable, or the <code>input_cache</code>
+			folder in the <code>tmp</code> folder, could not be created.  The conversion is performed without
+			the cache.  Check the folder permissions, or set <code>input_cache</code> to <code>none</code>
+			to disable the cache.
+		 */
+		return true;
+	}
+	char cachefile[sizeof(cachedir)+40];
+	snprintf(cachefile,sizeof(cachefile),"%s/%016llx%016llx.glm",cachedir,(unsigned long long)hash[0],(unsigned long long)hash[1]);
+	job.cache = cachefile;
+	job.hit = ( access(cachefile,R_OK) == 0 );
+	return true;
+}
+
+/** start the conversion of a non-GLM file, unless the cache has it already */
+bool GldLoader::import_start(IMPORTJOB &job)
+{
+	job.start = import_clock();
+	if ( job.hit )
+	{
+		return true;
+	}
+	char *command = NULL;
+	if ( asprintf(&command,"%s %s -i %s -o %s %s",(const char*)global_pythonexec,job.converter.c_str(),job.from.c_str(),job.to.c_str(),job.options.c_str()) < 0 || command == NULL )
+	{
+		output_error("load_import(from='%s',...): memory allocation failed", job.from.c_str());
+		return false;
+	}
+	FILE *output = NULL, *error = NULL;
+	job.pipes = popens(command,NULL,&output,&error);
+	if ( job.pipes == NULL )
+	{
+		output_error("load_import(from='%s',...): unable to run command '%s' (%s)", job.from.c_str(), command, strerror(errno));
+		free(command);
 		return false;
 	}
-	output_verbose("GldLoader::load_import(from='%s', to='%s', len=%d) -> OK load_options='%s'",from,to,len,load_options);
+	output_verbose("running subcommand '%s'",command);
+	if ( global_echo )
+	{
+		fprintf(output_get_stream("output"),"# %s",command);
+	}
+	free(command);
 	return true;
 }
 
+/** complete the conversion of a non-GLM file and update the cache */
+bool GldLoader::import_finish(IMPORTJOB &job)
+{
+	bool ok = true;
+	if ( job.hit )
+	{
+		ok = import_copy(job.cache.c_str(),job.to.c_str());
+		if ( ! ok )
+		{
+			output_error("load_import(from='%s',...): unable to copy cached conversion '%s' to '%s' (%s)", job.from.c_str(), job.cache.c_str(), job.to.c_str(), strerror(errno));
+			/* TROUBLESHOOT
+				The cached copy of a converted #input file could not be copied to the output file.
+				Check that the output folder is writable, or set the <code>input_cache</code>
+				global variable to <code>none</code> to disable the cache.
+			 */
+		}
+		import_hits++;
+	}
+	else if ( job.pipes != NULL )
+	{
+		ppolls(job.pipes,NULL,output_get_stream("output"),output_get_stream("error"));
+		int rc = pcloses(job.pipes);
+		job.pipes = NULL;
+		if ( rc != 0 )
+		{
+			output_error("%s: return code %d",job.converter.c_str(),rc);
+			ok = false;
+		}
+		else if ( job.cache != "" )
+		{
+			// write to a temporary file so a concurrent run never sees a partial entry
+			char tmpfile[1024];
+			snprintf(tmpfile,sizeof(tmpfile),"%s.%d",job.cache.c_str(),getpid());
+			if ( ! import_copy(job.to.c_str(),tmpfile) || rename(tmpfile,job.cache.c_str()) != 0 )
+			{
+				output_warning("load_import(from='%s',...): unable to save conversion in input cache '%s' (%s)", job.from.c_str(), job.cache.c_str(), strerror(errno));
+				unlink(tmpfile);
+			}
+		}
+		import_misses++;
+	}
+	else
+	{
+		return false;
+	}
+	double dt = import_clock() - job.start;
+	import_time += dt;
+	output_verbose("load_import(from='%s',...): %s '%s' in %.3f s", job.from.c_str(), job.hit ? "cache hit, copied" : "cache miss, converted to", job.to.c_str(), dt);
+	return ok;
+}
+
+/** start the conversions of the #input directives in a file before it is parsed */
+void GldLoader::import_prefetch(const char *file)
+{
+	if ( ! global_input_prefetch )
+	{
+		return;
+	}
+	FILE *fp = fopen(file,"rt");
+	if ( fp == NULL )
+	{
+		return;
+	}
+	char line[1024];
+	int depth = 0;
+	while ( fgets(line,sizeof(line),fp) != NULL )
+	{
+		char *p = line;
+		while ( isspace(*p) ) p++;
+		if ( strncmp(p,"#if",3) == 0 )
+		{
+			depth++;
+		}
+		else if ( strncmp(p,"#endif",6) == 0 )
+		{
+			depth--;
+		}
+		// only directives that are certain to be reached and need no expansion
+		if ( depth != 0 || strncmp(p,"#input",6) != 0 || strstr(p,"${") != NULL )
+		{
+			continue;
+		}
+		char name[1024];
+		char options[1024] = "";
+		if ( sscanf(p+6,"%*[ \t]\"%[^\"]\"%*[ \t]%[^\n]",name,options) < 1 )
+		{
+			continue;
+		}
+		const char *ext = strrchr(name,'.');
+		if ( ext == NULL || strcmp(ext,".glm") == 0 || import_jobs.find(name) != import_jobs.end() || access(name,R_OK) != 0 )
+		{
+			continue;
+		}
+		char converter_name[1024], converter_path[1024];
+		snprintf(converter_name,sizeof(converter_name),"%s2glm.py",ext+1);
+		if ( find_file(converter_name, NULL, R_OK, converter_path, sizeof(converter_path)) == NULL )
+		{
+			continue;
+		}
+		if ( strcmp(options,"") == 0 )
+		{
+			char varname[1024];
+			snprintf(varname,sizeof(varname),"%s_load_options",ext+1);
+			if ( global_isdefined(varname) )
+			{
+				global_getvar(varname,options,sizeof(options));
+			}
+		}
+		IMPORTJOB *job = new IMPORTJOB;
+		bool conflict = false;
+		if ( import_setup(name,options,*job) )
+		{
+			for ( IMPORTJOBS::iterator item = import_jobs.begin() ; item != import_jobs.end() ; item++ )
+			{
+				conflict |= ( item->second->to == job->to );
+			}
+		}
+		if ( conflict || job->converter == "" || ! import_start(*job) )
+		{
+			delete job;
+			continue;
+		}
+		output_verbose("load_import(from='%s',...): prefetching conversion", name);
+		import_jobs[name] = job;
+	}
+	fclose(fp);
+}
+
+/** complete any prefetched conversions that were not used */
+void GldLoader::import_cleanup(void)
+{
+	for ( IMPORTJOBS::iterator item = import_jobs.begin() ; item != import_jobs.end() ; item++ )
+	{
+		IMPORTJOB *job = item->second;
+		if ( job->pipes != NULL )
+		{
+			ppolls(job->pipes,(FILE*)NULL,(FILE*)NULL,(FILE*)NULL);
+			pcloses(job->pipes);
+		}
+		delete job;
+	}
+	import_jobs.clear();
+}
+
+/** convert a non-GLM file to GLM, if possible */
+bool GldLoader::load_import(const char *from, char *to, int len)
+{
+	const char *ext = strrchr(from,'.');
+	if ( ext == NULL )
+	{
+		output_error("load_import(from='%s',...): invalid extension", from);
+		return false;
+	}
+	char load_options[1024] = "";
+	char load_options_var[64];
+	snprintf(load_options_var,sizeof(load_options_var),"%s_load_options",ext+1);
+	global_getvar(load_options_var,load_options,sizeof(load_options));
+	IMPORTJOB job;
+	if ( ! import_setup(from,load_options,job) )
+	{
+		return false;
+	}
+	if ( job.to.size() >= (size_t)(len-1) )
+	{
+		output_error("load_import(from='%s',...): 'to' is too long to handle", from);
+		return false;
+	}
+	strcpy(to,job.to.c_str());
+
+	// use the prefetched conversion only if nothing changed since it was started
+	IMPORTJOBS::iterator item = import_jobs.find(from);
+	bool ok;
+	if ( item != import_jobs.end() && item->second->options == job.options && item->second->converter == job.converter && item->second->to == job.to && item->second->cache == job.cache
+		&& item->second->mtime == job.mtime && item->second->size == job.size && job.mtime >= 0 )
+	{
+		ok = import_finish(*(item->second));
+		delete item->second;
+		import_jobs.erase(item);
+	}
+	else
+	{
+		if ( item != import_jobs.end() )
+		{
+			output_verbose("load_import(from='%s',...): input or options changed since prefetch, converting again", from);
+			if ( item->second->pipes != NULL )
+			{
+				ppolls(item->second->pipes,(FILE*)NULL,(FILE*)NULL,(FILE*)NULL);
+				pcloses(item->second->pipes);
+			}
+			delete item->second;
+			import_jobs.erase(item);
+		}
+		ok = import_start(job) && import_finish(job);
+	}
+	if ( ok )
+	{
+		output_verbose("GldLoader::load_import(from='%s', to='%s', len=%d) -> OK load_options='%s'",from,to,len,load_options);
+	}
+	return ok;
+}
+
 STATUS GldLoader::load_python(const char *filename)
 {
 	extern PyObject *gridlabd_module;
@@ -8408,6 +8799,12 @@ STATUS GldLoader::loadall(const char *fname)
 			}
 		}
 
+		import_cleanup();
+		if ( import_hits+import_misses > 0 )
+		{
+			IN_MYCONTEXT output_verbose("%u #input conversion%s completed (%u from input cache, %.3f s total conversion time)", import_hits+import_misses, import_hits+import_misses>1?"s":"", import_hits, import_time);
+		}
+
 		calculate_trl();
 
 		loaded_files++;
@@ -122,6 +122,24 @@ private:
 		struct s_include_list *next;
 	} INCLUDELIST;
 
+	// used for tracking #input conversions, which may be started before the
+	// #input directive is parsed and may be satisfied from the input cache
+	typedef struct s_importjob
+	{
+		std::string from; // file to convert
+		std::string to; // converted glm file
+		std::string options; // converter options
+		std::string converter; // converter path
+		std::string cache; // cached copy of the converted file ("" if not cached)
+		struct s_pipes *pipes; // converter process (NULL if not running)
+		bool hit; // the cached copy is valid
+		double start; // time at which the conversion was started
+		int64 mtime; // modification time of the file to convert (ns, -1 if unknown)
+		int64 size; // size of the file to convert (-1 if unknown)
+	} IMPORTJOB;
+
+	typedef std::map<std::string,IMPORTJOB*> IMPORTJOBS;
+
 	typedef int (*PARSERCALL)(PARSER);
 
 	typedef struct s_loaderhook 
@@ -182,6 +200,11 @@ private:
 	// unsigned int object_index_size;
 	INDEXMAP indexmap;
 
+	IMPORTJOBS import_jobs;
+	unsigned int import_hits;
+	unsigned int import_misses;
+	double import_time;
+
 	UNRESOLVED *first_unresolved;
 
 	OBJECT *current_object;
@@ -372,6 +395,11 @@ private:
 	STATUS loadall_glm(const char *file);
 	TECHNOLOGYREADINESSLEVEL calculate_trl(void);
 	bool load_import(const char *from, char *to, int len);
+	bool import_setup(const char *from, const char *load_options, IMPORTJOB &job);
+	bool import_start(IMPORTJOB &job);
+	bool import_finish(IMPORTJOB &job);
+	void import_prefetch(const char *file);
+	void import_cleanup(void);
 	STATUS load_python(const char *filename);
 	STATUS loadall(const char *fname);
 	void add_depend(const char *filename, const char *dependency);
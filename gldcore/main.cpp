@@ -195,6 +195,7 @@ GldMain::~GldMain(void)
 
 	// TODO: add general destruction calls
 	object_destroy_all();
+	intern_free();
 
 	// TODO: remove this when reetrant code is done
 	my_instance = NULL;
@@ -358,6 +359,10 @@ int GldMain::run_on_exit(int return_code)
 		class_profiles();
 		module_profiles();
 	}
+	if ( global_memory_report )
+	{
+		heap_report("exit");
+	}
 
 #ifdef DUMP_SCHEDULES
 	/* dump a copy of the schedules for reference */
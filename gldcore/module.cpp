@@ -240,6 +240,10 @@ static CALLBACKS callbacks = {
 	{version_major,version_minor,version_patch,version_build,version_branch},
 	call_external_callback,
 	{python_embed_import,python_embed_call},
+	{intern_get},
+	{object_bind_property,object_gather,object_scatter,object_probe_property},
+	{delta_region_held,delta_region_report,delta_region_timestep},
+	{heap_account,heap_add,heap_remove,heap_set},
 	MAGIC /* used to check structure */
 };
 CALLBACKS *module_callbacks(void) { return &callbacks; }
@@ -565,6 +569,7 @@ MODULE *module_load(const char *file, /**< module filename, searches \p PATH */
 			{&c->recalc,"recalc",TRUE},
 			{&c->update,"update",TRUE},
 			{&c->heartbeat,"heartbeat",TRUE},
+			{&c->syncbatch,"syncbatch",TRUE},
 		};
 		for ( size_t i = 0 ; i < sizeof(map)/sizeof(map[0]) ; i++ )
 		{
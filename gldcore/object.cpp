@@ -52,6 +52,29 @@ static OBJECT *last_object = NULL;
 static OBJECTNUM object_array_size = 0;
 static OBJECT **object_array = NULL;
 
+/* object being synchronized or committed by this thread (only tracked when property_lookup_check is enabled) */
+static thread_local OBJECT *sync_object = NULL;
+
+/* find a property by name, reporting lookups made by objects during sync when property_lookup_check is enabled */
+static PROPERTY *find_property_by_name(OBJECT *obj, PROPERTYNAME name)
+{
+	PROPERTY *prop = class_find_property(obj->oclass,name);
+	if ( sync_object != NULL && prop != NULL && (prop->flags&PF_NAMELOOKUP) == 0 )
+	{
+		prop->flags |= PF_NAMELOOKUP;
+		output_warning("%s:%d looked up property '%s' of class '%s' by name during sync", 
+			sync_object->oclass->name, sync_object->id, name, obj->oclass->name);
+		/* TROUBLESHOOT
+			The property_lookup_check global is enabled and an object's sync function 
+			looked up a property by name. Name lookups are slow compared to the sync
+			itself, so the module should bind the property once during init using
+			object_bind_property() (gld_binding in modules) and use the binding instead.
+			Each property is reported only once.
+		 */
+	}
+	return prop;
+}
+
 /* {name, val, next} */
 KEYWORD oflags[] = {
 	/* "name", value, next */
@@ -384,7 +407,7 @@ PROPERTY *object_get_property(OBJECT *obj, /**< a pointer to the object */
 	} else {
 		char *part;
 		char root[1024];
-		PROPERTY *prop = class_find_property(obj->oclass, name);
+		PROPERTY *prop = find_property_by_name(obj,name);
 		PROPERTYSPEC *spec;
 		if ( pstruct ) { pstruct->prop=prop; pstruct->part = ""; }
 		if ( prop ) return prop;
@@ -626,6 +649,7 @@ OBJECT *object_create_single(CLASS *oclass) /**< the class of the object */
 	
 	last_object = obj;
 	oclass->profiler.numobjs++;
+	heap_add(heap_class_account(oclass),sz+oclass->size);
 	
 	return obj;
 }
@@ -753,6 +777,7 @@ OBJECT *object_remove_by_id(OBJECTNUM id){
 		next = target->next;
 		prev->next = next;
 		target->oclass->profiler.numobjs--;
+		heap_remove(heap_class_account(target->oclass),sizeof(OBJECT)+target->oclass->size);
 		free(target);
 		target = NULL;
 		deleted_object_count++;
@@ -770,7 +795,7 @@ void *object_get_addr(OBJECT *obj, /**< object to look in */
 	if(obj == NULL)
 		return NULL;
 
-	prop = class_find_property(obj->oclass,name);
+	prop = find_property_by_name(obj,name);
 	
 	if(prop != NULL && prop->access != PA_PRIVATE){
 		return (void *)((char *)(obj + 1) + (int64)(prop->addr)); /* warning: cast from pointer to integer of different size */
@@ -797,7 +822,7 @@ OBJECT **object_get_object(OBJECT *obj, PROPERTY *prop)
 
 OBJECT **object_get_object_by_name(OBJECT *obj, const char *name)
 {
-	PROPERTY *prop = class_find_property(obj->oclass, name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 	
 	if(prop != NULL && prop->access != PA_PRIVATE && prop->ptype == PT_object){
 		return (OBJECT **)((char *)obj + sizeof(OBJECT) + (int64)(prop->addr)); /* warning: cast from pointer to integer of different size */
@@ -817,7 +842,7 @@ bool *object_get_bool(OBJECT *obj, PROPERTY *prop)
 
 bool *object_get_bool_by_name(OBJECT *obj, const char *name)
 {
-	PROPERTY *prop = class_find_property(obj->oclass,name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 	if(prop!=NULL && prop->access != PA_PRIVATE)
 		return (bool *)((char*)obj+sizeof(OBJECT)+(int64)(prop->addr)); /* warning: cast from pointer to integer of different size */
 	errno = ENOENT;
@@ -833,7 +858,7 @@ enumeration *object_get_enum(OBJECT *obj, PROPERTY *prop){
 }
 
 enumeration *object_get_enum_by_name(OBJECT *obj, const char *name){
-	PROPERTY *prop = class_find_property(obj->oclass, name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 
 	if(prop != NULL && prop->access != PA_PRIVATE){
 		return (enumeration *)((char *)(obj) + sizeof(OBJECT) + (int64)(prop->addr));
@@ -853,7 +878,7 @@ set *object_get_set(OBJECT *obj, PROPERTY *prop){
 }
 
 set *object_get_set_by_name(OBJECT *obj, const char *name){
-	PROPERTY *prop = class_find_property(obj->oclass, name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 
 	if(prop != NULL && prop->access != PA_PRIVATE){
 		return (set *)((char *)(obj) + sizeof(OBJECT) + (int64)(prop->addr));
@@ -878,7 +903,7 @@ int16 *object_get_int16(OBJECT *obj, PROPERTY *prop)
 
 int16 *object_get_int16_by_name(OBJECT *obj, const char *name)
 {
-	PROPERTY *prop = class_find_property(obj->oclass, name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 	
 	if(prop != NULL && prop->access != PA_PRIVATE){
 		return (int16 *)((char *)obj + sizeof(OBJECT) + (int64)(prop->addr)); /* warning: cast from pointer to integer of different size */
@@ -903,7 +928,7 @@ int32 *object_get_int32(OBJECT *obj, PROPERTY *prop)
 
 int32 *object_get_int32_by_name(OBJECT *obj, const char *name)
 {
-	PROPERTY *prop = class_find_property(obj->oclass,name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 	if(prop!=NULL && prop->access != PA_PRIVATE)
 		return (int32 *)((char*)obj+sizeof(OBJECT)+(int64)(prop->addr)); /* warning: cast from pointer to integer of different size */
 	errno = ENOENT;
@@ -925,7 +950,7 @@ int64 *object_get_int64(OBJECT *obj, PROPERTY *prop)
 
 int64 *object_get_int64_by_name(OBJECT *obj, const char *name)
 {
-	PROPERTY *prop = class_find_property(obj->oclass,name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 	if(prop!=NULL && prop->access != PA_PRIVATE)
 		return (int64 *)((char*)obj+sizeof(OBJECT)+(int64)(prop->addr)); /* warning: cast from pointer to integer of different size */
 	errno = ENOENT;
@@ -950,7 +975,7 @@ double *object_get_double(OBJECT *obj, PROPERTY *prop)
 
 double *object_get_double_by_name(OBJECT *obj, const char *name)
 {
-	PROPERTY *prop = class_find_property(obj->oclass,name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 	if(prop!=NULL && prop->access != PA_PRIVATE)
 		return (double *)((char*)obj+sizeof(OBJECT)+(int64)(prop->addr)); /* warning: cast from pointer to integer of different size */
 	errno = ENOENT;
@@ -975,7 +1000,7 @@ complex *object_get_complex(OBJECT *obj, PROPERTY *prop)
 
 complex *object_get_complex_by_name(OBJECT *obj, const char *name)
 {
-	PROPERTY *prop = class_find_property(obj->oclass,name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 	if(prop!=NULL && prop->access != PA_PRIVATE)
 		return (complex *)((char*)obj+sizeof(OBJECT)+(int64)(prop->addr)); /* warning: cast from pointer to integer of different size */
 	errno = ENOENT;
@@ -985,6 +1010,11 @@ complex *object_get_complex_by_name(OBJECT *obj, const char *name)
 const char *object_get_string(OBJECT *obj, PROPERTY *prop){
 	if(object_prop_in_class(obj, prop) && prop->ptype >= PT_char8 && prop->ptype <= PT_char1024 && prop->access != PA_PRIVATE)
 		return (char *)((char*)obj+sizeof(OBJECT)+(int64)(prop->addr)); /* warning: cast from pointer to integer of different size */
+	if(object_prop_in_class(obj, prop) && prop->ptype == PT_intern && prop->access != PA_PRIVATE)
+	{
+		INTERN ref = *(INTERN*)((char*)obj+sizeof(OBJECT)+(int64)(prop->addr));
+		return ref ? ref->value : "";
+	}
 	errno = ENOENT;
 	return NULL;
 }
@@ -994,13 +1024,169 @@ const char *object_get_string(OBJECT *obj, PROPERTY *prop){
  */
 const char *object_get_string_by_name(OBJECT *obj, const char *name)
 {
-	PROPERTY *prop = class_find_property(obj->oclass,name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 	if(prop!=NULL && prop->access != PA_PRIVATE)
 		return ((char*)obj+sizeof(OBJECT)+(int64)(prop->addr)); /* warning: cast from pointer to integer of different size */
 	errno = ENOENT;
 	return NULL;
 }
 
+/* Pre-bound property access
+ *
+ * Modules that read or write the same property of many objects can bind the
+ * (class,property) pair once, usually in init, and then use the binding to 
+ * access the value directly or to gather/scatter the values of many objects
+ * at once.  The name lookup and type check are done only when binding.
+ */
+static PROPERTYBINDING *first_binding = NULL;
+static LOCKVAR binding_lock = 0;
+
+/* find or make the binding of a property that has already been checked */
+static PROPERTYBINDING *object_get_binding(CLASS *oclass, PROPERTY *prop)
+{
+	PROPERTYBINDING *binding;
+
+	/* reuse an existing binding if any */
+	wlock(&binding_lock);
+	for ( binding = first_binding ; binding != NULL ; binding = binding->next )
+	{
+		if ( binding->oclass == oclass && binding->prop == prop )
+		{
+			wunlock(&binding_lock);
+			return binding;
+		}
+	}
+	binding = (PROPERTYBINDING*)malloc(sizeof(PROPERTYBINDING));
+	if ( binding == NULL )
+	{
+		wunlock(&binding_lock);
+		output_error("object_bind_property(oclass='%s', name='%s'): memory allocation failed", oclass->name, prop->name);
+		return NULL;
+	}
+	binding->oclass = oclass;
+	binding->prop = prop;
+	binding->offset = (size_t)(prop->addr);
+	binding->size = property_size(prop);
+	binding->next = first_binding;
+	first_binding = binding;
+	wunlock(&binding_lock);
+	IN_MYCONTEXT output_debug("object_bind_property(oclass='%s', name='%s'): bound at offset %d", oclass->name, prop->name, (int)binding->offset);
+	return binding;
+}
+
+/** Bind a property of a class for direct access
+	@return a pointer to the binding, or NULL if the property is not found or is not of the type expected
+ **/
+PROPERTYBINDING *object_bind_property(CLASS *oclass, /**< the class of the objects that will be accessed */
+									  PROPERTYNAME name, /**< the name of the property */
+									  PROPERTYTYPE ptype) /**< the type expected (PT_void accepts any type) */
+{
+	PROPERTY *prop;
+	if ( oclass == NULL )
+	{
+		output_error("object_bind_property(oclass=NULL, name='%s', ptype=%d): class not specified", name, ptype);
+		return NULL;
+	}
+	prop = class_find_property(oclass,name);
+	if ( prop == NULL || prop->access == PA_PRIVATE )
+	{
+		output_error("object_bind_property(oclass='%s', name='%s', ptype=%d): property not found", oclass->name, name, ptype);
+		/* TROUBLESHOOT
+			A module attempted to bind a property that the class does not publish.  
+			This is usually a problem with the module that requested the binding, or a
+			model that uses an object of an unexpected class.
+		 */
+		return NULL;
+	}
+	if ( ptype != PT_void && prop->ptype != ptype )
+	{
+		output_error("object_bind_property(oclass='%s', name='%s', ptype=%d): property type is %s but %s was expected", 
+			oclass->name, name, ptype, class_get_property_typename(prop->ptype), class_get_property_typename(ptype));
+		/* TROUBLESHOOT
+			A module attempted to bind a property using a type that does not match the type 
+			of the property published by the class.  This is a problem with the module that 
+			requested the binding.
+		 */
+		return NULL;
+	}
+	return object_get_binding(oclass,prop);
+}
+
+/** Bind a property of a class that may not exist
+	Unlike object_bind_property(), a missing property or a type mismatch is
+	not reported, so modules can check for optional properties.
+	@return a pointer to the binding, or NULL if the property is not found or is not of the type expected
+ **/
+PROPERTYBINDING *object_probe_property(CLASS *oclass, /**< the class of the objects that will be accessed */
+									   PROPERTYNAME name, /**< the name of the property */
+									   PROPERTYTYPE ptype) /**< the type expected (PT_void accepts any type) */
+{
+	PROPERTY *prop = ( oclass != NULL ? class_find_property(oclass,name) : NULL );
+	if ( prop == NULL || prop->access == PA_PRIVATE || ( ptype != PT_void && prop->ptype != ptype ) )
+	{
+		return NULL;
+	}
+	return object_get_binding(oclass,prop);
+}
+
+/* check that the object can be accessed through the binding */
+static inline bool object_check_binding(PROPERTYBINDING *binding, OBJECT *obj, const char *caller)
+{
+	if ( obj != NULL && ( obj->oclass == binding->oclass || object_prop_in_class(obj,binding->prop) != NULL ) )
+	{
+		return true;
+	}
+	output_error("%s(binding='%s.%s'): object %s:%d does not have the bound property", caller, 
+		binding->oclass->name, binding->prop->name, obj?obj->oclass->name:"(null)", obj?obj->id:-1);
+	/* TROUBLESHOOT
+		A module attempted to access a property through a binding that was made
+		for a different class of object.  This is a problem with the module.
+	 */
+	return false;
+}
+
+/** Copy the value of a bound property from many objects into an array
+	@return the number of values copied, which is less than count if an object does not have the property
+ **/
+size_t object_gather(PROPERTYBINDING *binding, /**< the binding of the property */
+					 OBJECT **objs, /**< the objects to read */
+					 size_t count, /**< the number of objects */
+					 void *values) /**< the array of count values to fill */
+{
+	char *to = (char*)values;
+	size_t n;
+	for ( n = 0 ; n < count ; n++, to += binding->size )
+	{
+		if ( ! object_check_binding(binding,objs[n],"object_gather") )
+		{
+			break;
+		}
+		memcpy(to,BINDADDR(objs[n],binding),binding->size);
+	}
+	return n;
+}
+
+/** Copy an array of values into the bound property of many objects
+	@return the number of values copied, which is less than count if an object does not have the property
+ **/
+size_t object_scatter(PROPERTYBINDING *binding, /**< the binding of the property */
+					  OBJECT **objs, /**< the objects to write */
+					  size_t count, /**< the number of objects */
+					  const void *values) /**< the array of count values to copy */
+{
+	const char *from = (const char*)values;
+	size_t n;
+	for ( n = 0 ; n < count ; n++, from += binding->size )
+	{
+		if ( ! object_check_binding(binding,objs[n],"object_scatter") )
+		{
+			break;
+		}
+		memcpy(BINDADDR(objs[n],binding),from,binding->size);
+	}
+	return n;
+}
+
 /* this function finds the property associated with the addr of an object member */
 static PROPERTY *get_property_at_addr(OBJECT *obj, void *addr)
 {
@@ -1411,7 +1597,7 @@ int object_set_value_by_name(OBJECT *obj, /**< the object to change */
 							 const char *value) /**< the value to set */
 {
 	void *addr;
-	PROPERTY *prop = class_find_property(obj->oclass,name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 	if(prop==NULL)
 	{
 		if(set_header_value(obj,name,value)==FAILED)
@@ -1441,7 +1627,7 @@ int object_set_value_by_name(OBJECT *obj, /**< the object to change */
  */
 int object_set_int16_by_name(OBJECT *obj, PROPERTYNAME name, int16 value)
 {
-	PROPERTY *prop = class_find_property(obj->oclass,name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 	if(prop==NULL)
 	{
 		errno = ENOENT;
@@ -1469,7 +1655,7 @@ int object_set_int16_by_name(OBJECT *obj, PROPERTYNAME name, int16 value)
  */
 int object_set_int32_by_name(OBJECT *obj, PROPERTYNAME name, int32 value)
 {
-	PROPERTY *prop = class_find_property(obj->oclass,name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 	if(prop==NULL)
 	{
 		errno = ENOENT;
@@ -1490,7 +1676,7 @@ int object_set_int32_by_name(OBJECT *obj, PROPERTYNAME name, int32 value)
  */
 int object_set_int64_by_name(OBJECT *obj, PROPERTYNAME name, int64 value)
 {
-	PROPERTY *prop = class_find_property(obj->oclass,name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 	if(prop==NULL)
 	{
 		errno = ENOENT;
@@ -1511,7 +1697,7 @@ int object_set_int64_by_name(OBJECT *obj, PROPERTYNAME name, int64 value)
  */
 int object_set_double_by_name(OBJECT *obj, PROPERTYNAME name, double value)
 {
-	PROPERTY *prop = class_find_property(obj->oclass,name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 	if(prop==NULL)
 	{
 		errno = ENOENT;
@@ -1532,7 +1718,7 @@ int object_set_double_by_name(OBJECT *obj, PROPERTYNAME name, double value)
  */
 int object_set_complex_by_name(OBJECT *obj, PROPERTYNAME name, complex value)
 {
-	PROPERTY *prop = class_find_property(obj->oclass,name);
+	PROPERTY *prop = find_property_by_name(obj,name);
 	if(prop==NULL)
 	{
 		errno = ENOENT;
@@ -1927,7 +2113,9 @@ TIMESTAMP _object_sync(OBJECT *obj, /**< the object to synchronize */
 
 	/* call sync */
 	if (autolock) wlock(&obj->lock);
+	if ( global_property_lookup_check ) sync_object = obj;
 	sync_time = (*obj->oclass->sync)(obj,ts,pass);
+	sync_object = NULL;
 	if (autolock) wunlock(&obj->lock);
 	if(absolute_timestamp(plc_time)<absolute_timestamp(sync_time))
 		sync_time = plc_time;
@@ -2055,6 +2243,91 @@ TIMESTAMP object_sync(OBJECT *obj, /**< the object to synchronize */
 	return t2;
 }
 
+/** Determine whether an object can be synchronized using its class batch sync function.
+
+	An object qualifies only when object_sync() would reduce to a single call
+	to the class sync function, i.e., it is in service, it has no recalc, plc,
+	skipsafe, or event handler processing to do, and its valid_to
+	horizon does not precede the sync time.  Profiling, debug output, and
+	property lookup checking also require the per-object path.
+
+	@return true if the object can be passed to object_sync_batch()
+ */
+bool object_sync_batchable(OBJECT *obj, /**< the object to check */
+						   TIMESTAMP ts, /**< the clock to sync to */
+						   PASSCONFIG pass) /**< the pass configuration */
+{
+	CLASS *oclass = obj->oclass;
+	if ( oclass->syncbatch == NULL )
+		return false;
+	if ( global_profiler || global_debug_output || global_property_lookup_check || ts != global_clock )
+		return false;
+	if ( ts < obj->in_svc || ( ts == obj->in_svc && obj->in_svc_micro != 0 ) || ts > obj->out_svc )
+		return false;
+	if ( global_skipsafe > 0 && (obj->flags&OF_SKIPSAFE) )
+		return false;
+	if ( (obj->flags&OF_RECALC) && oclass->recalc != NULL )
+		return false;
+	if ( pass == PC_BOTTOMUP && oclass->plc != NULL && !(obj->flags&OF_HASPLC) )
+		return false;
+	if ( obj->valid_to > 0 && obj->valid_to < ts )
+		return false;
+	switch ( pass )
+	{
+	case PC_PRETOPDOWN: return obj->events.presync == NULL;
+	case PC_BOTTOMUP: return obj->events.sync == NULL;
+	case PC_POSTTOPDOWN: return obj->events.postsync == NULL;
+	default: return false;
+	}
+}
+
+/** Synchronize a batch of objects of the same class using the class batch sync function.
+
+	All the objects must satisfy object_sync_batchable().  The next time of
+	each object is stored in t2 and its valid_to horizon is updated as
+	object_sync() would.  The class batch sync function takes the object
+	locks itself when the class uses PC_AUTOLOCK.  If the class fails on an object, that object's
+	next time is TS_INVALID and the objects after it are not synchronized.
+
+	@return the number of objects processed, including the failed object if any
+ */
+unsigned int object_sync_batch(OBJECT **obj, /**< the objects to synchronize */
+							   unsigned int n, /**< the number of objects */
+							   TIMESTAMP ts, /**< the clock to sync to */
+							   PASSCONFIG pass, /**< the pass configuration */
+							   TIMESTAMP *t2) /**< the next times of the objects (output) */
+{
+	typedef unsigned int (*SYNCBATCH)(OBJECT**,unsigned int,TIMESTAMP,PASSCONFIG,TIMESTAMP*);
+	SYNCBATCH syncbatch = (SYNCBATCH)(obj[0]->oclass->syncbatch);
+	unsigned int m, k;
+
+#ifndef WIN32
+	/* setup lockup alarm */
+	alarm(global_maximum_synctime);
+#endif
+
+	m = (*syncbatch)(obj,n,ts,pass,t2);
+
+#ifndef WIN32
+	/* clear lockup alarm */
+	alarm(0);
+#endif
+
+	if ( m < n )
+	{
+		/* failed object is reported as TS_INVALID like object_sync() does */
+		t2[m++] = TS_INVALID;
+	}
+	for ( k = 0 ; k < m ; k++ )
+	{
+		/* compute valid_to time */
+		if ( t2[k] > TS_MAX )
+			t2[k] = TS_NEVER;
+		obj[k]->valid_to = t2[k];
+	}
+	return m;
+}
+
 TIMESTAMP object_heartbeat(OBJECT *obj)
 {
 	clock_t t = (clock_t)exec_clock();
@@ -2117,7 +2390,9 @@ STATUS object_precommit(OBJECT *obj, TIMESTAMP t1)
 	}
 	if ( obj->oclass->precommit != NULL )
 	{
+		if ( global_property_lookup_check ) sync_object = obj;
 		rv = (STATUS)(*(obj->oclass->precommit))(obj, t1);
+		sync_object = NULL;
 	}
 	if ( rv == 1 )
 	{ 
@@ -2152,7 +2427,9 @@ TIMESTAMP object_commit(OBJECT *obj, TIMESTAMP t1, TIMESTAMP t2)
 	}
 	if ( obj->oclass->commit != NULL )
 	{
+		if ( global_property_lookup_check ) sync_object = obj;
 		rv = (TIMESTAMP)(*(obj->oclass->commit))(obj, t1, t2);
+		sync_object = NULL;
 	}
 	if ( rv == 1 )
 	{ 
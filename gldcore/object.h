@@ -24,6 +24,7 @@
 #include "schedule.h"
 #include "transform.h"
 #include "enduse.h"
+#include "heap.h"
 
 /* this must match property_type list in object.c */
 typedef unsigned int OBJECTRANK; /**< Object rank number */
@@ -128,6 +129,15 @@ typedef struct s_object_list {
 	unsigned long long flags; /**< object flags */
 } OBJECT; /**< Object header structure */
 
+/* pre-bound property access (see object_bind_property) */
+typedef struct s_propertybinding {
+	CLASS *oclass; /**< class for which the property was bound */
+	PROPERTY *prop; /**< the bound property */
+	size_t offset; /**< offset of the value from the start of the object data */
+	size_t size; /**< size of the value in bytes */
+	struct s_propertybinding *next; /**< next binding made */
+} PROPERTYBINDING; /**< Property binding structure */
+
 /* this is the callback table for modules
  * the table is initialized in module.cpp
  */
@@ -368,6 +378,26 @@ typedef struct s_callbacks {
 		PyObject *(*import)(const char *module, const char *path);
 		bool (*call)(PyObject *pModule, const char *method, const char *vargsfmt, va_list varargs, void *result);
 	} python;
+	struct {
+		INTERNSTRING *(*get)(const char *value);
+	} intern;
+	struct {
+		PROPERTYBINDING *(*bind)(CLASS *oclass, PROPERTYNAME name, PROPERTYTYPE ptype);
+		size_t (*gather)(PROPERTYBINDING *binding, OBJECT **objs, size_t count, void *values);
+		size_t (*scatter)(PROPERTYBINDING *binding, OBJECT **objs, size_t count, const void *values);
+		PROPERTYBINDING *(*probe)(CLASS *oclass, PROPERTYNAME name, PROPERTYTYPE ptype);
+	} binding;
+	struct {
+		bool (*is_held)(OBJECT *obj);
+		void (*report)(OBJECT *obj, SIMULATIONMODE mode);
+		DT (*timestep)(OBJECT *obj, DT timestep);
+	} deltaregion;
+	struct {
+		HEAPACCOUNT *(*account)(HEAPACCOUNTTYPE type, const char *owner, const char *name, int64 instance);
+		void (*add)(HEAPACCOUNT *account, int64 size);
+		void (*remove)(HEAPACCOUNT *account, int64 size);
+		void (*set)(HEAPACCOUNT *account, int64 count, int64 size);
+	} heap;
 	long unsigned int magic; /* used to check structure alignment */
 } CALLBACKS; /**< core callback function table */
 
@@ -412,6 +442,8 @@ int object_property_getsize(OBJECT *obj, PROPERTY *prop);
 int object_get_oflags(KEYWORD **extflags);
 
 TIMESTAMP object_sync(OBJECT *obj, TIMESTAMP to,PASSCONFIG pass);
+bool object_sync_batchable(OBJECT *obj, TIMESTAMP ts, PASSCONFIG pass);
+unsigned int object_sync_batch(OBJECT **obj, unsigned int n, TIMESTAMP ts, PASSCONFIG pass, TIMESTAMP *t2);
 OBJECT **object_get_object(OBJECT *obj, PROPERTY *prop);
 OBJECT **object_get_object_by_name(OBJECT *obj, const char *name);
 enumeration *object_get_enum(OBJECT *obj, PROPERTY *prop);
@@ -432,6 +464,10 @@ double *object_get_double_quick(OBJECT *pObj, PROPERTY *prop);
 complex *object_get_complex_quick(OBJECT *pObj, PROPERTY *prop);
 const char *object_get_string(OBJECT *pObj, PROPERTY *prop);
 const char *object_get_string_by_name(OBJECT *obj, const char *name);
+PROPERTYBINDING *object_bind_property(CLASS *oclass, PROPERTYNAME name, PROPERTYTYPE ptype);
+PROPERTYBINDING *object_probe_property(CLASS *oclass, PROPERTYNAME name, PROPERTYTYPE ptype);
+size_t object_gather(PROPERTYBINDING *binding, OBJECT **objs, size_t count, void *values);
+size_t object_scatter(PROPERTYBINDING *binding, OBJECT **objs, size_t count, const void *values);
 FUNCTIONADDR object_get_function(CLASSNAME classname, FUNCTIONNAME functionname);
 const char *object_property_to_string(OBJECT *obj, const char *name, char *buffer, int sz);
 const char *object_property_to_string_x(OBJECT *obj, PROPERTY *prop, char *buffer, int sz);
@@ -514,6 +550,7 @@ const char* object_get_header_string(OBJECT *obj, const char *item, char *buffer
 
 #define OBJECTDATA(X,T) ((T*)((X)?((X)+1):NULL)) /**< get the object data structure */
 #define GETADDR(O,P) ((O)?((void*)((char*)((O)+1)+(unsigned int64)((P)->addr))):NULL) /**< get the addr of an object's property */
+#define BINDADDR(O,B) ((void*)((char*)((O)+1)+(B)->offset)) /**< get the addr of an object's bound property (no checks) */
 #define OBJECTHDR(X) ((X)?(((OBJECT*)X)-1):NULL) /**< get the header from the object's data structure */
 #define THISOBJECTHDR (((OBJECT*)this)-1)
 
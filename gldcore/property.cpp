@@ -44,6 +44,7 @@ PROPERTYSPEC property_type[_PT_LAST] = {
 	{"method","string", NULL, 0, PSZ_DYNAMIC, convert_from_method,convert_to_method,initial_from_method},
 	{"string", "string", "", sizeof(STRING), PSZ_AUTO, convert_from_string, convert_to_string, NULL,string_create,NULL,convert_to_string,{TCOPS(string)},},
 	{"python", "string", "None", sizeof(PyObject**), PSZ_DYNAMIC, convert_from_python, convert_to_python, initial_from_python, python_create,NULL,convert_to_python,{TCNONE},python_get_part,NULL},
+	{"intern", "string", "", sizeof(INTERN), 1024, convert_from_intern, convert_to_intern, NULL,NULL,NULL,convert_to_intern,{TCOPS(intern)},},
 };
 
 PROPERTYTYPE property_getfirst_type(void)
@@ -97,6 +98,7 @@ int property_check(void)
 		case PT_loadshape: sz = sizeof(loadshape); break;
 		case PT_enduse: sz = sizeof(enduse); break;
 		case PT_random: sz = sizeof(randomvar); break;
+		case PT_intern: sz = sizeof(INTERN); break;
 		default: break;
 		}
 		IN_MYCONTEXT output_verbose("property_check of %s: declared size is %d, actual size is %d", property_type[ptype].name, property_type[ptype].size, sz);
@@ -666,4 +668,148 @@ int convert_from_string(char *buffer, int len, void *data, PROPERTY *p)
 	int n = snprintf(buffer,(size_t)len,"%s",(*str)->c_str());
 	return n;
 }
+
+/*********************************************************
+ * INTERNED STRINGS
+ *********************************************************/
+static INTERNSTRING **intern_table = NULL;
+static size_t intern_tablesize = 0;
+static size_t intern_count = 0;
+static size_t intern_size = 0;
+static LOCKVAR intern_lock = 0;
+
+static unsigned int intern_hash(const char *value, size_t len)
+{
+	// FNV-1a
+	unsigned int hash = 2166136261u;
+	for ( size_t n = 0 ; n < len ; n++ )
+	{
+		hash ^= (unsigned char)value[n];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static bool intern_grow(void)
+{
+	size_t newsize = intern_tablesize ? intern_tablesize*2 : 1024;
+	INTERNSTRING **newtable = (INTERNSTRING**)malloc(sizeof(INTERNSTRING*)*newsize);
+	if ( newtable == NULL )
+	{
+		return false;
+	}
+	memset(newtable,0,sizeof(INTERNSTRING*)*newsize);
+	for ( size_t n = 0 ; n < intern_tablesize ; n++ )
+	{
+		INTERNSTRING *item, *next;
+		for ( item = intern_table[n] ; item != NULL ; item = next )
+		{
+			next = item->next;
+			size_t bucket = item->hash%newsize;
+			item->next = newtable[bucket];
+			newtable[bucket] = item;
+		}
+	}
+	free(intern_table);
+	intern_size += sizeof(INTERNSTRING*)*(newsize-intern_tablesize);
+	intern_table = newtable;
+	intern_tablesize = newsize;
+	return true;
+}
+
+INTERNSTRING *intern_get(const char *value)
+{
+	if ( value == NULL || value[0] == '\0' )
+	{
+		return NULL;
+	}
+	size_t len = strlen(value);
+	unsigned int hash = intern_hash(value,len);
+	wlock(&intern_lock);
+	if ( intern_count >= intern_tablesize && ! intern_grow() && intern_table == NULL )
+	{
+		wunlock(&intern_lock);
+		throw_exception("intern_get(value='%s'): memory allocation failed",value);
+	}
+	INTERNSTRING *item;
+	size_t bucket = hash%intern_tablesize;
+	for ( item = intern_table[bucket] ; item != NULL ; item = item->next )
+	{
+		if ( item->hash == hash && item->len == len && memcmp(item->value,value,len) == 0 )
+		{
+			wunlock(&intern_lock);
+			return item;
+		}
+	}
+	item = (INTERNSTRING*)malloc(sizeof(INTERNSTRING)+len);
+	if ( item == NULL )
+	{
+		wunlock(&intern_lock);
+		throw_exception("intern_get(value='%s'): memory allocation failed",value);
+	}
+	item->hash = hash;
+	item->len = len;
+	memcpy(item->value,value,len+1);
+	item->next = intern_table[bucket];
+	intern_table[bucket] = item;
+	intern_count++;
+	intern_size += sizeof(INTERNSTRING)+len;
+	wunlock(&intern_lock);
+	return item;
+}
+
+void intern_free(void)
+{
+	wlock(&intern_lock);
+	for ( size_t n = 0 ; n < intern_tablesize ; n++ )
+	{
+		INTERNSTRING *item, *next;
+		for ( item = intern_table[n] ; item != NULL ; item = next )
+		{
+			next = item->next;
+			free(item);
+		}
+	}
+	free(intern_table);
+	intern_table = NULL;
+	intern_tablesize = 0;
+	intern_count = 0;
+	intern_size = 0;
+	wunlock(&intern_lock);
+}
+
+size_t intern_getcount(void)
+{
+	return intern_count;
+}
+
+size_t intern_getsize(void)
+{
+	return intern_size;
+}
+
+int convert_to_intern(const char *s, void *data, PROPERTY *p)
+{
+	INTERN *ref = (INTERN*)data;
+	size_t len = strlen(s);
+	if ( len > 1 && s[0] == '"' && s[len-1] == '"' )
+	{
+		std::string unquoted(s+1,len-2);
+		*ref = intern_get(unquoted.c_str());
+	}
+	else
+	{
+		*ref = intern_get(s);
+	}
+	return *ref ? (*ref)->len+1 : 1;
+}
+
+int convert_from_intern(char *buffer, int len, void *data, PROPERTY *p)
+{
+	INTERN ref = *(INTERN*)data;
+	const char *value = ref ? ref->value : "";
+	const char *format = ( ref == NULL || strchr(value,' ') != NULL || strchr(value,';') != NULL ) ? "\"%s\"" : "%s";
+	int n = snprintf(buffer,(size_t)len,format,value);
+	return n < len ? n : 0;
+}
 // EOF
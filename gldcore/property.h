@@ -187,6 +187,26 @@ typedef complex triplex[3];
 // Typedef: STRING
 typedef std::string* STRING;
 
+/*	Structure: s_internstring
+	next - next string in the same hash bucket
+	hash - hash value of the string
+	len - length of the string
+	value - the string itself (NUL terminated)
+
+	Interned strings are shared, immutable, and never released, so a handle
+	remains valid for the life of the process and may be copied bytewise.
+	The empty string is always represented by a NULL handle.
+ */
+typedef struct s_internstring {
+	struct s_internstring *next;
+	unsigned int hash;
+	size_t len;
+	char value[1];
+} INTERNSTRING;
+
+// Typedef: INTERN
+typedef INTERNSTRING* INTERN;
+
 #define BYREF 0x01
 #include <math.h>
 
@@ -1037,6 +1057,7 @@ typedef DELEGATEDVALUE* delegated;
 	PT_enduse - Enduse load data
 	PT_random - Randomized number
 	PT_method - Method
+	PT_intern - the data is a handle to a shared interned string
 
 	PT_AGGREGATE - internal use only
 	PT_KEYWORD - used to add an enum/set keyword definition
@@ -1080,6 +1101,7 @@ enum e_propertytype {_PT_FIRST=-1,
 	PT_method,
 	PT_string,
 	PT_python,
+	PT_intern,
 	/* add new property types here - don't forget to add them also to rt/gridlabd.h and property.c */
 #ifdef USE_TRIPLETS
 	PT_triple,
@@ -1289,6 +1311,12 @@ typedef uint32 PROPERTYFLAGS;
  */
 #define PF_DYNAMIC	0x0020
 
+/*	Define: PF_NAMELOOKUP
+	Indicates that a lookup of the property by name during sync has
+	already been reported (see property_lookup_check)
+ */
+#define PF_NAMELOOKUP 0x0040
+
 /*	Define: PF_DEPRECATED_NONOTICE
 	The property is deprecated but no reference warning is desired
  */
@@ -1686,6 +1714,55 @@ int convert_to_string(const char *s, void *data, PROPERTY *p);
  */
 int convert_from_string(char *buffer, int len, void *data, PROPERTY *p);
 
+/*	Function: intern_get
+
+	Interned strings are kept until <intern_free> is called at exit, so
+	only strings from a bounded set (e.g., values given in the model or its
+	input files) should be interned.  Strings computed during a run, such as
+	formatted property values, must not be interned.
+
+	Returns:
+	INTERNSTRING* - the shared handle for the string (NULL for the empty string)
+ */
+INTERNSTRING *intern_get(const char *value);
+
+/*	Function: intern_free
+
+	Releases all interned strings.  Handles obtained from <intern_get> are no
+	longer valid after this call.
+ */
+void intern_free(void);
+
+/*	Function: intern_getcount
+
+	Returns:
+	size_t - the number of distinct strings in the intern table
+ */
+size_t intern_getcount(void);
+
+/*	Function: intern_getsize
+
+	Returns:
+	size_t - the number of bytes used by the intern table
+ */
+size_t intern_getsize(void);
+
+/*	Function: convert_to_intern
+
+	Returns:
+	>=0 - number of characters read
+	<0 - failure
+ */
+int convert_to_intern(const char *s, void *data, PROPERTY *p);
+
+/*	Function: convert_from_intern
+
+	Returns:
+	>=0 - number of characters written
+	<0 - failure
+ */
+int convert_from_intern(char *buffer, int len, void *data, PROPERTY *p);
+
 // EOF
 
 #ifdef __cplusplus
@@ -322,6 +322,8 @@ PyObject *python_property_get_value(PyObject *self, PyObject *args, PyObject *kw
         return NULL;
     case PT_string:
         return PyUnicode_FromFormat("%s",(*(STRING*)addr)->c_str());
+    case PT_intern:
+        return PyUnicode_FromFormat("%s",*(INTERN*)addr ? (*(INTERN*)addr)->value : "");
     case PT_python:
         return *(PyObject**)addr;
     default:
@@ -603,6 +605,17 @@ PyObject *python_property_set_value(PyObject *self, PyObject *args, PyObject *kw
     case PT_string:
         PyErr_SetString(PyExc_Exception,"cannot set string");
         return NULL;
+    case PT_intern:
+        if ( PyUnicode_Check(value) )
+        {
+            *(INTERN*)addr = intern_get(PyUnicode_AsUTF8(value));
+            Py_RETURN_NONE;
+        }
+        else
+        {
+            PyErr_SetString(PyExc_Exception,"value is not a string");
+            return NULL;
+        }
     case PT_python:
         Py_DECREF(*(PyObject**)addr);
         Py_INCREF(value);
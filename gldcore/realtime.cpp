@@ -5,7 +5,7 @@
 
 #include "gldcore.h"
 
-// SET_MYCONTEXT(DMC_REALTIME) // used only if IN_MYCONTEXT is present
+SET_MYCONTEXT(DMC_REALTIME)
 
 time_t realtime_now(void)
 {
@@ -23,7 +23,13 @@ time_t realtime_runtime(void)
 	return realtime_now() - starttime;
 }
 
-/****************************************************************/
+/****************************************************************
+ * Realtime events
+ *
+ * Events are kept in time order so that checking the schedule, which
+ * is done every event-mode step and every deltamode timestep, only
+ * looks at the first event.
+ ****************************************************************/
 typedef struct s_eventlist {
 	time_t at;
 	STATUS (*call)(void);
@@ -34,6 +40,7 @@ static EVENT *eventlist = NULL;
 STATUS realtime_schedule_event(time_t at, STATUS (*callback)(void))
 {
 	EVENT *event = (EVENT*)malloc(sizeof(EVENT));
+	EVENT **next = &eventlist;
 	if (event==NULL)
 	{
 		errno=ENOMEM;
@@ -41,38 +48,216 @@ STATUS realtime_schedule_event(time_t at, STATUS (*callback)(void))
 	}
 	event->at = at;
 	event->call = callback;
-	event->next = eventlist;
-	eventlist = event;
+	while ( *next != NULL && (*next)->at <= at )
+	{
+		next = &(*next)->next;
+	}
+	event->next = *next;
+	*next = event;
 	return SUCCESS;
 }
 
 STATUS realtime_run_schedule(void)
 {
+	if ( eventlist == NULL )
+	{
+		return SUCCESS;
+	}
 	time_t now = realtime_now();
-	EVENT *event, *last=NULL;
-	for (event=eventlist; event!=NULL; event=event->next)
+	while ( eventlist != NULL && eventlist->at <= now )
+	{
+		/* remove the event before the callback so it can reschedule itself */
+		EVENT *event = eventlist;
+		STATUS (*call)(void) = event->call;
+		eventlist = event->next;
+		free(event);
+
+		if ((*call)()==FAILED)
+			return FAILED;
+	}
+	return SUCCESS;
+}
+
+/****************************************************************
+ * Realtime pacer
+ *
+ * The pacer converts simulation timestamps into absolute deadlines
+ * on the monotonic clock so that sleep errors do not accumulate from
+ * one step to the next.  The last part of each wait can optionally be
+ * spent polling the clock (see global realtime_busywait) to reduce the
+ * wakeup latency of the operating system scheduler.
+ ****************************************************************/
+
+#define PACER_MAXSAMPLES 65536
+
+static struct {
+	int64 offset; // deadline(t) = t*1e9 - offset (ns)
+	uint64 steps; // number of paced steps
+	uint64 skipped; // number of steps skipped to catch up
+	int64 *jitter; // wakeup latency samples (ns)
+	size_t nsamples;
+	int64 max_jitter; // largest wakeup latency (ns)
+	int64 max_overrun; // largest deadline overrun (ns)
+} pacer = {0,0,0,NULL,0,0,0};
+
+static int64 pacer_now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return (int64)ts.tv_sec*1000000000 + ts.tv_nsec;
+}
+
+static void pacer_sleep_until(int64 deadline)
+{
+#if defined __APPLE__
+	int64 wait = deadline - pacer_now();
+	if ( wait > 0 )
 	{
-		if (event->at<=now)
+		struct timespec ts = {(time_t)(wait/1000000000), (long)(wait%1000000000)};
+		while ( nanosleep(&ts,&ts) != 0 && errno == EINTR ) {}
+	}
+#else
+	struct timespec ts = {(time_t)(deadline/1000000000), (long)(deadline%1000000000)};
+	while ( clock_nanosleep(CLOCK_MONOTONIC,TIMER_ABSTIME,&ts,NULL) == EINTR ) {}
+#endif
+}
+
+static void pacer_record(int64 jitter)
+{
+	if ( pacer.jitter == NULL )
+	{
+		pacer.jitter = (int64*)malloc(sizeof(int64)*PACER_MAXSAMPLES);
+		if ( pacer.jitter == NULL )
 		{
-			STATUS (*call)(void) = event->call;
-
-			/* delete from list */
-			if (last==NULL) /* event is first in list */
-				eventlist = event->next;
-			else
-				last->next = event->next;
-			free(event);
-			event = NULL;
-
-			/* callback */
-			if ((*call)()==FAILED)
-				return FAILED;
-
-			/* retreat to previous event */
-			event = last;
-			if (event==NULL)
-				break;
+			return;
 		}
 	}
-	return SUCCESS;
+	pacer.jitter[pacer.nsamples++%PACER_MAXSAMPLES] = jitter;
+	if ( jitter > pacer.max_jitter )
+	{
+		pacer.max_jitter = jitter;
+	}
+}
+
+/** Start the realtime pacer
+	
+	When wallclock is true, the deadline of each timestamp is the moment the
+	system clock reaches it.  Otherwise the deadlines are measured from the
+	moment the pacer is started at timestamp t0.
+ **/
+void realtime_pacer_start(TIMESTAMP t0, bool wallclock)
+{
+	int64 now = pacer_now();
+	if ( wallclock )
+	{
+		struct timespec ts;
+		clock_gettime(CLOCK_REALTIME,&ts);
+		pacer.offset = ((int64)ts.tv_sec*1000000000 + ts.tv_nsec) - now;
+	}
+	else
+	{
+		pacer.offset = (int64)t0*1000000000 - now;
+	}
+	global_realtime_overruns = 0;
+}
+
+/* wait until the deadline of the time t (ns), returns the number of whole seconds skipped */
+static int64 pacer_wait(int64 t, bool can_skip, double *idle)
+{
+	int64 deadline = t - pacer.offset;
+	int64 now = pacer_now();
+	int64 spin = (int64)global_realtime_busywait*1000;
+	double metric = 0.0;
+	TIMESTAMP skip = 0;
+
+	pacer.steps++;
+	if ( now > deadline )
+	{
+		// the previous step did not finish before this step was due
+		global_realtime_overruns++;
+		if ( now-deadline > pacer.max_overrun )
+		{
+			pacer.max_overrun = now-deadline;
+		}
+		if ( can_skip && global_realtime_policy == RTP_SKIP && now-deadline >= 1000000000 )
+		{
+			skip = (TIMESTAMP)((now-deadline)/1000000000);
+			IN_MYCONTEXT output_verbose("realtime pacer skipping %lld seconds to catch up", (long long)skip);
+			pacer.skipped += skip;
+			deadline += skip*1000000000;
+		}
+		else
+		{
+			IN_MYCONTEXT output_verbose("realtime pacer %.3f ms behind", (now-deadline)/1e6);
+		}
+	}
+	if ( now <= deadline )
+	{
+		metric = (double)(deadline-now)/1e9;
+		if ( deadline-spin > now )
+		{
+			pacer_sleep_until(deadline-spin);
+		}
+		while ( (now=pacer_now()) < deadline ) {}
+		pacer_record(now-deadline);
+	}
+	if ( idle != NULL )
+	{
+		*idle = metric > 1.0 ? 1.0 : metric;
+	}
+	return skip;
+}
+
+/** Wait until the deadline of the timestamp t
+	@return the timestamp to which the clock may advance
+ **/
+TIMESTAMP realtime_pacer_wait(TIMESTAMP t, /**< the timestamp to wait for */
+							  double *idle) /**< fraction of the step spent waiting (may be NULL) */
+{
+	return t + pacer_wait((int64)t*1000000000,true,idle);
+}
+
+/** Wait until the deadline of a deltamode timestep
+
+	Deltamode timesteps are paced with the same deadlines as event-mode
+	steps, so sub-second steps run at wall-clock rate.  Late timesteps
+	are never skipped because deltamode cannot drop a timestep.
+ **/
+void realtime_pacer_wait_delta(TIMESTAMP t, /**< the timestamp at which deltamode started */
+							   int64 dt) /**< the time elapsed in deltamode (ns) */
+{
+	pacer_wait((int64)t*1000000000+dt,false,NULL);
+}
+
+static int compare_jitter(const void *a, const void *b)
+{
+	int64 x = *(int64*)a, y = *(int64*)b;
+	return x<y ? -1 : ( x>y ? 1 : 0 );
+}
+
+/** Report realtime pacer performance in the profiler output
+ **/
+void realtime_pacer_report(void)
+{
+	if ( pacer.steps == 0 )
+	{
+		return;
+	}
+	size_t n = pacer.nsamples < PACER_MAXSAMPLES ? pacer.nsamples : PACER_MAXSAMPLES;
+	output_profile("\nRealtime pacer results");
+	output_profile("======================\n");
+	output_profile("Policy                  %s", global_realtime_policy==RTP_SKIP ? "SKIP" : "CATCHUP");
+	output_profile("Busy-wait interval      %8d us", global_realtime_busywait);
+	output_profile("Steps paced             %8llu steps", (unsigned long long)pacer.steps);
+	output_profile("Deadline overruns       %8d steps", global_realtime_overruns);
+	output_profile("Steps skipped           %8llu steps", (unsigned long long)pacer.skipped);
+	output_profile("Maximum overrun         %8.3lf ms", pacer.max_overrun/1e6);
+	if ( n > 0 )
+	{
+		qsort(pacer.jitter,n,sizeof(int64),compare_jitter);
+		output_profile("Wakeup jitter (p50)     %8.1lf us", pacer.jitter[n/2]/1e3);
+		output_profile("Wakeup jitter (p90)     %8.1lf us", pacer.jitter[n*9/10]/1e3);
+		output_profile("Wakeup jitter (p99)     %8.1lf us", pacer.jitter[n*99/100]/1e3);
+		output_profile("Wakeup jitter (max)     %8.1lf us", pacer.max_jitter/1e3);
+	}
 }
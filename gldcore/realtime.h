@@ -22,6 +22,11 @@ time_t realtime_runtime(void);
 STATUS realtime_schedule_event(time_t, STATUS (*callback)(void));
 STATUS realtime_run_schedule(void);
 
+void realtime_pacer_start(TIMESTAMP t0, bool wallclock);
+TIMESTAMP realtime_pacer_wait(TIMESTAMP t, double *idle);
+void realtime_pacer_wait_delta(TIMESTAMP t, int64 dt);
+void realtime_pacer_report(void);
+
 #ifdef __cplusplus
 }
 #endif
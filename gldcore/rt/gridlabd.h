@@ -459,6 +459,7 @@ typedef enum {_PT_FIRST=-1,
 	PT_method,		/**< Method interface */
 	PT_string,
 	PT_python,
+	PT_intern, /**< the data is a handle to a shared interned string */
 #ifdef USE_TRIPLETS
 	PT_triple, /**< triplet of doubles (not supported) */
 	PT_triplex, /**< triplet of complexes (not supported) */
@@ -1414,6 +1415,26 @@ typedef struct s_callbacks {
 		PyObject *(*import)(const char *module, const char *path);
 		bool (*call)(PyObject *pModule, const char *method, const char *vargsfmt, va_list varargs, void *result);
 	} python;
+	struct {
+		struct s_internstring *(*get)(const char *value);
+	} intern;
+	struct {
+		struct s_propertybinding *(*bind)(CLASS *oclass, PROPERTYNAME name, PROPERTYTYPE ptype);
+		size_t (*gather)(struct s_propertybinding *binding, OBJECT **objs, size_t count, void *values);
+		size_t (*scatter)(struct s_propertybinding *binding, OBJECT **objs, size_t count, const void *values);
+		struct s_propertybinding *(*probe)(CLASS *oclass, PROPERTYNAME name, PROPERTYTYPE ptype);
+	} binding;
+	struct {
+		bool (*is_held)(OBJECT *obj);
+		void (*report)(OBJECT *obj, SIMULATIONMODE mode);
+		DT (*timestep)(OBJECT *obj, DT timestep);
+	} deltaregion;
+	struct {
+		struct s_heapaccount *(*account)(int type, const char *owner, const char *name, int64 instance);
+		void (*add)(struct s_heapaccount *account, int64 size);
+		void (*remove)(struct s_heapaccount *account, int64 size);
+		void (*set)(struct s_heapaccount *account, int64 count, int64 size);
+	} heap;
 	long unsigned int magic; /* used to check structure alignment */
 } CALLBACKS; /**< core callback function table */
 
@@ -800,6 +800,7 @@ void schedule_add(SCHEDULE *sch)
 	sch->next = schedule_list;
 	schedule_list = sch;
 	n_schedules++;
+	heap_add(heap_account(HA_CORE,"core","schedule",sizeof(SCHEDULE)),sizeof(SCHEDULE));
 }
 
 /** validate a schedule, if desired 
@@ -0,0 +1,38 @@
+# checks that the recordings of test_partition.glm match the unpartitioned model
+# syntax: python3 test_partition.py EXPECTED_FOLDER ACTUAL_FOLDER FILE ...
+import cmath, math, os, re, sys
+
+TOLERANCE = 1e-4 # recorders only write 6 significant digits
+
+def to_complex(value):
+	match = re.fullmatch(r"([+-]?[0-9.]+(?:e[+-]?[0-9]+)?)([+-][0-9.]+(?:e[+-]?[0-9]+)?)([dr])",value)
+	if match: # polar form, e.g., +7199.84-120.001d
+		angle = float(match.group(2))
+		return cmath.rect(float(match.group(1)),math.radians(angle) if match.group(3) == "d" else angle)
+	return complex(value.replace("i","j"))
+
+def read_data(name):
+	data = []
+	with open(name) as fh:
+		for line in fh:
+			if line.startswith("#"):
+				continue
+			row = line.strip().split(",")
+			data.append([row[0]]+[to_complex(value.split()[0]) for value in row[1:]])
+	return data
+
+expected, actual = sys.argv[1:3]
+for name in sys.argv[3:]:
+	a = read_data(os.path.join(expected,name))
+	b = read_data(os.path.join(actual,name))
+	if len(a) == 0 or len(a) != len(b):
+		print(f"{actual}/{name} has {len(b)} records instead of {len(a)}",file=sys.stderr)
+		sys.exit(1)
+	for x, y in zip(a,b):
+		if x[0] != y[0] or len(x) != len(y):
+			print(f"{actual}/{name} record '{y[0]}' does not match '{x[0]}'",file=sys.stderr)
+			sys.exit(1)
+		for u, v in zip(x[1:],y[1:]):
+			if abs(u-v) > TOLERANCE*max(abs(u),abs(v)):
+				print(f"{actual}/{name} value {v} at {y[0]} differs from {u}",file=sys.stderr)
+				sys.exit(1)
@@ -3,6 +3,8 @@
  */
 
 #include "gldcore.h"
+#include <list>
+#include <vector>
 
 SET_MYCONTEXT(DMC_SERVER)
 
@@ -260,6 +262,7 @@ typedef struct s_httpcnx {
 	const char *type;
 	SOCKET s;
 	bool cooked;
+	bool detached; // socket is owned by a subscription stream
 } HTTPCNX;
 
 /** Create an HTTPCNX connection handle
@@ -450,11 +453,14 @@ static void http_close(HTTPCNX *http)
 		return;
 	if (http->len>0)
 		http_send(http);
+	if ( ! http->detached )
+	{
 #ifdef WIN32
-	closesocket(http->s);
+		closesocket(http->s);
 #else
-	close(http->s);
+		close(http->s);
 #endif
+	}
 	free(http->buffer);
 	free(http);
 }
@@ -579,131 +585,155 @@ void http_decode(char *buffer)
 	strcpy(buffer,result);
 }
 
-int get_value_with_unit(OBJECT *obj, char *arg1, char *arg2, char *buffer, size_t len)
+/** Find the property and unit of a property name with a unit spec, e.g., "voltage_A[kV,3f]"
+	The unit spec is removed from arg2 and spec is set to its format
+	@returns non-zero on success, 0 on failure
+ **/
+static int find_value_with_unit(OBJECT *obj, const char *arg1, char *arg2, PROPERTY **prop, UNIT **unit, char **spec)
 {
 	char *uname = strchr(arg2,'[');
-	if ( uname!=NULL )
-	{
-		UNIT *unit;
-		PROPERTY *prop;
-		double rvalue;
-		complex cvalue;
-		char *spec = NULL;
-		char fmt[64];
-
-		/* find the end of the unit definition */
-		char *p = strchr(uname,']');
-		if ( p!=NULL ) *p='\0';
-		else {
-			output_warning("object '%s' property '%s' unit spec in incomplete or invalid", arg1, arg2);
-			return 0;
-		}
-		*uname++ = '\0';
 
-		/* find the format specs */
-		spec = strchr(uname,',');
-		if ( spec!=NULL )
-			*spec++ = '\0';
-		else
-		{
-			static char *spec4g = NULL;
-			if ( ! spec4g )
-			{
-				spec4g = strdup("4g");
-			}
-			spec = spec4g;
-		}
+	/* find the end of the unit definition */
+	char *p = strchr(uname,']');
+	if ( p!=NULL ) *p='\0';
+	else {
+		output_warning("object '%s' property '%s' unit spec in incomplete or invalid", arg1, arg2);
+		return 0;
+	}
+	*uname++ = '\0';
 
-		/* check spec for conformance */
-		if ( strchr("0123456789",spec[0])==NULL || strchr("aAfFgGeE",spec[1])==NULL )
+	/* find the format specs */
+	*spec = strchr(uname,',');
+	if ( *spec!=NULL )
+		*(*spec)++ = '\0';
+	else
+	{
+		static char *spec4g = NULL;
+		if ( ! spec4g )
 		{
-			output_warning("object '%s' property '%s' unit format '%s' is invalid (must be [0-9][aAeEfFgG])", arg1, arg2, spec);
-			return 0;
+			spec4g = strdup("4g");
 		}
+		*spec = spec4g;
+	}
+
+	/* check spec for conformance */
+	if ( strchr("0123456789",(*spec)[0])==NULL || strchr("aAfFgGeE",(*spec)[1])==NULL )
+	{
+		output_warning("object '%s' property '%s' unit format '%s' is invalid (must be [0-9][aAeEfFgG])", arg1, arg2, *spec);
+		return 0;
+	}
+
+	/* get the unit */
+	*unit = unit_find(uname);
+	if ( *unit==NULL )
+	{
+		output_warning("object '%s' property '%s' unit '%s' not found", arg1, arg2, uname);
+		return 0;
+	}
 
-		/* get the unit */
-		unit = unit_find(uname);
-		if ( unit==NULL )
+	/* get the property */
+	*prop = object_get_property(obj,arg2,NULL);
+	if ( *prop==NULL )
+	{
+		output_warning("object '%s' property '%s' not found", arg1, arg2);
+		return 0;
+	}
+	if ( (*prop)->unit==NULL )
+	{
+		output_warning("class '%s' property '%s' has no units", obj->oclass->name, (*prop)->name);
+		return 0;
+	}
+	return 1;
+}
+
+/** Format the value of a property in a unit
+	@returns the length of the value, or 0 on failure
+ **/
+static int format_value_with_unit(OBJECT *obj, const char *arg1, PROPERTY *prop, UNIT *unit, const char *spec, char *buffer, size_t len)
+{
+	const char *arg2 = prop->name;
+	const char *uname = unit->name;
+	double rvalue;
+	complex cvalue;
+	char fmt[64];
+
+	/* handle complex numbers */
+	if ( prop->ptype==PT_complex )
+	{
+		cvalue = *object_get_complex_quick(obj,prop);
+		if ( !unit_convert_complex(prop->unit,unit,&cvalue) )
 		{
-			output_warning("object '%s' property '%s' unit '%s' not found", arg1, arg2, uname);
+			output_warning("object '%s' property '%s' conversion from '%s' to '%s' failed", arg1, arg2, prop->unit->name, uname);
 			return 0;
 		}
-
-		/* get the property */
-		prop = object_get_property(obj,arg2,NULL);
-		if ( prop==NULL )
-		{
-			output_warning("object '%s' property '%s' not found", arg1, arg2);
+		switch ( spec[2]=='\0' ? cvalue.Notation() : spec[2] ) {
+		case I: // i-notation
+			snprintf(fmt,sizeof(fmt)-1,"%%.%c%c%%+.%c%ci %%s",spec[0],spec[1],spec[0],spec[1]);
+			snprintf(buffer,len,fmt,cvalue.Re(),cvalue.Im(),uname);
+			break;
+		case J: // j-notation
+			snprintf(fmt,sizeof(fmt)-1,"%%.%c%c%%+.%c%cj %%s",spec[0],spec[1],spec[0],spec[1]);
+			snprintf(buffer,len,fmt,cvalue.Re(),cvalue.Im(),uname);
+			break;
+		case A: // degrees
+			snprintf(fmt,sizeof(fmt)-1,"%%.%c%c%%+.%c%cd %%s",spec[0],spec[1],spec[0],spec[1]);
+			snprintf(buffer,len,fmt,cvalue.Mag(),cvalue.Ang(),uname);
+			break;
+		case R: // radians
+			snprintf(fmt,sizeof(fmt)-1,"%%.%c%c%%+.%c%cr %%s",spec[0],spec[1],spec[0],spec[1]);
+			snprintf(buffer,len,fmt,cvalue.Mag(),cvalue.Arg(),uname);
+			break;
+		case 'M': // magnitude only
+			snprintf(fmt,sizeof(fmt)-1,"%%.%c%c %%s",spec[0],spec[1]);
+			snprintf(buffer,len,fmt,cvalue.Mag(),uname);
+			break;
+		case 'D': // angle only in degrees
+			snprintf(fmt,sizeof(fmt)-1,"%%.%c%c deg",spec[0],spec[1]);
+			snprintf(buffer,len,fmt,cvalue.Ang(),uname);
+			break;
+		case 'R': // angle only in radians
+			snprintf(fmt,sizeof(fmt)-1,"%%.%c%c rad",spec[0],spec[1]);
+			snprintf(buffer,len,fmt,cvalue.Arg(),uname);
+			break;
+		case 'X': // real part only
+			snprintf(fmt,sizeof(fmt)-1,"%%.%c%c %%s",spec[0],spec[1]);
+			snprintf(buffer,len,fmt,cvalue.Re(),uname);
+			break;
+		case 'Y': // imaginary part only
+			snprintf(fmt,sizeof(fmt)-1,"%%.%c%c %%s",spec[0],spec[1]);
+			snprintf(buffer,len,fmt,cvalue.Im(),uname);
+			break;
+		default:
+			output_warning("object '%s' property '%s' complex angle notation '%c' is not valid", arg1, arg2, spec[2]=='\0' ? cvalue.Notation() : spec[2]);
 			return 0;
 		}
-		if ( prop->unit==NULL )
+	}
+	else /* handle doubles */
+	{
+		snprintf(fmt,sizeof(fmt)-1,"%%.%c%c %%s",spec[0],spec[1]);
+		rvalue = *object_get_double_quick(obj,prop);
+		if ( !unit_convert_ex(prop->unit,unit,&rvalue) )
 		{
-			output_warning("class '%s' property '%s' has no units", obj->oclass->name, prop->name);
+			output_warning("object '%s' property '%s' conversion from '%s' to '%s' failed", arg1, arg2, prop->unit->name, uname);
 			return 0;
 		}
+		snprintf(buffer,len,fmt,rvalue,uname);
+	}
+	return strlen(buffer);
+}
 
-		/* handle complex numbers */
-		if ( prop->ptype==PT_complex )
-		{
-			cvalue = *object_get_complex_quick(obj,prop);
-			if ( !unit_convert_complex(prop->unit,unit,&cvalue) )
-			{
-				output_warning("object '%s' property '%s' conversion from '%s' to '%s' failed", arg1, arg2, prop->unit->name, unit);
-				return 0;
-			}
-			switch ( spec[2]=='\0' ? cvalue.Notation() : spec[2] ) {
-			case I: // i-notation
-				snprintf(fmt,sizeof(fmt)-1,"%%.%c%c%%+.%c%ci %%s",spec[0],spec[1],spec[0],spec[1]);
-				snprintf(buffer,len,fmt,cvalue.Re(),cvalue.Im(),uname);
-				break;
-			case J: // j-notation
-				snprintf(fmt,sizeof(fmt)-1,"%%.%c%c%%+.%c%cj %%s",spec[0],spec[1],spec[0],spec[1]);
-				snprintf(buffer,len,fmt,cvalue.Re(),cvalue.Im(),uname);
-				break;
-			case A: // degrees
-				snprintf(fmt,sizeof(fmt)-1,"%%.%c%c%%+.%c%cd %%s",spec[0],spec[1],spec[0],spec[1]);
-				snprintf(buffer,len,fmt,cvalue.Mag(),cvalue.Ang(),uname);
-				break;
-			case R: // radians
-				snprintf(fmt,sizeof(fmt)-1,"%%.%c%c%%+.%c%cr %%s",spec[0],spec[1],spec[0],spec[1]);
-				snprintf(buffer,len,fmt,cvalue.Mag(),cvalue.Arg(),uname);
-				break;
-			case 'M': // magnitude only
-				snprintf(fmt,sizeof(fmt)-1,"%%.%c%c %%s",spec[0],spec[1]);
-				snprintf(buffer,len,fmt,cvalue.Mag(),uname);
-				break;
-			case 'D': // angle only in degrees
-				snprintf(fmt,sizeof(fmt)-1,"%%.%c%c deg",spec[0],spec[1]);
-				snprintf(buffer,len,fmt,cvalue.Ang(),uname);
-				break;
-			case 'R': // angle only in radians
-				snprintf(fmt,sizeof(fmt)-1,"%%.%c%c rad",spec[0],spec[1]);
-				snprintf(buffer,len,fmt,cvalue.Arg(),uname);
-				break;
-			case 'X': // real part only
-				snprintf(fmt,sizeof(fmt)-1,"%%.%c%c %%s",spec[0],spec[1]);
-				snprintf(buffer,len,fmt,cvalue.Re(),uname);
-				break;
-			case 'Y': // imaginary part only
-				snprintf(fmt,sizeof(fmt)-1,"%%.%c%c %%s",spec[0],spec[1]);
-				snprintf(buffer,len,fmt,cvalue.Im(),uname);
-				break;
-			default:
-				output_warning("object '%s' property '%s' complex angle notation '%c' is not valid", arg1, arg2, spec[2]=='\0' ? cvalue.Notation() : spec[3]);
-				return 0;
-			}
-		}
-		else /* handle doubles */
+int get_value_with_unit(OBJECT *obj, char *arg1, char *arg2, char *buffer, size_t len)
+{
+	if ( strchr(arg2,'[')!=NULL )
+	{
+		PROPERTY *prop;
+		UNIT *unit;
+		char *spec;
+		if ( !find_value_with_unit(obj,arg1,arg2,&prop,&unit,&spec) )
 		{
-			snprintf(fmt,len,"%%.%c%c %%s",spec[0],spec[1]);
-			rvalue = *object_get_double_quick(obj,prop);
-			if ( !unit_convert_ex(prop->unit,unit,&rvalue) )
-			{
-				output_warning("object '%s' property '%s' conversion from '%s' to '%s' failed", arg1, arg2, prop->unit->name, unit);
-				return 0;
-			}
-			snprintf(buffer,len,fmt,rvalue,uname);
+			return 0;
 		}
+		return format_value_with_unit(obj,arg1,prop,unit,spec,buffer,len);
 	}
 	else if ( !object_get_value_by_name(obj,arg2,buffer,len) )
 	{
@@ -1193,6 +1223,339 @@ int http_read_request(HTTPCNX *http, char *uri)
 	return 1;
 }
 
+/** Process a memory report request
+    @returns non-zero on success, 0 on failure (errno set)
+ **/
+int http_memory_request(HTTPCNX *http, char *uri)
+{
+	size_t size = 65536;
+	char *buffer = (char*)malloc(size);
+	int len;
+	while ( buffer != NULL && (len=heap_json(buffer,size)) < 0 )
+	{
+		size *= 2;
+		char *grown = (char*)realloc(buffer,size);
+		if ( grown == NULL )
+		{
+			free(buffer);
+		}
+		buffer = grown;
+	}
+	if ( buffer == NULL )
+	{
+		errno = ENOMEM;
+		return 0;
+	}
+	http_type(http,"text/json");
+	http_write(http,buffer,len);
+	free(buffer);
+	return 1;
+}
+
+/********************************************************
+ Subscription streams
+
+ A subscription registers a list of properties once and receives a
+ server-sent event after each committed timestep.  Each watched
+ property is formatted once per timestep no matter how many
+ subscribers watch it, and the message is written to each subscriber
+ without blocking the simulation.
+ */
+
+typedef struct s_watch {
+	std::string name; // name used in the messages
+	OBJECT *obj; // object watched (NULL for a global)
+	PROPERTY *prop; // property watched (NULL for a global)
+	UNIT *unit; // unit of the value (NULL without a unit spec)
+	std::string spec; // format of the unit spec, or global name
+	std::string value; // last formatted value
+	unsigned int serial; // changes when the value changes
+	unsigned int refs; // number of subscribers
+} WATCH;
+
+typedef struct s_subscriber {
+	SOCKET s;
+	bool on_change; // only send values that changed
+	std::vector<size_t> watches; // index in watch list
+	std::vector<unsigned int> sent; // serial of the value last sent
+	std::string pending; // data not yet accepted by the socket
+} SUBSCRIBER;
+
+#define SUBSCRIBER_MAXPENDING 1048576
+static std::vector<WATCH> watch_list;
+static std::list<SUBSCRIBER*> subscriber_list;
+static pthread_mutex_t subscriber_lock = PTHREAD_MUTEX_INITIALIZER;
+static volatile size_t subscriber_count = 0;
+
+/** Send data without blocking
+	@returns the number of bytes sent, or -1 on failure (errno set)
+ **/
+static int send_nowait(SOCKET s, const char *buffer, size_t len)
+{
+#ifdef WIN32
+	return send(s,buffer,(int)len,0);
+#else
+	return send(s,buffer,len,MSG_NOSIGNAL|MSG_DONTWAIT);
+#endif
+}
+
+/** Find or add a watch for an object property or a global
+	@returns the watch index, or -1 if not found
+ **/
+static int subscriber_watch(const char *name)
+{
+	for ( size_t n = 0 ; n < watch_list.size() ; n++ )
+	{
+		if ( watch_list[n].name == name )
+		{
+			watch_list[n].refs++;
+			return (int)n;
+		}
+	}
+	WATCH watch;
+	watch.name = name;
+	watch.obj = NULL;
+	watch.prop = NULL;
+	watch.unit = NULL;
+	watch.serial = 0;
+	watch.refs = 1;
+	char objname[1024], propname[1024];
+	if ( sscanf(name,"%1023[^/]/%1023s",objname,propname) == 2 )
+	{
+		const char *id = strchr(objname,':');
+		watch.obj = ( id == NULL ) ? object_find_name(objname) : object_find_by_id(atoi(id+1));
+		if ( watch.obj == NULL )
+		{
+			output_warning("subscription object '%s' not found", objname);
+			return -1;
+		}
+		if ( strchr(propname,'[') == NULL )
+		{
+			watch.prop = object_get_property(watch.obj,propname,NULL);
+			if ( watch.prop == NULL )
+			{
+				output_warning("subscription object '%s' property '%s' not found", objname, propname);
+				return -1;
+			}
+		}
+		else
+		{
+			// resolve the unit spec now and check that the value can be formatted with it
+			char *spec;
+			char buffer[1024];
+			if ( ! find_value_with_unit(watch.obj,objname,propname,&watch.prop,&watch.unit,&spec)
+				|| ! format_value_with_unit(watch.obj,objname,watch.prop,watch.unit,spec,buffer,sizeof(buffer)) )
+			{
+				output_warning("subscription object '%s' property '%s' unit spec is not valid", objname, propname);
+				return -1;
+			}
+			watch.spec = spec;
+		}
+	}
+	else if ( global_find(name) != NULL )
+	{
+		watch.spec = name;
+	}
+	else
+	{
+		output_warning("subscription global variable '%s' not found", name);
+		return -1;
+	}
+	watch_list.push_back(watch);
+	return (int)(watch_list.size()-1);
+}
+
+/** Remove a subscriber and close its socket **/
+static void subscriber_close(SUBSCRIBER *sub)
+{
+	for ( size_t n = 0 ; n < sub->watches.size() ; n++ )
+	{
+		watch_list[sub->watches[n]].refs--;
+	}
+#ifdef WIN32
+	closesocket(sub->s);
+#else
+	close(sub->s);
+#endif
+	IN_MYCONTEXT output_verbose("subscription on socket %d closed", sub->s);
+	delete sub;
+}
+
+/** Process an incoming subscription request
+	@returns non-zero on success, 0 on failure (errno set)
+ **/
+int http_subscribe_request(HTTPCNX *http, char *uri)
+{
+	SUBSCRIBER *sub = new SUBSCRIBER;
+	sub->s = http->s;
+	sub->on_change = false;
+	char *options = strchr(uri,'?');
+	if ( options != NULL )
+	{
+		*options++ = '\0';
+		if ( strcmp(options,"on=change") == 0 )
+		{
+			sub->on_change = true;
+		}
+		else if ( strcmp(options,"on=commit") != 0 )
+		{
+			output_warning("subscription option '%s' is not valid", options);
+			delete sub;
+			return 0;
+		}
+	}
+	http_decode(uri);
+	pthread_mutex_lock(&subscriber_lock);
+	char *next = uri;
+	while ( *next != '\0' )
+	{
+		// names are separated by commas outside of unit specs
+		char *name = next;
+		int depth = 0;
+		while ( *next != '\0' && ( *next != ',' || depth > 0 ) )
+		{
+			depth += ( *next == '[' ? 1 : ( *next == ']' ? -1 : 0 ) );
+			next++;
+		}
+		if ( *next == ',' )
+		{
+			*next++ = '\0';
+		}
+		int n = subscriber_watch(name);
+		if ( n < 0 )
+		{
+			for ( size_t m = 0 ; m < sub->watches.size() ; m++ )
+			{
+				watch_list[sub->watches[m]].refs--;
+			}
+			pthread_mutex_unlock(&subscriber_lock);
+			delete sub;
+			return 0;
+		}
+		sub->watches.push_back(n);
+		sub->sent.push_back(watch_list[n].serial-1);
+	}
+	if ( sub->watches.size() == 0 )
+	{
+		pthread_mutex_unlock(&subscriber_lock);
+		delete sub;
+		return 0;
+	}
+	char header[] = "HTTP/1.1 " HTTP_OK "\nContent-Type: text/event-stream\nCache-Control: no-cache\nConnection: keep-alive\n\n";
+	send_data(http->s,header,strlen(header));
+	// the subscriber owns the socket from now on, server_publish() may close it as soon as the lock is released
+	http->detached = true;
+	subscriber_list.push_back(sub);
+	subscriber_count = subscriber_list.size();
+	IN_MYCONTEXT output_verbose("subscription on socket %d opened for %d values", sub->s, (int)sub->watches.size());
+	pthread_mutex_unlock(&subscriber_lock);
+	return 1;
+}
+
+/** Append a JSON string to a message **/
+static void subscriber_quote(std::string &message, const char *value)
+{
+	message += '"';
+	for ( const char *p = value ; *p != '\0' ; p++ )
+	{
+		if ( *p == '"' || *p == '\\' )
+		{
+			message += '\\';
+		}
+		if ( *p != '\n' && *p != '\r' )
+		{
+			message += *p;
+		}
+	}
+	message += '"';
+}
+
+/** Send the values watched to each subscriber after a timestep is committed **/
+void server_publish(TIMESTAMP t)
+{
+	if ( subscriber_count == 0 )
+	{
+		return;
+	}
+	pthread_mutex_lock(&subscriber_lock);
+
+	// format each value once
+	for ( std::vector<WATCH>::iterator watch = watch_list.begin() ; watch != watch_list.end() ; watch++ )
+	{
+		if ( watch->refs == 0 )
+		{
+			continue;
+		}
+		char buffer[1024] = "";
+		if ( watch->obj == NULL )
+		{
+			global_getvar(watch->spec.c_str(),buffer,sizeof(buffer));
+		}
+		else if ( watch->unit == NULL )
+		{
+			object_get_value_by_addr(watch->obj,GETADDR(watch->obj,watch->prop),buffer,sizeof(buffer),watch->prop);
+		}
+		else
+		{
+			format_value_with_unit(watch->obj,watch->name.c_str(),watch->prop,watch->unit,watch->spec.c_str(),buffer,sizeof(buffer));
+		}
+		const char *value = http_unquote(buffer);
+		if ( watch->value != value )
+		{
+			watch->value = value;
+			watch->serial++;
+		}
+	}
+
+	// fan out to subscribers
+	std::list<SUBSCRIBER*>::iterator item = subscriber_list.begin();
+	while ( item != subscriber_list.end() )
+	{
+		SUBSCRIBER *sub = *item;
+		std::string message;
+		for ( size_t n = 0 ; n < sub->watches.size() ; n++ )
+		{
+			WATCH &watch = watch_list[sub->watches[n]];
+			if ( sub->on_change && sub->sent[n] == watch.serial )
+			{
+				continue;
+			}
+			message += ( message.size() == 0 ? "" : "," );
+			subscriber_quote(message,watch.name.c_str());
+			message += ':';
+			subscriber_quote(message,watch.value.c_str());
+			sub->sent[n] = watch.serial;
+		}
+		if ( message.size() > 0 )
+		{
+			char clock[64];
+			snprintf(clock,sizeof(clock),"data: {\"clock\":%lld,\"values\":{",(long long)t);
+			sub->pending += clock + message + "}}\n\n";
+		}
+		int len = sub->pending.size() > 0 ? send_nowait(sub->s,sub->pending.c_str(),sub->pending.size()) : 0;
+		if ( len < 0 && errno != EAGAIN && errno != EWOULDBLOCK )
+		{
+			subscriber_close(sub);
+			item = subscriber_list.erase(item);
+			continue;
+		}
+		else if ( len > 0 )
+		{
+			sub->pending.erase(0,len);
+		}
+		if ( sub->pending.size() > SUBSCRIBER_MAXPENDING )
+		{
+			output_warning("subscription on socket %d is too slow, closing it", sub->s);
+			subscriber_close(sub);
+			item = subscriber_list.erase(item);
+			continue;
+		}
+		item++;
+	}
+	subscriber_count = subscriber_list.size();
+	pthread_mutex_unlock(&subscriber_lock);
+}
+
 /** Process an incoming GUI request
 	@returns non-zero on success, 0 on failure (errno set)
  **/
@@ -2012,6 +2375,8 @@ void *http_response(void *ptr)
 					{"/find/",	http_find_request,	HTTP_OK, HTTP_NOTFOUND},
 					{"/modify/",	http_modify_request,	HTTP_OK, HTTP_NOTFOUND},
 					{"/read/",	http_read_request,	HTTP_OK, HTTP_NOTFOUND},
+					{"/memory/",	http_memory_request,	HTTP_OK, HTTP_NOTFOUND},
+					{"/subscribe/",	http_subscribe_request,	HTTP_OK, HTTP_NOTFOUND},
 				};
 				size_t n;
 				for ( n=0 ; n<sizeof(map)/sizeof(map[0]) ; n++ )
@@ -2023,6 +2388,10 @@ void *http_response(void *ptr)
 							http_status(http,map[n].success);
 						else
 							http_status(http,map[n].failure);
+
+						/* streaming responses own the socket from now on */
+						if ( http->detached )
+							break;
 						http_send(http);
 
 						/* keep-alive not desired*/
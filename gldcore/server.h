@@ -23,6 +23,7 @@ extern "C" {
 	
 STATUS server_startup(int argc, const char *argv[]);
 STATUS server_join(void);
+void server_publish(TIMESTAMP t);
 
 #ifndef WIN32
 int filelength(int fd);
@@ -8,6 +8,16 @@ SET_MYCONTEXT(DMC_TRANSFORM)
 
 static TRANSFORM *schedule_xformlist=NULL;
 
+/* number of bytes allocated for a transform (used by the memory report) */
+static int64 transform_size(TRANSFORM *xform)
+{
+	switch ( xform->function_type ) {
+	case XT_FILTER: return sizeof(TRANSFORM) + sizeof(double)*(xform->tf->n-1);
+	case XT_EXTERNAL: return sizeof(TRANSFORM) + sizeof(GLDVAR)*(xform->nlhs+xform->nrhs);
+	default: return sizeof(TRANSFORM);
+	}
+}
+
 /****************************************************************
  * GridLAB-D Variable Handling for transform functions
  ****************************************************************/
@@ -259,6 +269,7 @@ int transform_add_filter(OBJECT *target_obj,		/* pointer to the target object (l
 	xform->t2 = (int64)(global_starttime/tf->timestep)*tf->timestep + tf->timeskew;
 	xform->next = schedule_xformlist;
 	schedule_xformlist = xform;
+	heap_add(heap_account(HA_CORE,"core","transform",0),transform_size(xform));
 
 	IN_MYCONTEXT output_debug("added filter '%s' from source '%s:%s' to target '%s:%s'", filter,
  		object_name(target_obj,buffer1,sizeof(buffer1)),target_prop->name,object_name(source_obj,buffer2,sizeof(buffer2)),source_prop->name);
@@ -305,6 +316,7 @@ int transform_add_external(	OBJECT *target_obj,		/* pointer to the target object
 
 	xform->next = schedule_xformlist;
 	schedule_xformlist = xform;
+	heap_add(heap_account(HA_CORE,"core","transform",0),transform_size(xform));
 	IN_MYCONTEXT output_debug("added external transform %s:%s <- %s(%s:%s)", object_name(target_obj,buffer1,sizeof(buffer1)),target_prop->name,function, object_name(source_obj,buffer2,sizeof(buffer2)),source_prop->name);
 	return 1;
 }
@@ -335,6 +347,7 @@ int transform_add_linear(	TRANSFORMSOURCE stype,	/* specifies the type of source
 	xform->function_type = XT_LINEAR;
 	xform->next = schedule_xformlist;
 	schedule_xformlist = xform;
+	heap_add(heap_account(HA_CORE,"core","transform",0),transform_size(xform));
 	IN_MYCONTEXT output_debug("added linear transform %s:%s <- scale=%.3g, bias=%.3g", object_name(obj,buffer,sizeof(buffer)), prop->name, scale, bias);
 	return 1;
 }
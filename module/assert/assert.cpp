@@ -40,7 +40,7 @@ g_assert::g_assert(MODULE *module)
 				PT_KEYWORD, "TRUE", (enumeration)AS_TRUE,
 				PT_KEYWORD, "FALSE", (enumeration)AS_FALSE,
 				PT_KEYWORD, "ERROR", (enumeration)AS_ERROR,
-			PT_char1024, "target", get_target_offset(),  
+			PT_intern, "target", get_target_offset(),  
 				PT_REQUIRED,  
 				PT_DESCRIPTION, "the target property to test",
 			PT_char32, "part", get_part_offset(),  
@@ -56,16 +56,16 @@ g_assert::g_assert(MODULE *module)
 				PT_KEYWORD, "!=", (enumeration)TCOP_NE,
 				PT_KEYWORD, "inside", (enumeration)TCOP_IN,
 				PT_KEYWORD, "outside", (enumeration)TCOP_NI,
-			PT_char1024, "value", get_value_offset(),  
+			PT_intern, "value", get_value_offset(),  
 				PT_REQUIRED,  
 				PT_DESCRIPTION, "the value to compare with for binary tests",
-			PT_char1024, "within", get_value2_offset(),  
+			PT_intern, "within", get_value2_offset(),  
 				PT_DESCRIPTION, "the bounds within which the value must bed compared",
-			PT_char1024, "lower", get_value_offset(),  
+			PT_intern, "lower", get_value_offset(),  
 				PT_DESCRIPTION, "the lower bound to compare with for interval tests",
-			PT_char1024, "upper", get_value2_offset(),  
+			PT_intern, "upper", get_value2_offset(),  
 				PT_DESCRIPTION, "the upper bound to compare with for interval tests",
-			PT_char1024, "group", get_group_offset(),  
+			PT_intern, "group", get_group_offset(),  
 				PT_DESCRIPTION, "a target group specification to use instead of parent object",
 			PT_timestamp, "start", get_start_offset(),  
 				PT_DEFAULT, "INIT",
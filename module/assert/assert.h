@@ -15,15 +15,15 @@ private:
 public:
 	typedef enum {AS_NONE=0, AS_TRUE=1, AS_FALSE=2, AS_ERROR=3} ASSERTSTATUS;
 	GL_ATOMIC(enumeration,status); 
-	GL_STRING(char1024,target);		
+	GL_INTERN(target);		
 	GL_STRING(char32,part);
 	GL_ATOMIC(enumeration,relation);
-	GL_STRING(char1024,value);
-	GL_STRING(char1024,value2);
+	GL_INTERN(value);
+	GL_INTERN(value2);
 	GL_ATOMIC(TIMESTAMP,start);
 	GL_ATOMIC(TIMESTAMP,stop);
 	GL_ATOMIC(double,hold);
-	GL_STRING(char1024,group);
+	GL_INTERN(group);
 
 private:
 	std::list<gld_property> *target_list;
@@ -44,7 +44,7 @@ complex_assert::complex_assert(MODULE *module)
 				PT_KEYWORD,"ANGLE",(enumeration)ANGLE,//specify in radians
 			PT_complex, "value", get_value_offset(),PT_DESCRIPTION,"Value to assert",
 			PT_double, "within", get_within_offset(),PT_DESCRIPTION,"Tolerance for a successful assert",
-			PT_char1024, "target", get_target_offset(),PT_DESCRIPTION,"Property to perform the assert upon",	
+			PT_intern, "target", get_target_offset(),PT_DESCRIPTION,"Property to perform the assert upon",	
 			NULL)<1){
 				char msg[256];
 				snprintf(msg,sizeof(msg)-1, "unable to publish properties in %s",__FILE__);
@@ -40,7 +40,7 @@ double_assert::double_assert(MODULE *module)
 				PT_KEYWORD,"WITHIN_RATIO",(enumeration)IN_RATIO,
 			PT_double, "value", get_value_offset(),PT_DESCRIPTION,"Value to assert",
 			PT_double, "within", get_within_offset(),PT_DESCRIPTION,"Tolerance for a successful assert",
-			PT_char1024, "target", get_target_offset(),PT_DESCRIPTION,"Property to perform the assert upon",
+			PT_intern, "target", get_target_offset(),PT_DESCRIPTION,"Property to perform the assert upon",
 			NULL)<1){
 				throw "unable to publish properties in " __FILE__;
 		}
@@ -32,7 +32,7 @@ enum_assert::enum_assert(MODULE *module)
 				PT_KEYWORD,"ASSERT_FALSE",(enumeration)ASSERT_FALSE,
 				PT_KEYWORD,"ASSERT_NONE",(enumeration)ASSERT_NONE,
 			PT_int32, "value", get_value_offset(),PT_DESCRIPTION,"Value to assert",
-			PT_char1024, "target", get_target_offset(),PT_DESCRIPTION,"Property to perform the assert upon",	
+			PT_intern, "target", get_target_offset(),PT_DESCRIPTION,"Property to perform the assert upon",	
 			NULL)<1){
 				char msg[256];
 				snprintf(msg,sizeof(msg)-1, "unable to publish properties in %s",__FILE__);
@@ -15,7 +15,7 @@ public:
 	enum {ASSERT_TRUE=1, ASSERT_FALSE, ASSERT_NONE}; 
 	
 	GL_ATOMIC(enumeration,status);
-	GL_STRING(char1024,target);
+	GL_INTERN(target);
 	GL_ATOMIC(int32,value);
 
 public:
@@ -40,7 +40,7 @@ int_assert::int_assert(MODULE *module)
 	                PT_KEYWORD,"WITHIN_RATIO",(enumeration)IN_RATIO,
                 PT_int32, "value", get_value_offset(),
                 PT_int32, "within", get_within_offset(),
-                PT_char1024, "target", get_target_offset(),
+                PT_intern, "target", get_target_offset(),
                 NULL)<1){
             char msg[256];
             sprintf(msg, "unable to publish properties in %s",__FILE__);
@@ -17,7 +17,7 @@ public:
 	enum {ASSERT_TRUE=1, ASSERT_FALSE, ASSERT_NONE};
     
 	GL_ATOMIC(enumeration,status);
-	GL_STRING(char1024,target);
+	GL_INTERN(target);
 	GL_ATOMIC(int64,value);
 	GL_ATOMIC(enumeration,once);
 	GL_ATOMIC(int64,once_value);
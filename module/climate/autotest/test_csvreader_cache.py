@@ -0,0 +1,27 @@
+# checks the output of test_csvreader_cache.glm
+import os, sys
+
+if not os.path.exists("weather.cache") or os.path.getsize("weather.cache") == 0:
+	print("weather.cache was not created", file=sys.stderr)
+	sys.exit(1)
+
+def read_data(name):
+	with open(name) as fh:
+		return [line for line in fh if not line.startswith("#")]
+
+parsed = read_data("parsed_out.csv")
+cached = read_data("cached_out.csv")
+if len(parsed) != 24:
+	print(f"parsed_out.csv has {len(parsed)} records instead of 24", file=sys.stderr)
+	sys.exit(1)
+if parsed != cached:
+	print("cached_out.csv does not match parsed_out.csv", file=sys.stderr)
+	sys.exit(1)
+ordered = read_data("ordered_out.csv")
+swapped = read_data("swapped_out.csv")
+if ordered != parsed:
+	print("ordered_out.csv does not match parsed_out.csv", file=sys.stderr)
+	sys.exit(1)
+if swapped == ordered:
+	print("swapped_out.csv was read from the cache of a different column order", file=sys.stderr)
+	sys.exit(1)
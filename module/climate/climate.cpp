@@ -73,13 +73,8 @@ EXPORT int64 calculate_solar_radiation_shading_radians(OBJECT *obj, double tilt,
 }
 
 EXPORT int64 calculate_solar_radiation_shading_position_radians(OBJECT *obj, double tilt, double orientation, double latitude, double longitude, double shading_value, double *value ) {
-	static SolarAngles sa; // just for the functions
-	double ghr, dhr, dnr = 0.0;
-	double cos_incident = 0.0;
-	double std_time = 0.0;
-	double solar_time = 0.0;
-	short int doy = 0;
-	DATETIME dt;
+	SOLARTIME st;
+	double poa[2];
 
 	climate *cli;
 	if(obj == 0 || value == 0 ) {
@@ -92,14 +87,9 @@ EXPORT int64 calculate_solar_radiation_shading_position_radians(OBJECT *obj, dou
 		return 0;
 	}
 
-	cli->get_solar_for_location(latitude, longitude, &dnr, &ghr, &dhr);
-
-	gl_localtime(obj->clock, &dt);
-	std_time = (double)(dt.hour) + ((double)dt.minute)/60.0  + (dt.is_dst ? -1.0:0.0);
-	doy=sa.day_of_yr(dt.month,dt.day);
-	solar_time = sa.solar_time(std_time, doy, RAD(cli->get_tz_meridian()), RAD(obj->longitude));
-	cos_incident = sa.cos_incident(RAD(obj->latitude), tilt, orientation, solar_time, doy);
-	*value = (shading_value*dnr*cos_incident) + dhr*(1+cos(tilt))/2. + ghr*(1-cos(tilt))*cli->get_ground_reflectivity()/2.;
+	cli->get_solar_time(obj->clock, &st);
+	cli->get_solar_irradiance(&st, SIM_LIUJORDAN, tilt, orientation, latitude, longitude, poa);
+	*value = shading_value*poa[0] + poa[1];
 
 	return 1;
 }
@@ -119,12 +109,8 @@ EXPORT int64 calc_solar_solpos_shading_rad(OBJECT *obj, double tilt, double orie
 //Solar radiation calcuation based on solpos and Perez tilt models
 EXPORT int64 calc_solar_solpos_shading_position_rad(OBJECT *obj, double tilt, double orientation, double latitude, double longitude, double shading_value, double *value)
 {
-	static SolarAngles sa; // just for the functions
-	double ghr, dhr, dnr;
-	double cos_incident;
-	double temp_value;
-	DATETIME dt;
-	TIMESTAMP offsetclock;
+	SOLARTIME st;
+	double poa[2];
 
 	climate *cli;
 	if(obj == 0 || value == 0 ) {
@@ -135,72 +121,17 @@ EXPORT int64 calc_solar_solpos_shading_position_rad(OBJECT *obj, double tilt, do
 		return 0;
 	}
 
-	cli->get_solar_for_location(latitude, longitude, &dnr, &ghr, &dhr);
-
-	if (cli->reader_type==1)//check if reader_type is TMY2.
-	{
-		//Adjust time by half an hour - adjusts per TMY "reading" intervals - what they really represent
-		offsetclock = obj->clock + 1800;
-	}
-	else	//Just pass it in
-	{
-		offsetclock = obj->clock;
-	}
-
-	gl_localtime(offsetclock, &dt);
-
-	//Convert temperature back to centrigrade - since we seem to like imperial units
-	temp_value = ((cli->get_temperature() - 32.0)*5.0/9.0);
-
-	//Initialize solpos algorithm
-	sa.S_init(&sa.solpos_vals);
-
-	//Assign in values
-	sa.solpos_vals.longitude = obj->longitude;
-	sa.solpos_vals.latitude = RAD(obj->latitude);
-	if (dt.is_dst == 1)
-	{
-		sa.solpos_vals.timezone = cli->get_tz_offset_val()-1.0;
-	}
-	else
-	{
-		sa.solpos_vals.timezone = cli->get_tz_offset_val();
-	}
-	sa.solpos_vals.year = dt.year;
-	sa.solpos_vals.daynum = (dt.yearday+1);
-	sa.solpos_vals.hour = dt.hour+(dt.is_dst?-1:0);
-	sa.solpos_vals.minute = dt.minute;
-	sa.solpos_vals.second = dt.second;
-	sa.solpos_vals.temp = temp_value;
-	sa.solpos_vals.press = cli->get_pressure();
-
-	// Solar constant associated with extraterrestrial DNI, 1367 W/sq m - pull from TMY for now
-	//sa.solpos_vals.solcon = 126.998456;	//Use constant value for direct normal extraterrestrial irradiance - doesn't seem right to me
-	sa.solpos_vals.solcon = cli->get_direct_normal_extra();	//Use weather-read version (TMY)
-
-	sa.solpos_vals.aspect = orientation;
-	sa.solpos_vals.tilt = tilt;
-	sa.solpos_vals.diff_horz = dhr;
-	sa.solpos_vals.dir_norm = dnr;
-
-	//Calculate different solar position values
-	sa.S_solpos(&sa.solpos_vals);
-
-	//Pull off new cosine of incidence
-	if (sa.solpos_vals.cosinc >= 0.0)
-		cos_incident = sa.solpos_vals.cosinc;
-	else
-		cos_incident = 0.0;
-
-	//Apply the adjustment
-	*value = (shading_value*dnr*cos_incident) + dhr*sa.solpos_vals.perez_horz + ghr*((1-cos(tilt))*cli->get_ground_reflectivity()/2.0);
+	cli->get_solar_time(obj->clock, &st);
+	cli->get_solar_irradiance(&st, SIM_SOLPOS, tilt, orientation, latitude, longitude, poa);
+	*value = shading_value*poa[0] + poa[1];
 
 	return 1;
 }
 
 EXPORT int64 calc_solar_ideal_shading_position_radians(OBJECT *obj, double tilt, double latitude, double longitude, double shading_value, double *value) 
 {
-	double ghr, dhr, dnr;
+	SOLARTIME st;
+	double poa[2];
 	climate *cli;
 	if(obj == 0 || value == 0 ) {
 		return 0;
@@ -210,13 +141,31 @@ EXPORT int64 calc_solar_ideal_shading_position_radians(OBJECT *obj, double tilt,
 		return 0;
 	}
 
-	cli->get_solar_for_location(latitude, longitude, &dnr, &ghr, &dhr);
-	// strictly speaking, the diffuse horizontal value should be modified to account for the
-	// fraction of the sky dome seen by the panel, but this is copied from solar.c
-	*value = shading_value*(dnr) + dhr + ghr*(1-cos(tilt))*(cli->get_ground_reflectivity())/2.0;
+	cli->get_solar_time(obj->clock, &st);
+	cli->get_solar_irradiance(&st, SIM_IDEAL, tilt, 0.0, latitude, longitude, poa);
+	*value = shading_value*poa[0] + poa[1];
 	return 1;
 }
 
+/** Register a panel with the plane-of-array irradiance service of a climate object.
+
+	Panels with the same tilt model and orientation share one irradiance group,
+	which the climate updates once per timestep in presync.  The panel location
+	only distinguishes groups when a cloud model is used.
+
+	@return a pointer to the direct (before shading) and diffuse plane-of-array
+	irradiance (W/sf) of the group, or NULL on failure.
+ **/
+EXPORT double *register_solar_irradiance(OBJECT *obj, int64 model, double tilt, double orientation, double latitude, double longitude)
+{
+	if ( obj == NULL || gl_object_isa(obj, "climate", "climate") == 0 ) 
+	{
+		return NULL;
+	}
+	climate *cli = OBJECTDATA(obj, climate);
+	return cli->register_solar_irradiance((enumeration)model, tilt, orientation, latitude, longitude);
+}
+
 /**
 	@addtogroup tmy TMY2 data
 	@ingroup climate
@@ -739,6 +688,7 @@ climate::climate(MODULE *module) : gld_object()
 		gl_publish_function(oclass,	"calculate_solar_radiation_shading_position_radians", (FUNCTIONADDR)calculate_solar_radiation_shading_position_radians);
 		gl_publish_function(oclass,	"calculate_solpos_radiation_shading_position_radians", (FUNCTIONADDR)calc_solar_solpos_shading_position_rad);
 		gl_publish_function(oclass,	"calc_solar_ideal_shading_position_radians", (FUNCTIONADDR)calc_solar_ideal_shading_position_radians);
+		gl_publish_function(oclass,	"register_solar_irradiance", (FUNCTIONADDR)::register_solar_irradiance);
 	}
 }
 
@@ -780,6 +730,7 @@ void climate::set_defaults(bool is_template)
 	MIN_LON = 0;
 	MAX_LON = 0;
 	global_transmissivity = 1.0;
+	irradiance_list = NULL;
 	if ( is_template )
 		defaults = this;
 }
@@ -1178,6 +1129,136 @@ int climate::get_solar_for_location(double latitude, double longitude, double *d
 	return retval;
 }
 
+/** Compute the time-dependent terms used by get_solar_irradiance() **/
+void climate::get_solar_time(TIMESTAMP t, SOLARTIME *st)
+{
+	OBJECT *obj = THISOBJECTHDR;
+	gl_localtime(t, &st->dt);
+	double std_time = (double)(st->dt.hour) + ((double)st->dt.minute)/60.0  + (st->dt.is_dst ? -1.0:0.0);
+	st->doy = sa->day_of_yr(st->dt.month,st->dt.day);
+	st->solar_time = sa->solar_time(std_time, st->doy, RAD(get_tz_meridian()), RAD(obj->longitude));
+
+	//Adjust time by half an hour for TMY2 - adjusts per TMY "reading" intervals - what they really represent
+	gl_localtime(reader_type==RT_TMY2 ? t+1800 : t, &st->solpos_dt);
+}
+
+/** Compute the direct (before shading) and diffuse plane-of-array irradiance on a panel **/
+void climate::get_solar_irradiance(const SOLARTIME *st, enumeration model, double tilt, double orientation, double latitude, double longitude, double value[2])
+{
+	OBJECT *obj = THISOBJECTHDR;
+	double ghr, dhr, dnr = 0.0;
+
+	get_solar_for_location(latitude, longitude, &dnr, &ghr, &dhr);
+
+	switch ( model ) {
+	case SIM_IDEAL:
+		// strictly speaking, the diffuse horizontal value should be modified to account for the
+		// fraction of the sky dome seen by the panel, but this is copied from solar.c
+		value[0] = dnr;
+		value[1] = dhr + ghr*(1-cos(tilt))*get_ground_reflectivity()/2.0;
+		break;
+	case SIM_LIUJORDAN:
+		value[0] = dnr*sa->cos_incident(RAD(obj->latitude), tilt, orientation, st->solar_time, st->doy);
+		value[1] = dhr*(1+cos(tilt))/2. + ghr*(1-cos(tilt))*get_ground_reflectivity()/2.;
+		break;
+	case SIM_SOLPOS:
+		{
+			SolarAngles::SOLPOS_POSDATA pos;
+
+			//Initialize solpos algorithm
+			sa->S_init(&pos);
+
+			//Assign in values
+			pos.longitude = obj->longitude;
+			pos.latitude = RAD(obj->latitude);
+			pos.timezone = get_tz_offset_val() - (st->solpos_dt.is_dst == 1 ? 1.0 : 0.0);
+			pos.year = st->solpos_dt.year;
+			pos.daynum = (st->solpos_dt.yearday+1);
+			pos.hour = st->solpos_dt.hour+(st->solpos_dt.is_dst?-1:0);
+			pos.minute = st->solpos_dt.minute;
+			pos.second = st->solpos_dt.second;
+			pos.temp = ((get_temperature() - 32.0)*5.0/9.0); // solpos uses degC
+			pos.press = get_pressure();
+
+			// Solar constant associated with extraterrestrial DNI, 1367 W/sq m - pull from TMY for now
+			pos.solcon = get_direct_normal_extra();	//Use weather-read version (TMY)
+
+			pos.aspect = orientation;
+			pos.tilt = tilt;
+			pos.diff_horz = dhr;
+			pos.dir_norm = dnr;
+
+			//Calculate different solar position values
+			sa->S_solpos(&pos);
+
+			value[0] = dnr*(pos.cosinc >= 0.0 ? pos.cosinc : 0.0);
+			value[1] = dhr*pos.perez_horz + ghr*((1-cos(tilt))*get_ground_reflectivity()/2.0);
+		}
+		break;
+	default:
+		value[0] = value[1] = 0.0;
+		break;
+	}
+}
+
+/* NaN-aware equality used to match irradiance groups */
+static inline bool same_value(double a, double b)
+{
+	return a == b || ( isnan(a) && isnan(b) );
+}
+
+/** Find or create the irradiance group of a panel **/
+double *climate::register_solar_irradiance(enumeration model, double tilt, double orientation, double latitude, double longitude)
+{
+	SOLARIRRADIANCE *item;
+
+	// location only matters when the cloud model varies the irradiance across the feeder
+	if ( get_cloud_model() == CM_NONE )
+	{
+		latitude = longitude = NaN;
+	}
+	if ( model == SIM_IDEAL )
+	{
+		orientation = 0.0;
+	}
+	for ( item = irradiance_list ; item != NULL ; item = item->next )
+	{
+		if ( item->model == model && same_value(item->tilt,tilt) && same_value(item->orientation,orientation)
+			&& same_value(item->latitude,latitude) && same_value(item->longitude,longitude) )
+		{
+			item->panels++;
+			return item->value;
+		}
+	}
+	item = new SOLARIRRADIANCE;
+	item->model = model;
+	item->tilt = tilt;
+	item->orientation = orientation;
+	item->latitude = latitude;
+	item->longitude = longitude;
+	item->value[0] = item->value[1] = 0.0;
+	item->panels = 1;
+	item->next = irradiance_list;
+	irradiance_list = item;
+	verbose("added solar irradiance group for model %d, tilt %g rad, orientation %g rad", (int)model, tilt, orientation);
+	return item->value;
+}
+
+/** Update all the irradiance groups for the current time **/
+void climate::update_solar_irradiance(TIMESTAMP t)
+{
+	SOLARTIME st;
+	if ( irradiance_list == NULL )
+	{
+		return;
+	}
+	get_solar_time(t, &st);
+	for ( SOLARIRRADIANCE *item = irradiance_list ; item != NULL ; item = item->next )
+	{
+		get_solar_irradiance(&st, item->model, item->tilt, item->orientation, item->latitude, item->longitude, item->value);
+	}
+}
+
 int climate::get_binary_cloud_value_for_location(double latitude, double longitude, int *cloud) 
 {
 	int pixel_x = floor(gl_lerp(latitude, MIN_LAT, MIN_LAT_INDEX, MAX_LAT, MAX_LAT_INDEX));
@@ -2404,6 +2485,9 @@ TIMESTAMP climate::presync(TIMESTAMP t0) /* called in presync */
 		cloud_rv = t0 + 60;
 	}
 
+	// update the plane-of-array irradiance of registered panels
+	update_solar_irradiance(t0);
+
 	//Extra logic to return the correct timestamp based on the weather data source and the use of the cloud model.
 	if (t0 <= TS_ZERO)
 		return TS_NEVER;
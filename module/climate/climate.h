@@ -79,6 +79,7 @@ EXPORT int64 calc_solar_solpos_shading_deg(OBJECT *obj, double tilt, double orie
 EXPORT int64 calc_solar_solpos_shading_position_rad(OBJECT *obj, double tilt, double orientation, double latitude, double longitude, double shading_value, double *value);
 EXPORT int64 calc_solar_solpos_shading_rad(OBJECT *obj, double tilt, double orientation, double shading_value, double *value);
 EXPORT int64 calc_solar_ideal_shading_position_radians(OBJECT *obj, double tilt, double latitude, double longitude, double shading_value, double *value);
+EXPORT double *register_solar_irradiance(OBJECT *obj, int64 model, double tilt, double orientation, double latitude, double longitude);
 
 /**
  * This implements a Gridlab-D specific TMY2 data reader.  It was implemented
@@ -153,6 +154,33 @@ typedef	enum e_record_type {
 		RT_CSV,
 } RECORDTYPE;
 
+/** Tilt models for plane-of-array irradiance */
+typedef enum e_solar_irradiance_model {
+	SIM_IDEAL = 0, ///< ideal panel (calc_solar_ideal_shading_position_radians)
+	SIM_LIUJORDAN = 1, ///< Liu-Jordan tilt model (calculate_solar_radiation_shading_position_radians)
+	SIM_SOLPOS = 2, ///< solpos/Perez tilt model (calc_solar_solpos_shading_position_rad)
+} SOLARIRRADIANCEMODEL;
+
+/** Plane-of-array irradiance shared by all the panels with the same model and orientation */
+typedef struct s_solar_irradiance {
+	enumeration model; ///< tilt model (SOLARIRRADIANCEMODEL)
+	double tilt; ///< panel tilt (rad)
+	double orientation; ///< panel orientation (rad, not used by SIM_IDEAL)
+	double latitude; ///< panel latitude used by the cloud model (deg, NaN if no cloud model)
+	double longitude; ///< panel longitude used by the cloud model (deg, NaN if no cloud model)
+	double value[2]; ///< direct (before shading) and diffuse plane-of-array irradiance (W/sf)
+	unsigned int panels; ///< number of panels registered
+	struct s_solar_irradiance *next;
+} SOLARIRRADIANCE;
+
+/** Time-dependent terms common to all plane-of-array irradiance calculations at a given time */
+typedef struct s_solar_time {
+	DATETIME dt; ///< local time
+	short doy; ///< day of year
+	double solar_time; ///< solar time at the climate location (h)
+	DATETIME solpos_dt; ///< local time used by solpos (TMY2 samples are offset by half an hour)
+} SOLARTIME;
+
 class climate : public gld_object 
 {
 	
@@ -208,6 +236,7 @@ private:
 	tmy2_reader *file;
 	weather_reader *reader_hndl;
 	TMYDATA *tmy;
+	SOLARIRRADIANCE *irradiance_list; ///< plane-of-array irradiance groups updated every timestep
 public:
 	enumeration reader_type;
 	static CLASS *oclass;
@@ -218,6 +247,10 @@ public:
 	void init_cloud_pattern(void);
 	void update_cloud_pattern(TIMESTAMP dt);
 	int get_solar_for_location(double latitude, double longitude, double *direct, double *global, double *diffuse);
+	void get_solar_time(TIMESTAMP t, SOLARTIME *st);
+	void get_solar_irradiance(const SOLARTIME *st, enumeration model, double tilt, double orientation, double latitude, double longitude, double value[2]);
+	double *register_solar_irradiance(enumeration model, double tilt, double orientation, double latitude, double longitude);
+	void update_solar_irradiance(TIMESTAMP t);
 private:
 	int calc_cloud_pattern_size(std::vector<std::vector<double> > &location_list);
 	void build_cloud_pattern(int col_min, int col_max, int row_min, int row_max);
@@ -7,8 +7,59 @@
 
 #include "climate.h"
 
+#include <stddef.h>
+#include <ctype.h>
+#include <errno.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 CLASS *csv_reader::oclass = 0;
 
+/* location of each CSV field in the weather class */
+static size_t field_offset[_CF_COUNT] = {
+	offsetof(weather,temperature),
+	offsetof(weather,humidity),
+	offsetof(weather,solar_dir),
+	offsetof(weather,solar_diff),
+	offsetof(weather,solar_global),
+	offsetof(weather,global_horizontal_extra),
+	offsetof(weather,wind_speed),
+	offsetof(weather,wind_dir),
+	offsetof(weather,opq_sky_cov),
+	offsetof(weather,tot_sky_cov),
+	offsetof(weather,rainfall),
+	offsetof(weather,snowdepth),
+	offsetof(weather,pressure),
+};
+
+/* sample keys pack month/day/hour/minute/second so they sort in time order */
+#define KEY_PACK(M,D,h,m,s) ((uint32)(((((((M)<<5)|(D))<<5)|(h))<<6|(m))<<6|(s)))
+#define KEY_MONTH(K) (((K)>>22)&0x0f)
+#define KEY_DAY(K) (((K)>>17)&0x1f)
+#define KEY_HOUR(K) (((K)>>12)&0x1f)
+#define KEY_MINUTE(K) (((K)>>6)&0x3f)
+#define KEY_SECOND(K) ((K)&0x3f)
+/* seconds used to check that samples advance in time (months are taken to be 31 days) */
+#define KEY_SECONDS(K) ((int64)KEY_MONTH(K)*31*24*60*60 + KEY_DAY(K)*24*60*60 + KEY_HOUR(K)*60*60 + KEY_MINUTE(K)*60 + KEY_SECOND(K))
+
+/* cache file header, followed by the sample keys and the data of each field present (in field order) */
+#define CSV_CACHE_MAGIC "GLDCSV02"
+typedef struct s_csvcache {
+	char magic[8]; /* CSV_CACHE_MAGIC */
+	int64 source_size; /* size of the CSV file the cache was built from */
+	int64 source_mtime; /* modification time of the CSV file the cache was built from */
+	char timefmt[sizeof(char32)+7]; /* time format used to read the CSV file (padded to 8 bytes) */
+	char timezone[64]; /* timezone in effect when the CSV file was read */
+	char columns[1024]; /* column header in the order the columns were read */
+	uint32 fields; /* bit mask of the fields present */
+	uint32 reserved;
+	int64 sample_ct; /* number of samples */
+} CSVCACHE;
+
 EXPORT int create_csv_reader(OBJECT **obj, OBJECT *parent)
 {
 	*obj = gl_create_object(csv_reader::oclass);
@@ -35,6 +86,26 @@ csv_reader::csv_reader()
 	memset((void*)this, 0, sizeof(csv_reader));
 }
 
+csv_reader::~csv_reader()
+{
+#ifndef _WIN32
+	if ( cache_map != NULL )
+	{
+		munmap(cache_map,cache_size);
+		cache_map = NULL;
+		sample_key = NULL;
+		memset(sample_data,0,sizeof(sample_data));
+	}
+#endif
+	free(sample_key);
+	for ( int f = 0 ; f < _CF_COUNT ; f++ )
+	{
+		free(sample_data[f]);
+	}
+	free(columns);
+	free(column_field);
+}
+
 csv_reader::csv_reader(MODULE *module)
 {
 	if (oclass==NULL)
@@ -61,13 +132,17 @@ csv_reader::csv_reader(MODULE *module)
 			PT_double,"timezone_offset",PADDR(tz_numval), PT_DESCRIPTION, "timezone offset",
 			PT_char256,"columns",PADDR(columns_str), PT_DESCRIPTION, "column names",
 			PT_char256,"filename",PADDR(filename), PT_DESCRIPTION, "filename",
+			PT_char256,"cachefile",PADDR(cachefile), PT_DESCRIPTION, "indexed cache of the CSV data (created or refreshed as needed)",
 			NULL)<1) GL_THROW("unable to publish properties in %s",__FILE__);
 		memset((void*)this,0,sizeof(csv_reader));
 	}
 }
 
 /**
-	Open a CSV file and parse it as
+	Open a CSV file and parse it as weather data.  If a cache file is given and 
+	it is up to date with the CSV file, the samples are mapped from the cache 
+	instead of being parsed.  Note that property lines must precede the data 
+	lines when a cache is used.
  **/
 int csv_reader::open(const char *file)
 {
@@ -75,9 +150,7 @@ int csv_reader::open(const char *file)
 	char filename[128];
 	int has_cols = 0;
 	int linenum = 0;
-	int i = 0;
 	OBJECT *obj = THISOBJECTHDR;
-	weather *wtr = 0;
 
 	if ( file == 0 ) 
 	{
@@ -89,6 +162,18 @@ int csv_reader::open(const char *file)
 		return 0;
 	}
 
+#ifdef _WIN32
+	if ( cachefile[0] != '\0' )
+	{
+		gl_warning("csv_reader::open ~ cachefile '%s' is not supported on Windows and will be ignored", cachefile.get_string());
+		/* TROUBLESHOOT
+			The CSV weather cache is memory-mapped and is only available on POSIX systems.
+			The CSV file is parsed on every run instead.  Remove the cachefile property to
+			suppress this warning.
+		*/
+		cachefile[0] = '\0';
+	}
+#endif
 	strncpy(filename, file, 127);
 	infile = fopen(filename, "r");
 	if ( infile == 0 ) 
@@ -150,6 +235,11 @@ int csv_reader::open(const char *file)
 		} 
 		else 
 		{
+			if ( sample_ct == 0 && cachefile[0] != '\0' && load_cache(cachefile, filename) )
+			{
+				gl_verbose("csv_reader::open ~ using %ld samples from cache '%s'", sample_ct, cachefile.get_string());
+				break;
+			}
 			int line_rv = read_line(line, linenum);
 			if ( 0 == line_rv ) 
 			{
@@ -168,14 +258,22 @@ int csv_reader::open(const char *file)
 			}
 		}
 	}
+	fclose(infile);
+	infile = NULL;
 
-	/* move list into double pointer */
-	samples = (weather**)malloc(sizeof(weather *) * (size_t) sample_ct);
-	for ( i = 0, wtr = weather_root; i < sample_ct && wtr != NULL; ++i, wtr=wtr->next )
+	if ( sample_ct == 0 )
+	{
+		gl_error("csv_reader::open ~ no weather samples found in '%s'", file);
+		/* TROUBLESHOOT
+			The CSV file does not contain any data line that could be used.  Please check
+			the CSV file and re-run GridLAB-D.
+		*/
+		return 0;
+	}
+	if ( cachefile[0] != '\0' && cache_map == NULL )
 	{
-		samples[i] = wtr;
+		save_cache(cachefile, filename);
 	}
-	sample_ct = i; // if wtr was the limiting factor, truncate the count
 
 //	index = -1;	// forces to start on zero-eth index
 
@@ -187,6 +285,140 @@ int csv_reader::open(const char *file)
 	return 1;
 }
 
+/* get the cache header expected for a CSV source file */
+static int get_cache_header(CSVCACHE *hdr, const char *source, const char *timefmt, const char *columns, uint32 fields, int64 sample_ct)
+{
+	struct stat info;
+	if ( stat(source,&info) != 0 )
+	{
+		return 0;
+	}
+	memset(hdr,0,sizeof(CSVCACHE));
+	memcpy(hdr->magic,CSV_CACHE_MAGIC,sizeof(hdr->magic));
+	hdr->source_size = (int64)info.st_size;
+	hdr->source_mtime = (int64)info.st_mtime;
+	strncpy(hdr->timefmt,timefmt,sizeof(hdr->timefmt)-1);
+	gld_global("timezone_locale").to_string(hdr->timezone,sizeof(hdr->timezone)-1);
+	memcpy(hdr->columns,columns,strnlen(columns,sizeof(hdr->columns)-1));
+	hdr->fields = fields;
+	hdr->sample_ct = sample_ct;
+	return 1;
+}
+
+/* get the size of the sample keys in the cache (padded to keep the data aligned) */
+static size_t get_cache_keysize(int64 sample_ct)
+{
+	return ((size_t)sample_ct*sizeof(uint32)+sizeof(double)-1)/sizeof(double)*sizeof(double);
+}
+
+/**
+	Map the samples from a cache file.  Returns 0 if the cache does not exist or
+	is not up to date with the source, in which case the source must be parsed.
+ **/
+int csv_reader::load_cache(const char *cache, const char *source)
+{
+#ifdef _WIN32 // cache is not used on Windows (see open)
+	return 0;
+#else
+	CSVCACHE expect;
+	struct stat info;
+	if ( !get_cache_header(&expect,source,timefmt,column_names,field_mask,0) || stat(cache,&info) != 0 || (size_t)info.st_size < sizeof(CSVCACHE) )
+	{
+		return 0;
+	}
+	int fd = ::open(cache,O_RDONLY);
+	if ( fd < 0 )
+	{
+		return 0;
+	}
+	void *map = mmap(NULL,(size_t)info.st_size,PROT_READ,MAP_SHARED,fd,0);
+	close(fd);
+	if ( map == MAP_FAILED )
+	{
+		return 0;
+	}
+	CSVCACHE *hdr = (CSVCACHE*)map;
+	expect.sample_ct = hdr->sample_ct;
+	int n_fields = 0;
+	for ( int f = 0 ; f < _CF_COUNT ; f++ )
+	{
+		if ( field_mask&(1<<f) ) n_fields++;
+	}
+	if ( memcmp(hdr,&expect,sizeof(CSVCACHE)) != 0 || hdr->sample_ct <= 0
+		|| (size_t)info.st_size != sizeof(CSVCACHE) + get_cache_keysize(hdr->sample_ct) + (size_t)hdr->sample_ct*n_fields*sizeof(double) )
+	{
+		gl_verbose("csv_reader::load_cache ~ cache '%s' does not match '%s' and will be rebuilt", cache, source);
+		munmap(map,(size_t)info.st_size);
+		return 0;
+	}
+	sample_ct = sample_max = (long int)hdr->sample_ct;
+	sample_key = (uint32*)(hdr+1);
+	double *data = (double*)((char*)sample_key + get_cache_keysize(sample_ct));
+	for ( int f = 0 ; f < _CF_COUNT ; f++ )
+	{
+		if ( field_mask&(1<<f) )
+		{
+			free(sample_data[f]);
+			sample_data[f] = data;
+			data += sample_ct;
+		}
+	}
+	cache_map = map;
+	cache_size = (size_t)info.st_size;
+	return 1;
+#endif
+}
+
+/**
+	Save the samples to a cache file.  Failures are not fatal since the samples
+	have already been read from the source.
+ **/
+int csv_reader::save_cache(const char *cache, const char *source)
+{
+#ifdef _WIN32 // cache is not used on Windows (see open)
+	return 0;
+#else
+	CSVCACHE hdr;
+	char tmpname[1024];
+	if ( !get_cache_header(&hdr,source,timefmt,column_names,field_mask,sample_ct) )
+	{
+		return 0;
+	}
+	snprintf(tmpname,sizeof(tmpname),"%s-%d",cache,getpid());
+	FILE *fp = fopen(tmpname,"wb");
+	if ( fp == NULL )
+	{
+		gl_warning("csv_reader::save_cache ~ unable to create cache '%s' (%s)", cache, strerror(errno));
+		/* TROUBLESHOOT
+			The cache file for the CSV weather data could not be written.  The simulation
+			will continue but the CSV file will be parsed again next time.  Check that the
+			cache file location is writable.
+		*/
+		return 0;
+	}
+	static const char pad[sizeof(double)] = {0};
+	size_t keysize = sample_ct*sizeof(uint32);
+	bool ok = fwrite(&hdr,sizeof(hdr),1,fp) == 1
+		&& fwrite(sample_key,sizeof(uint32),sample_ct,fp) == (size_t)sample_ct
+		&& fwrite(pad,1,get_cache_keysize(sample_ct)-keysize,fp) == get_cache_keysize(sample_ct)-keysize;
+	for ( int f = 0 ; ok && f < _CF_COUNT ; f++ )
+	{
+		if ( field_mask&(1<<f) )
+		{
+			ok = fwrite(sample_data[f],sizeof(double),sample_ct,fp) == (size_t)sample_ct;
+		}
+	}
+	if ( fclose(fp) != 0 || !ok || rename(tmpname,cache) != 0 )
+	{
+		gl_warning("csv_reader::save_cache ~ unable to write cache '%s' (%s)", cache, strerror(errno));
+		unlink(tmpname);
+		return 0;
+	}
+	gl_verbose("csv_reader::save_cache ~ saved %ld samples to cache '%s'", sample_ct, cache);
+	return 1;
+#endif
+}
+
 int csv_reader::read_prop(char *line)
 { 
 	char *split = strchr(line, '=');
@@ -328,6 +560,7 @@ int csv_reader::read_header(char *line )
 	//	find properties for each column header
 	temp = first;
 	columns = (PROPERTY **)malloc(sizeof(PROPERTY *) * (size_t)column_ct);
+	column_field = (int *)malloc(sizeof(int) * (size_t)column_ct);
 	while ( temp != 0 && i < column_ct ) 
 	{
 		temp->column = gl_find_property(weather::oclass, temp->name);
@@ -341,126 +574,270 @@ int csv_reader::read_header(char *line )
 			return 0;
 		}
 		columns[i] = temp->column;
+		column_field[i] = -1;
+		size_t len = strlen(column_names);
+		if ( len+strlen(temp->name)+2 < sizeof(column_names) )
+		{
+			if ( len > 0 ) column_names[len++] = ',';
+			strcpy(column_names+len,temp->name);
+		}
+		if ( temp->column->ptype == PT_double )
+		{
+			for ( int f = 0 ; f < _CF_COUNT ; f++ )
+			{
+				if ( (size_t)temp->column->addr == field_offset[f] )
+				{
+					column_field[i] = f;
+					field_mask |= (1<<f);
+					break;
+				}
+			}
+		}
 		temp = temp->next;
 		++i;
 	}
 	return 1;
 }
 
+/* get the next token in place, skipping leading delimiters the way strtok does */
+static char *next_token(char **next, const char *delim)
+{
+	char *p = *next;
+	while ( *p != '\0' && strchr(delim,*p) != NULL )
+	{
+		p++;
+	}
+	if ( *p == '\0' )
+	{
+		*next = p;
+		return NULL;
+	}
+	char *token = p;
+	while ( *p != '\0' && strchr(delim,*p) == NULL )
+	{
+		p++;
+	}
+	if ( *p != '\0' )
+	{
+		*p++ = '\0';
+	}
+	*next = p;
+	return token;
+}
+
+/* read a time of the form 'MM:dd:hh:mm:ss' (or a leading part of it) without scanf, 
+   returns the number of parts read or -1 if the token has some other form */
+static int read_time(const char *token, short part[5])
+{
+	const char *p = token;
+	int n;
+	if ( strchr(token,':') == NULL )
+	{
+		return -1;
+	}
+	for ( n = 0 ; n < 5 ; )
+	{
+		if ( !isdigit(*p) )
+		{
+			return -1;
+		}
+		int value = 0;
+		while ( isdigit(*p) )
+		{
+			value = value*10 + (*p++ - '0');
+		}
+		part[n++] = (short)value;
+		if ( *p != ':' )
+		{
+			break;
+		}
+		p++;
+	}
+	return *p == '\0' ? n : -1;
+}
+
+/* add room for a new sample with the given key */
+int csv_reader::add_sample(uint32 key)
+{
+	if ( sample_ct == sample_max )
+	{
+		long int size = sample_max>0 ? sample_max*2 : 1024;
+		uint32 *keys = (uint32*)realloc(sample_key,sizeof(uint32)*size);
+		if ( keys == NULL )
+		{
+			return 0;
+		}
+		sample_key = keys;
+		for ( int f = 0 ; f < _CF_COUNT ; f++ )
+		{
+			if ( field_mask&(1<<f) )
+			{
+				double *data = (double*)realloc(sample_data[f],sizeof(double)*size);
+				if ( data == NULL )
+				{
+					return 0;
+				}
+				sample_data[f] = data;
+			}
+		}
+		sample_max = size;
+	}
+	sample_key[sample_ct] = key;
+	for ( int f = 0 ; f < _CF_COUNT ; f++ )
+	{
+		if ( sample_data[f] != NULL )
+		{
+			sample_data[f][sample_ct] = 0.0;
+		}
+	}
+	return 1;
+}
+
 int csv_reader::read_line(char *line, int linenum ) 
 {
 	int col = 0;
-	char buffer[1024];
-	char *token = 0;
-	weather *sample = 0;
-	int64 t1, t2;
-//	OBJECT *my = 0;
-
-	strncpy(buffer, line, 1023);
-	char *last;
-	token = strtok_r(buffer, " ,\t\n\r",&last);
+	char *next = line;
+	char *token = next_token(&next, " ,\t\n\r");
+	short part[5] = {0,0,0,0,0};
 
 	if ( token == 0 ) {
 		return 2; // blank line 
 	}
 
-	sample = new weather();
-
 	if ( timefmt[0] == 0 ) 
 	{
-		TIMESTAMP ts = callback->time.convert_to_timestamp(token);
-		DATETIME dt;
-		dt.nanosecond = 0;
-		if ( ts!=TS_INVALID && ts!=TS_NEVER && callback->time.local_datetime(ts,&dt) )
+		if ( read_time(token, part) > 0 )
 		{
-			 sample->month = dt.month;
-			 sample->day = dt.day;
-			 sample->hour = dt.hour;
-			 sample->minute = dt.minute;
-			 sample->second = dt.second;
-			 // IMPORTANT NOTE: if DST is not handled properly by sample, don't try to fix
-			 // the problem here.  The weather class may need to be fixed so it uses UTC internally.
+			// fast path for the usual 'MM:dd:hh:mm:ss' form
 		}
-		else if ( sscanf(token, "%hd:%hd:%hd:%hd:%hd", &sample->month, &sample->day, &sample->hour, &sample->minute, &sample->second) < 1 ) 
+		else
 		{
-			gl_error("csv_reader::read_line ~ unable to read time string \'%s\' with default format", token);
-			/* TROUBLESHOOT
-				The input timestamp could not be parsed.  Verify that all time strings are formatted
-				as 'MM:dd:hh:mm:ss', 'MM:dd:hh:mm', 'MM:dd:hh', 'MM:dd', or 'MM'.
-			*/
-			delete sample;
-			return 0;
+			TIMESTAMP ts = callback->time.convert_to_timestamp(token);
+			DATETIME dt;
+			dt.nanosecond = 0;
+			if ( ts!=TS_INVALID && ts!=TS_NEVER && callback->time.local_datetime(ts,&dt) )
+			{
+				part[0] = dt.month;
+				part[1] = dt.day;
+				part[2] = dt.hour;
+				part[3] = dt.minute;
+				part[4] = dt.second;
+				// IMPORTANT NOTE: if DST is not handled properly by sample, don't try to fix
+				// the problem here.  The weather class may need to be fixed so it uses UTC internally.
+			}
+			else if ( sscanf(token, "%hd:%hd:%hd:%hd:%hd", &part[0], &part[1], &part[2], &part[3], &part[4]) < 1 ) 
+			{
+				gl_error("csv_reader::read_line ~ unable to read time string \'%s\' with default format", token);
+				/* TROUBLESHOOT
+					The input timestamp could not be parsed.  Verify that all time strings are formatted
+					as 'MM:dd:hh:mm:ss', 'MM:dd:hh:mm', 'MM:dd:hh', 'MM:dd', or 'MM'.
+				*/
+				return 0;
+			}
 		}
 	} 
 	else 
 	{
-		if ( sscanf(token, timefmt.get_string(), &sample->month, &sample->day, &sample->hour, &sample->minute, &sample->second) < 1 ) 
+		if ( sscanf(token, timefmt.get_string(), &part[0], &part[1], &part[2], &part[3], &part[4]) < 1 ) 
 		{
 			gl_error("csv_reader::read_line ~ unable to read time string \'%s\' with format \'%s\'", token, timefmt.get_string());
 			/* TROUBLESHOOT
 				The input timestamp could not be parsed using the specified time format.  Please
 				review the specified file's time format and input time strings.
 			*/
-			delete sample;
 			return 0;
 		}
 	}
+	if ( part[0] < 0 || part[0] > 12 || part[1] < 0 || part[1] > 31 || part[2] < 0 || part[2] > 24 || part[3] < 0 || part[3] > 60 || part[4] < 0 || part[4] > 60 )
+	{
+		gl_error("csv_reader::read_line ~ time string \'%s\' is out of range", token);
+		/* TROUBLESHOOT
+			The input timestamp was read but the month, day, hour, minute, or second is out of 
+			range.  Please review the time strings in the CSV file.
+		*/
+		return 0;
+	}
+	uint32 key = KEY_PACK(part[0],part[1],part[2],part[3],part[4]);
 
-	if ( weather_last != 0 ) 
+	if ( sample_ct > 0 && KEY_SECONDS(sample_key[sample_ct-1]) >= KEY_SECONDS(key) ) 
 	{
-		t1 = weather_last->month * 31*24*60*60 +
-			 weather_last->day * 24*60*60 +
-			 weather_last->hour * 60*60 +
-			 weather_last->minute * 60 +
-			 weather_last->second;
-		t2 = sample->month * 31*24*60*60 +
-			 sample->day * 24*60*60 +
-			 sample->hour * 60*60 +
-			 sample->minute * 60 +
-			 sample->second;
-		if ( t1 >= t2 ) {
-			gl_warning("csv_reader::read_line ~ sample on line %i does not advance in time and has been discarded", linenum);
-			delete sample;
-			return 2;
-		}
+		gl_warning("csv_reader::read_line ~ sample on line %i does not advance in time and has been discarded", linenum);
+		return 2;
 	}
 
-	while ( (token=strtok_r(NULL, ",\n\r",&last)) != 0 && col < column_ct ) 
+	if ( ! add_sample(key) )
 	{
-		if ( columns[col]->ptype == PT_double ) 
+		gl_error("csv_reader::read_line ~ memory allocation failed on line %i", linenum);
+		return 0;
+	}
+	while ( (token=next_token(&next, ",\n\r")) != 0 && col < column_ct ) 
+	{
+		if ( column_field[col] >= 0 ) 
 		{
-			double *dptr = (double *)((uint64)(columns[col]->addr) + (uint64)(sample));
-			if ( sscanf(token, "%lg", dptr) != 1 ) 
+			char *end;
+			double value = strtod(token, &end);
+			if ( end == token ) 
 			{
 				gl_error("csv_reader::read_line ~ unable to set value \'%s\' to double property \'%s\'", token, columns[col]->name);
 				/* TROUBLESHOOT
 					The specified property value could not be parsed as a number.  Please check
 					the CSV file for non-numeric characters in the data fields on that line.
 				*/
-				delete sample;
 				return 0;
 			}
+			sample_data[column_field[col]][sample_ct] = value;
 		}
 		++col;
 	}
 
-	if ( weather_root == 0 ) 
+	return 1;
+}
+
+/**
+	Find the index of the sample in effect at a time, i.e., the sample before 
+	the first sample at or after that time.  Returns -1 if the time is before 
+	the first sample.
+ **/
+long int csv_reader::find_index(DATETIME *dt) const
+{
+	uint32 key = KEY_PACK(dt->month,dt->day,dt->hour,dt->minute,dt->second);
+	long int lo = 0, hi = sample_ct;
+	while ( lo < hi )
 	{
-		weather_root = sample;
-	} 
-	else 
+		long int mid = lo + (hi-lo)/2;
+		if ( sample_key[mid] < key )
+		{
+			lo = mid+1;
+		}
+		else
+		{
+			hi = mid;
+		}
+	}
+	// skip leap days on non-leap years
+	while ( lo < sample_ct && !ISLEAPYEAR(dt->year) && KEY_MONTH(sample_key[lo]) == 2 && KEY_DAY(sample_key[lo]) == 29 )
 	{
-		weather_last->next = sample;
+		lo++;
 	}
-	weather_last = sample;
+	return lo<sample_ct ? lo-1 : sample_ct-1;
+}
 
-	return 1;
+/* get the date/time of a sample (year and timezone are not set) */
+void csv_reader::get_datetime(long int n, DATETIME *dt) const
+{
+	uint32 key = sample_key[n];
+	dt->month = KEY_MONTH(key);
+	dt->day = KEY_DAY(key);
+	dt->hour = KEY_HOUR(key);
+	dt->minute = KEY_MINUTE(key);
+	dt->second = KEY_SECOND(key);
+	dt->nanosecond = 0;
 }
 
 TIMESTAMP csv_reader::get_data(TIMESTAMP t0, double *temp, double *humid, double *direct, double *diffuse, double *global, double *extra_global,  double *wind,double *winddir, double *opaque, double *total, double *rain, double *snow, double *pressure ) 
 {
 	DATETIME now, then;
-//	TIMESTAMP until;
+	double *value[_CF_COUNT] = {temp,humid,direct,diffuse,global,extra_global,wind,winddir,opaque,total,rain,snow,pressure};
 	int next_year = 0;
 	int start = index;
 	now.nanosecond = 0;
@@ -475,99 +852,20 @@ TIMESTAMP csv_reader::get_data(TIMESTAMP t0, double *temp, double *humid, double
 	gl_debug("csv_reader::get_data start");
 	if ( next_ts == 0 ) {
 		//	initialize to the correct index & next_ts
-		DATETIME guess_dt;
-		guess_dt.nanosecond = 0;
-		TIMESTAMP guess_ts;
-		int i;
-#if 0
-		/*	This method worked until it was realized that if there are January entries
-		 *	at the end of a full-year would be caught by the going-backwards method.
-		 *	This led to some strange results.
-		 */
-		for(i = 0; i < sample_ct; ++i ) {
-			guess_dt.year = now.year;
-			guess_dt.month = samples[sample_ct-i-1]->month;
-			guess_dt.day = samples[sample_ct-i-1]->day;
-			guess_dt.hour = samples[sample_ct-i-1]->hour;
-			guess_dt.minute = samples[sample_ct-i-1]->minute;
-			guess_dt.second = samples[sample_ct-i-1]->second;
-			strcpy(guess_dt.tz, now.tz);
-//			strcpy(guess_dt.tz, "GMT");
-			guess_ts = (TIMESTAMP)gl_mktime(&guess_dt);
-
-			if ( guess_ts <= t0 ) {
-				break;
-			}
-		}
-		index = sample_ct - i - 1;
-#endif
-		for ( i = 0; i < sample_ct; ++i ) 
-		{
-			guess_dt.year = now.year;
-			guess_dt.month = samples[i]->month;
-			guess_dt.day = samples[i]->day;
-			guess_dt.hour = samples[i]->hour;
-			guess_dt.minute = samples[i]->minute;
-			guess_dt.second = samples[i]->second;
-			strcpy(guess_dt.tz, now.tz);
-//			strcpy(guess_dt.tz, "GMT");
-			if ( guess_dt.month == 2 && guess_dt.day == 29 ) 
-			{
-				if ( !ISLEAPYEAR(now.year))
-					continue; // skip leap days on non-leap years
-			}
-			guess_ts = (TIMESTAMP)gl_mktime(&guess_dt);
+		index = find_index(&now);
 
-			if ( guess_ts >= t0 ) {
-				i -= 1; // we want the sample *before* this one
-				break;
-			}
-		}
-
-		index = i;
-
-		if ( index > -1 && index < sample_ct ) 
-		{
-			*temp = samples[index]->temperature;
-			*humid = samples[index]->humidity;
-			*direct = samples[index]->solar_dir;
-			*diffuse = samples[index]->solar_diff;
-			*global = samples[index]->solar_global;
-			*extra_global = samples[index]->global_horizontal_extra;
-			*wind = samples[index]->wind_speed;
-      		*winddir = samples[index]->wind_dir;
-			*opaque = samples[index]-> opq_sky_cov;
-			*total = samples[index]-> tot_sky_cov;
-			*rain = samples[index]->rainfall;
-			*snow = samples[index]->snowdepth;
-			*pressure = samples[index]->pressure;
-		} else { // somewhere between the last and the first element
-			*temp = samples[sample_ct - 1]->temperature;
-			*humid = samples[sample_ct - 1]->humidity;
-			*direct = samples[sample_ct - 1]->solar_dir;
-			*diffuse = samples[sample_ct - 1]->solar_diff;
-			*global = samples[sample_ct - 1]->solar_global;
-			*extra_global = samples[sample_ct - 1]->global_horizontal_extra;
-			*wind = samples[sample_ct - 1]->wind_speed;
-      		*winddir = samples[sample_ct - 1]->wind_dir;
-			*opaque = samples[sample_ct - 1]-> opq_sky_cov;
-			*total = samples[sample_ct - 1]-> tot_sky_cov;
-			*rain = samples[sample_ct - 1]->rainfall;
-			*snow = samples[sample_ct - 1]->snowdepth;
-			*pressure = samples[sample_ct - 1]->pressure;
+		// somewhere between the last and the first element uses the last element
+		long int n = ( index > -1 ? index : sample_ct - 1 );
+		for ( int f = 0 ; f < _CF_COUNT ; f++ )
+		{
+			*value[f] = get_value(n,(CSVFIELD)f);
 		}
 
+		get_datetime((index+1)%sample_ct,&then);
 		then.year = now.year + (index+1 == sample_ct ? 1 : 0);
-		then.month = samples[(index+1)%sample_ct]->month;
-		then.day = samples[(index+1)%sample_ct]->day;
-		then.hour = samples[(index+1)%sample_ct]->hour;
-		then.minute = samples[(index+1)%sample_ct]->minute;
-		then.second = samples[(index+1)%sample_ct]->second;
-		then.nanosecond = 0;
 		strcpy(then.tz, now.tz);
 
 		next_ts = (TIMESTAMP)gl_mktime(&then);
-		//next_ts = (TIMESTAMP)gl_mktime(&then);
 
 		return -next_ts;
 	}
@@ -599,12 +897,8 @@ TIMESTAMP csv_reader::get_data(TIMESTAMP t0, double *temp, double *humid, double
 			next_year = 0;
 		}
 
+		get_datetime((index+1)%sample_ct,&then);
 		then.year = now.year + next_year;
-		then.month = samples[(index+1)%sample_ct]->month;
-		then.day = samples[(index+1)%sample_ct]->day;
-		then.hour = samples[(index+1)%sample_ct]->hour;
-		then.minute = samples[(index+1)%sample_ct]->minute;
-		then.second = samples[(index+1)%sample_ct]->second;
 		if ( then.month == 2 && then.day == 29 ) 
 		{
 			if ( !ISLEAPYEAR(then.year))
@@ -618,19 +912,10 @@ TIMESTAMP csv_reader::get_data(TIMESTAMP t0, double *temp, double *humid, double
 		next_ts = (TIMESTAMP)gl_mktime(&then);
 	} while (next_ts < t0 && index != start); // skip samples that try to reverse the time
 	
-	*temp = samples[index]->temperature;
-	*humid = samples[index]->humidity;
-	*direct = samples[index]->solar_dir;
-	*diffuse = samples[index]->solar_diff;
-	*global = samples[index]->solar_global;
-	*extra_global = samples[index]->global_horizontal_extra;
-	*wind = samples[index]->wind_speed;
-	*winddir = samples[index]->wind_dir;
-	*opaque = samples[index]->opq_sky_cov;
-	*total = samples[index]->tot_sky_cov;
-	*rain = samples[index]->rainfall;
-	*snow = samples[index]->snowdepth;
-	*pressure = samples[index]->pressure;
+	for ( int f = 0 ; f < _CF_COUNT ; f++ )
+	{
+		*value[f] = get_value(index,(CSVFIELD)f);
+	}
 
 	// having found the index, update the data
 	if ( index == start ) 
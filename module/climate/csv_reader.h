@@ -17,12 +17,39 @@
 	@addtogroup csv CSV weather data
 	@ingroup climate
 
-	Opens a CSV files for reading and reads in the weather data.  Packs the data into
-	a malloc'ed pointer array for later retrieval.
+	Opens a CSV files for reading and reads in the weather data.  The samples are
+	packed into a columnar store (one array per weather field) with a packed
+	month/day/hour/minute/second key for each sample, so the current sample can
+	be found by binary search.  When a cache file is given, the columnar store is
+	saved to it and later runs map it directly instead of parsing the CSV data.
 **/
 
+/** Weather fields that can be read from a CSV file */
+typedef enum {
+	CF_TEMPERATURE=0,
+	CF_HUMIDITY,
+	CF_SOLAR_DIRECT,
+	CF_SOLAR_DIFFUSE,
+	CF_SOLAR_GLOBAL,
+	CF_GLOBAL_HORIZONTAL_EXTRA,
+	CF_WIND_SPEED,
+	CF_WIND_DIR,
+	CF_OPAQUE_SKY_COVER,
+	CF_TOTAL_SKY_COVER,
+	CF_RAINFALL,
+	CF_SNOWDEPTH,
+	CF_PRESSURE,
+	_CF_COUNT,
+} CSVFIELD;
+
 class csv_reader : public weather_reader {
 private:
+	double get_value(long int n, CSVFIELD field) const { return sample_data[field] ? sample_data[field][n] : 0.0; };
+	long int find_index(DATETIME *dt) const;
+	void get_datetime(long int n, DATETIME *dt) const;
+	int add_sample(uint32 key);
+	int load_cache(const char *cache, const char *source);
+	int save_cache(const char *cache, const char *source);
 protected:
 	int read_prop(char *);
 	int read_header(char *);
@@ -30,8 +57,16 @@ protected:
 
 	int column_ct;
 	PROPERTY **columns;
+	int *column_field; /* weather field of each column (-1 if not read) */
+	uint32 field_mask; /* weather fields present in the file */
+	char column_names[1024]; /* column names in the order they are read (part of the cache key) */
 	TIMESTAMP last_ts; /* time on the last read line */
-	weather *weather_root, *weather_last;
+
+	uint32 *sample_key; /* packed month/day/hour/minute/second of each sample */
+	double *sample_data[_CF_COUNT]; /* columnar samples (NULL if field is not in file) */
+	long int sample_max; /* allocated size of sample arrays */
+	void *cache_map; /* mapped cache file (NULL if samples are malloc'ed) */
+	size_t cache_size; /* size of mapped cache file */
 
 public:
 	csv_reader();
@@ -42,7 +77,6 @@ public:
 
 	long int index;
 	TIMESTAMP next_ts;
-	weather **samples;
 	long int sample_ct;
 
 	char32 city_name;
@@ -60,6 +94,7 @@ public:
 	char32 timefmt;
 	char256 columns_str;
 	char256 filename;
+	char256 cachefile;
 	typedef enum {
 		CR_INIT,
 		CR_OPEN,
@@ -0,0 +1,46 @@
+# checks that the recordings of test_deltamode_region_rate.glm with held regions
+# match the reference run and that object updates were actually held
+# syntax: python3 test_deltamode_region_rate.py EXPECTED_FOLDER ACTUAL_FOLDER FILE ...
+import os, re, sys
+
+TOLERANCE = 1e-3 # held regions are integrated over longer timesteps
+
+def read_data(name):
+	data = []
+	with open(name) as fh:
+		for line in fh:
+			if line.startswith("#"):
+				continue
+			row = line.strip().split(",")
+			data.append([row[0]]+[float(value.split()[0]) for value in row[1:]])
+	return data
+
+def read_held(folder):
+	with open(os.path.join(folder,"deltamode_region_model.pro")) as fh:
+		for line in fh:
+			match = re.search(r"Deltamode held\s+([0-9]+)",line)
+			if match:
+				return int(match.group(1))
+	return 0
+
+expected, actual = sys.argv[1:3]
+if read_held(expected) != 0:
+	print(f"{expected} held object updates with deltamode_region_rate=0",file=sys.stderr)
+	sys.exit(1)
+if read_held(actual) == 0:
+	print(f"{actual} did not hold any object updates",file=sys.stderr)
+	sys.exit(1)
+for name in sys.argv[3:]:
+	a = read_data(os.path.join(expected,name))
+	b = read_data(os.path.join(actual,name))
+	if len(a) == 0 or len(a) != len(b):
+		print(f"{actual}/{name} has {len(b)} records instead of {len(a)}",file=sys.stderr)
+		sys.exit(1)
+	for x, y in zip(a,b):
+		if x[0] != y[0] or len(x) != len(y):
+			print(f"{actual}/{name} record '{y[0]}' does not match '{x[0]}'",file=sys.stderr)
+			sys.exit(1)
+		for u, v in zip(x[1:],y[1:]):
+			if abs(u-v) > TOLERANCE*max(abs(u),abs(v)):
+				print(f"{actual}/{name} value {v} at {y[0]} differs from {u}",file=sys.stderr)
+				sys.exit(1)
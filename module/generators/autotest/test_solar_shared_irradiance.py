@@ -0,0 +1,17 @@
+# checks the output of test_solar_shared_irradiance.glm
+import sys
+
+with open("insolation.csv") as fh:
+	rows = [line.strip().split(",") for line in fh if not line.startswith("#")]
+
+if not any(float(row[1]) > 0 for row in rows):
+	print("pv_1 received no insolation", file=sys.stderr)
+	sys.exit(1)
+for row in rows:
+	pv1, pv2, pv3 = map(float, row[1:4])
+	if pv1 != pv2:
+		print(f"{row[0]}: pv_1 and pv_2 insolation differ ({pv1} != {pv2})", file=sys.stderr)
+		sys.exit(1)
+	if pv3 > pv1:
+		print(f"{row[0]}: shaded pv_3 insolation exceeds pv_1 ({pv3} > {pv1})", file=sys.stderr)
+		sys.exit(1)
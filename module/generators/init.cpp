@@ -265,15 +265,23 @@ EXPORT SIMULATIONMODE interupdate(MODULE *module, TIMESTAMP t0, unsigned int64 d
 		//Loop through the object list and call the updates
 		for (curr_object_number=0; curr_object_number<gen_object_count; curr_object_number++)
 		{
+			//Objects in quiescent deltamode regions keep their state this timestep
+			if (gl_delta_region_held(delta_objects[curr_object_number]))
+				continue;
+
 			//See if we're in service or not
 			if ((delta_objects[curr_object_number]->in_svc_double <= gl_globaldeltaclock) && (delta_objects[curr_object_number]->out_svc_double >= gl_globaldeltaclock))
 			{
 				//Call the actual function
-				function_status = ((SIMULATIONMODE (*)(OBJECT *, unsigned int64, unsigned long, unsigned int))(*delta_functions[curr_object_number]))(delta_objects[curr_object_number],delta_time,dt,iteration_count_val);
+				//Objects in a region that was held catch up over the time elapsed since their last update
+				function_status = ((SIMULATIONMODE (*)(OBJECT *, unsigned int64, unsigned long, unsigned int))(*delta_functions[curr_object_number]))(delta_objects[curr_object_number],delta_time,gl_delta_region_timestep(delta_objects[curr_object_number],dt),iteration_count_val);
 			}
 			else //Not in service - off to event mode
 				function_status = SM_EVENT;
 
+			//Keep the object's region active if it wants deltamode
+			gl_delta_region_report(delta_objects[curr_object_number],function_status);
+
 			//Determine what our return is
 			if (function_status == SM_DELTA)
 			{
@@ -719,7 +719,6 @@ int inverter::create(void)
 int inverter::init(OBJECT *parent)
 {
 	OBJECT *obj = THISOBJECTHDR;
-	PROPERTY *pval;
 	bool *dyn_gen_posting;
 	double *temp_nominal_pointer;
 	unsigned iindex, jindex;
@@ -793,11 +792,9 @@ int inverter::init(OBJECT *parent)
 		}
 
 		//Map phases
-		set *phaseInfo = NULL;
-		PROPERTY *tempProp;
-		tempProp = gl_get_property(parent,"phases");
+		set *phaseInfo = get_set(parent,"phases");
 
-		if ((tempProp==NULL || tempProp->ptype!=PT_set))
+		if (phaseInfo==NULL)
 		{
 			GL_THROW("Unable to map phases property - ensure the parent is a meter or triplex_meter");
 			/*  TROUBLESHOOT
@@ -806,8 +803,6 @@ int inverter::init(OBJECT *parent)
 			again.  If the error persists, please submit your code and a bug report via the Trac website.
 			*/
 		}
-		else
-			phaseInfo = (set*)GETADDR(parent,tempProp);
 
 		//Copy in so the code works
 		phases = *phaseInfo;
@@ -859,17 +854,13 @@ int inverter::init(OBJECT *parent)
 		}
 
 		//Map phases
-		set *phaseInfo = NULL;
-		PROPERTY *tempProp;
-		tempProp = gl_get_property(parent,"phases");
+		set *phaseInfo = get_set(parent,"phases");
 
-		if ((tempProp==NULL || tempProp->ptype!=PT_set))
+		if (phaseInfo==NULL)
 		{
 			GL_THROW("Unable to map phases property - ensure the parent is a meter or triplex_meter");
 			//Defined above
 		}
-		else
-			phaseInfo = (set*)GETADDR(parent,tempProp);
 
 		//Copy in so the code works
 		phases = *phaseInfo;
@@ -1811,10 +1802,10 @@ int inverter::init(OBJECT *parent)
 		if (four_quadrant_control_mode == FQM_VSI)
 		{
 			//Map the flag
-			pval = gl_get_property(parent,"Norton_dynamic");
+			dyn_gen_posting = get_bool(parent,"Norton_dynamic");
 
 			//Check it
-			if ((pval==NULL) || (pval->ptype!=PT_bool))
+			if (dyn_gen_posting==NULL)
 			{
 				GL_THROW("inverter:%s failed to map deltamode variable from %s",obj->name?obj->name:"unnamed",parent->name?parent->name:"unnamed");
 				/*  TROUBLESHOOT
@@ -1823,9 +1814,6 @@ int inverter::init(OBJECT *parent)
 				*/
 			}
 
-			//Map to the intermediate
-			dyn_gen_posting = (bool*)GETADDR(parent,pval);
-
 			//Set the flag
 			*dyn_gen_posting = true;
 
@@ -1886,10 +1874,10 @@ int inverter::init(OBJECT *parent)
 	}
 
 	// Check the bustype if the inverter parent
-	pval = gl_get_property(obj->parent,"bustype"); // Obtain VSI parent meter bustype
+	VSI_bustype = (enumeration*)get_enum(obj->parent,"bustype"); // Obtain VSI parent meter bustype
 
 	//Check it
-	if ((pval==NULL) || (pval->ptype!=PT_enumeration))
+	if (VSI_bustype==NULL)
 	{
 		GL_THROW("inverter:%s failed to map bustype variable from %s",obj->name?obj->name:"unnamed",obj->parent->name?obj->parent->name:"unnamed");
 		/*  TROUBLESHOOT
@@ -1898,9 +1886,6 @@ int inverter::init(OBJECT *parent)
 		*/
 	}
 
-	//Map to the intermediate
-	VSI_bustype = (enumeration*)GETADDR(obj->parent,pval);
-
 	//Map the powerflow frequency
 	mapped_freq_variable = (double *)gl_get_module_var(gl_find_module("powerflow"),"current_frequency");
 	//Make sure it isn't empty
@@ -7998,34 +7983,59 @@ complex inverter::complex_exp(double angle)
 	return output_val;
 }
 
-//Retrieves the pointer for a double variable from another object
+//Retrieves the pointer for a property of another object through a class binding
+//Each class and property is resolved once for all inverters (objects are initialized one at a time)
+//and properties that are missing or of the wrong type are remembered without being reported
+static void *get_bound_addr(OBJECT *obj, const char *name, PROPERTYTYPE ptype)
+{
+	static struct s_bound_property {
+		CLASS *oclass;
+		const char *name;
+		PROPERTYTYPE ptype;
+		gld_binding binding;
+	} bound[64];
+	static size_t n_bound = 0;
+	size_t n;
+
+	for (n=0; n<n_bound; n++)
+	{
+		if (bound[n].oclass==obj->oclass && bound[n].ptype==ptype && (bound[n].name==name || strcmp(bound[n].name,name)==0))
+			break;
+	}
+	if (n==n_bound)
+	{
+		if (n_bound==sizeof(bound)/sizeof(bound[0]))
+		{
+			gld_binding binding;
+			return binding.probe(obj->oclass,name,ptype) ? binding.get_addr(obj) : NULL;
+		}
+		bound[n].oclass = obj->oclass;
+		bound[n].name = name;
+		bound[n].ptype = ptype;
+		bound[n].binding.probe(obj->oclass,name,ptype);
+		n_bound++;
+	}
+	return bound[n].binding.is_valid() ? bound[n].binding.get_addr(obj) : NULL;
+}
 double *inverter::get_double(OBJECT *obj, const char *name)
 {
-	PROPERTY *p = gl_get_property(obj,name);
-	if (p==NULL || p->ptype!=PT_double)
-		return NULL;
-	return (double*)GETADDR(obj,p);
+	return (double*)get_bound_addr(obj,name,PT_double);
 }
 bool *inverter::get_bool(OBJECT *obj, const char *name)
 {
-	PROPERTY *p = gl_get_property(obj,name);
-	if (p==NULL || p->ptype!=PT_bool)
-		return NULL;
-	return (bool*)GETADDR(obj,p);
+	return (bool*)get_bound_addr(obj,name,PT_bool);
 }
 int *inverter::get_enum(OBJECT *obj, const char *name)
 {
-	PROPERTY *p = gl_get_property(obj,name);
-	if (p==NULL || p->ptype!=PT_enumeration)
-		return NULL;
-	return (int*)GETADDR(obj,p);
+	return (int*)get_bound_addr(obj,name,PT_enumeration);
 }
 complex * inverter::get_complex(OBJECT *obj, const char *name)
 {
-	PROPERTY *p = gl_get_property(obj,name);
-	if (p==NULL || p->ptype!=PT_complex)
-		return NULL;
-	return (complex*)GETADDR(obj,p);
+	return (complex*)get_bound_addr(obj,name,PT_complex);
+}
+set *inverter::get_set(OBJECT *obj, const char *name)
+{
+	return (set*)get_bound_addr(obj,name,PT_set);
 }
 
 double inverter::getVar(double volt, double m, double b)
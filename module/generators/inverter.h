@@ -448,6 +448,7 @@ public:
 	static CLASS *plcass;
 	complex *get_complex(OBJECT *obj, const char *name);
 	double *get_double(OBJECT *obj, const char *name);
+	set *get_set(OBJECT *obj, const char *name);
 	complex complex_exp(double angle);
 	STATUS init_PI_dynamics(INV_STATE *curr_time);
 	STATUS init_PID_dynamics(void);
@@ -20,6 +20,7 @@
  **/
 
 #include "generators.h"
+#include "module/climate/climate.h"
 
 #define RAD(x) (x*PI)/180
 
@@ -158,6 +159,8 @@ int solar::init_climate()
 {
 	OBJECT *hdr = THISOBJECTHDR;
 	OBJECT *obj = NULL;
+	FUNCTIONADDR register_irradiance = NULL;
+	int64 irradiance_model = SIM_IDEAL;
 
 	// link to climate data
 	FINDLIST *climates = NULL;
@@ -366,9 +369,11 @@ int solar::init_climate()
 
 			// Check the solar method
 			// CDC: This method of determining solar model based on tracking type seemed flawed. They should be independent of each other.
+			// Panels share the climate's plane-of-array irradiance for each distinct model and orientation
+			register_irradiance = (FUNCTIONADDR)(gl_get_function(obj,"register_solar_irradiance"));
 			if (orientation_type == DEFAULT)
 			{
-				calc_solar_radiation = (FUNCTIONADDR)(gl_get_function(obj,"calc_solar_ideal_shading_position_radians"));
+				irradiance_model = SIM_IDEAL;
 			}
 			else if (orientation_type == FIXED_AXIS)
 			{
@@ -376,18 +381,15 @@ int solar::init_climate()
 				if (solar_model_tilt==LIUJORDAN)
 				{
 					//Map up the "classic" function
-					//calc_solar_radiation = (FUNCTIONADDR)(gl_get_function(obj,"calculate_solar_radiation_shading_degrees"));
-					calc_solar_radiation = (FUNCTIONADDR)(gl_get_function(obj,"calculate_solar_radiation_shading_position_radians"));
+					irradiance_model = SIM_LIUJORDAN;
 				}
 				else if (solar_model_tilt==SOLPOS)	//Use the solpos/Perez tilt model
 				{
-					//Map up the "classic" function
-					//calc_solar_radiation = (FUNCTIONADDR)(gl_get_function(obj,"calc_solpos_radiation_shading_degrees"));
-					calc_solar_radiation = (FUNCTIONADDR)(gl_get_function(obj,"calculate_solpos_radiation_shading_position_radians"));
+					irradiance_model = SIM_SOLPOS;
 				}
 								
 				//Make sure it was found
-				if (calc_solar_radiation == NULL)
+				if (register_irradiance == NULL)
 				{
 					GL_THROW("Unable to map solar radiation function on %s in %s",obj->name,hdr->name);
 					/*  TROUBLESHOOT
@@ -451,6 +453,24 @@ int solar::init_climate()
 				}
 			}
 			//Defaulted else for now - don't do anything
+
+			//Join the irradiance group for this orientation
+			if ((orientation_type == DEFAULT) || (orientation_type == FIXED_AXIS))
+			{
+				if (register_irradiance != NULL)
+				{
+					pInsolation = ((double *(*)(OBJECT *, int64, double, double, double, double))(*register_irradiance))(weather,irradiance_model,RAD(tilt_angle),RAD(orientation_azimuth_corrected),hdr->latitude,hdr->longitude);
+				}
+				if (pInsolation == NULL)
+				{
+					GL_THROW("Unable to register solar irradiance for %s with climate %s",hdr->name,obj->name);
+					/*  TROUBLESHOOT
+					While attempting to initialize the photovoltaic array, the climate object did not provide the
+					plane-of-array irradiance for the array orientation.  Please check that the weather property refers
+					to a climate object.  If the bug persists, please submit your GLM and a bug report via the trac website.
+					*/
+				}
+			}
 		}//End valid weather - mapping check
 	}
 	else	//Player mode, just drop a message
@@ -780,7 +800,6 @@ TIMESTAMP solar::presync(TIMESTAMP t0, TIMESTAMP t1)
 
 TIMESTAMP solar::sync(TIMESTAMP t0, TIMESTAMP t1) 
 {
-	int64 ret_value;
 	OBJECT *obj = THISOBJECTHDR;
 	double insolwmsq, corrwindspeed, Tback, Ftempcorr;
 
@@ -868,26 +887,14 @@ TIMESTAMP solar::sync(TIMESTAMP t0, TIMESTAMP t1)
 					}
 					else
 					{
-						ret_value = ((int64 (*)(OBJECT *, double, double, double, double, double *))(*calc_solar_radiation))(weather, RAD(tilt_angle), obj->latitude, obj->longitude, shading_factor, &Insolation);
+						Insolation = shading_factor*pInsolation[0] + pInsolation[1];
 					}
 					break;
 				}
 			case FIXED_AXIS: // NOTE that this means FIXED, stationary. There is no AXIS at all. FIXED_AXIS is known as Single Axis Tracking by some, so the term is misleading.
 				{
 					//Snag solar insolation - prorate by shading (direct axis) - uses model selected earlier
-					ret_value = ((int64 (*)(OBJECT *, double, double, double, double, double, double *))(*calc_solar_radiation))(weather,RAD(tilt_angle),RAD(orientation_azimuth_corrected),obj->latitude,obj->longitude,shading_factor,&Insolation);
-					//ret_value = ((int64 (*)(OBJECT *, double, double, double, double *))(*calc_solar_radiation))(weather,tilt_angle,orientation_azimuth_corrected,shading_factor,&Insolation);
-
-					//Make sure it worked
-					if (ret_value == 0)
-					{
-						GL_THROW("Calculation of solar radiation failed in %s",obj->name);
-						/*  TROUBLESHOOT
-						While calculating solar radiation in the photovoltaic object, an error
-						occurred.  Please try again.  If the error persists, please submit your
-						code and a bug report via the trac website.
-						*/
-					}
+					Insolation = shading_factor*pInsolation[0] + pInsolation[1];
 
 					break;
 				}
@@ -82,7 +82,7 @@ public:
 	enum ORIENTATION {DEFAULT=0, FIXED_AXIS=1, ONE_AXIS=2, TWO_AXIS=3, AZIMUTH_AXIS=4};
 	enumeration orientation_type;	//Describes orientation features of PV
 
-	FUNCTIONADDR calc_solar_radiation;	//Function pointer to climate's calculate solar radiation in degrees
+	double *pInsolation;	//Pointer to climate's shared {direct, diffuse} plane-of-array irradiance for this orientation
 		
 	OBJECT *weather;
 	double efficiency;
@@ -0,0 +1,28 @@
+# checks the output of test_scenario_batch.glm
+import sys
+
+# voltage extremes with each scenario's injections modeled as meter loads
+expected = {
+	"pv_A1_2" : (0.988291, 1.000493, 0, 0),
+	"pv_B2_1" : (0.988259, 1.002675, 0, 0),
+	"pv_A_both" : (0.988438, 1.039485, 2, 4),
+}
+
+with open("test_scenario_batch_output.csv") as fh:
+	header = fh.readline().strip().split(",")
+	rows = [dict(zip(header,line.strip().split(","))) for line in fh]
+
+if [row["scenario"] for row in rows] != ["base"] + list(expected):
+	print(f"unexpected scenarios {[row['scenario'] for row in rows]}", file=sys.stderr)
+	sys.exit(1)
+for row in rows[1:]:
+	vmin, vmax, voltage_violations, loading_violations = expected[row["scenario"]]
+	if row["converged"] != "true":
+		print(f"{row['scenario']}: did not converge", file=sys.stderr)
+		sys.exit(1)
+	if abs(float(row["min_voltage[pu]"])-vmin) > 1e-5 or abs(float(row["max_voltage[pu]"])-vmax) > 1e-5:
+		print(f"{row['scenario']}: voltages {row['min_voltage[pu]']}-{row['max_voltage[pu]']} pu differ from {vmin}-{vmax} pu", file=sys.stderr)
+		sys.exit(1)
+	if int(row["voltage_violations"]) != voltage_violations or int(row["loading_violations"]) != loading_violations:
+		print(f"{row['scenario']}: {row['voltage_violations']} voltage and {row['loading_violations']} loading violations, expected {voltage_violations} and {loading_violations}", file=sys.stderr)
+		sys.exit(1)
@@ -1836,6 +1836,12 @@ void fault_check::momentary_activation(int node_int)
 
 		//Flag it
 		*momentary_flag = true;
+
+		//Let anyone watching the meter know
+		if (gl_object_isa(tmp_obj,"triplex_meter","powerflow"))
+			OBJECTDATA(tmp_obj,triplex_meter)->update_interruption_observers();
+		else
+			OBJECTDATA(tmp_obj,meter)->update_interruption_observers();
 	}
 
 	//Loop through the link table
@@ -45,6 +45,27 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 	gl_global_create("powerflow::lu_solver",PT_char256,&LUSolverName,NULL);
 	gl_global_create("powerflow::NR_iteration_limit",PT_int64,&NR_iteration_limit,NULL);
 	gl_global_create("powerflow::NR_deltamode_iteration_limit",PT_int64,&NR_delta_iteration_limit,NULL);
+	gl_global_create("powerflow::NR_load_change_tolerance",PT_double,&NR_load_change_tolerance,PT_UNITS,"pu",PT_DESCRIPTION,"Relative aggregate load change below which the previous NR solution is reused (0 disables)",NULL);
+	gl_global_create("powerflow::NR_load_change_skip_limit",PT_int64,&NR_load_change_skip_limit,PT_DESCRIPTION,"Maximum number of consecutive NR solutions reused",NULL);
+	gl_global_create("powerflow::NR_solve_count",PT_int64,&NR_solve_count,PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"Number of full NR solutions",NULL);
+	gl_global_create("powerflow::NR_skip_count",PT_int64,&NR_skip_count,PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"Number of NR solutions reused because the load change was below NR_load_change_tolerance",NULL);
+	gl_global_create("powerflow::NR_skip_error_bound",PT_double,&NR_skip_error_bound,PT_UNITS,"pu",PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"Largest relative load change ignored by a reused NR solution",NULL);
+	gl_global_create("powerflow::NR_iterative_tolerance",PT_double,&NR_iterative_tolerance,PT_DESCRIPTION,"Relative residual at which the iterative matrix solver stops",NULL);
+	gl_global_create("powerflow::NR_iterative_iteration_limit",PT_int64,&NR_iterative_iteration_limit,PT_DESCRIPTION,"Maximum number of iterations of the iterative matrix solver",NULL);
+	gl_global_create("powerflow::NR_iterative_restart",PT_int64,&NR_iterative_restart,PT_DESCRIPTION,"Number of iterations between restarts of the iterative matrix solver",NULL);
+	gl_global_create("powerflow::NR_iterative_refresh_ratio",PT_double,&NR_iterative_refresh_ratio,PT_DESCRIPTION,"Growth of the iteration count of the iterative matrix solver that triggers a preconditioner rebuild (0 rebuilds every solve)",NULL);
+	gl_global_create("powerflow::NR_iterative_refresh_count",PT_int64,&NR_iterative_refresh_count,PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"Number of preconditioner builds of the iterative matrix solver",NULL);
+	gl_global_create("powerflow::NR_iterative_iteration_count",PT_int64,&NR_iterative_iteration_count,PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"Total number of iterations of the iterative matrix solver",NULL);
+	gl_global_create("powerflow::NR_secondary_reduction",PT_bool,&NR_secondary_reduction,PT_DESCRIPTION,"Fold radial triplex secondaries into their transformer bus during static NR solutions",NULL);
+	gl_global_create("powerflow::NR_reduced_bus_count",PT_int64,&NR_reduced_bus_count,PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"Number of buses folded by the NR secondary reduction",NULL);
+	gl_global_create("powerflow::NR_reduced_root_count",PT_int64,&NR_reduced_root_count,PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"Number of transformer buses the NR secondary reduction folds secondaries into",NULL);
+	gl_global_create("powerflow::NR_chord_newton",PT_bool,&NR_chord_newton,PT_DESCRIPTION,"Reuse the last superLU factorization across NR iterations and timesteps until convergence slows",NULL);
+	gl_global_create("powerflow::NR_chord_contraction",PT_double,&NR_chord_contraction,PT_DESCRIPTION,"Ratio of successive largest voltage updates above which the chord method refactors",NULL);
+	gl_global_create("powerflow::NR_chord_age_limit",PT_int64,&NR_chord_age_limit,PT_DESCRIPTION,"Maximum number of NR iterations solved with one factorization by the chord method",NULL);
+	gl_global_create("powerflow::NR_chord_iteration_count",PT_int64,&NR_chord_iteration_count,PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"Number of NR iterations solved by the chord method",NULL);
+	gl_global_create("powerflow::NR_chord_factor_count",PT_int64,&NR_chord_factor_count,PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"Number of factorizations performed by the chord method",NULL);
+	gl_global_create("powerflow::NR_chord_update_limit",PT_int64,&NR_chord_update_limit,PT_DESCRIPTION,"Maximum number of topology changes the chord method applies to one factorization as low-rank updates (0 refactors on every change)",NULL);
+	gl_global_create("powerflow::NR_chord_update_count",PT_int64,&NR_chord_update_count,PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"Number of topology changes applied to the chord method factorization as low-rank updates",NULL);
 	gl_global_create("powerflow::NR_superLU_procs",PT_int32,&NR_superLU_procs,NULL);
 	gl_global_create("powerflow::default_maximum_voltage_error",PT_double,&default_maximum_voltage_error,NULL);
 	gl_global_create("powerflow::default_maximum_power_error",PT_double,&default_maximum_power_error,NULL);
@@ -129,6 +150,7 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 	new load_tracker(module);
 	new triplex_load(module);
 	new impedance_dump(module);
+	new scenario_batch(module);
 	new vfd(module);
 	new pole(module);
 	new pole_configuration(module);
@@ -553,6 +575,25 @@ EXPORT STATUS postupdate(MODULE *module, TIMESTAMP t0, unsigned int64 dt)
 	}
 }
 
+EXPORT void term(void)
+{
+	if (NR_load_change_tolerance > 0.0)
+	{
+		gl_output("powerflow: %lld NR solutions reused and %lld solved, largest ignored load change %.3g pu (tolerance %.3g pu)",
+			NR_skip_count, NR_solve_count, NR_skip_error_bound, NR_load_change_tolerance);
+	}
+	if (NR_secondary_reduction)
+	{
+		gl_output("powerflow: secondary reduction folded %lld buses into %lld transformer buses",
+			NR_reduced_bus_count, NR_reduced_root_count);
+	}
+	if (NR_chord_newton)
+	{
+		gl_output("powerflow: chord method solved %lld NR iterations with %lld factorizations and %lld topology updates",
+			NR_chord_iteration_count, NR_chord_factor_count, NR_chord_update_count);
+	}
+}
+
 CDECL int do_kill()
 {
 	/* if global memory needs to be released, this is a good time to do it */
@@ -17,6 +17,13 @@ EXPORT int64 meter_reset(OBJECT *obj)
 	return 0;
 }
 
+// reliability flag observer registration function
+EXPORT int register_interruption_observer_meter(OBJECT *obj, OBJECT *observer, FUNCTIONADDR notify)
+{
+	meter *pMeter = OBJECTDATA(obj,meter);
+	return pMeter->add_interruption_observer(observer,notify);
+}
+
 extern char1024 market_price_name;
 
 //////////////////////////////////////////////////////////////////////////
@@ -269,6 +276,10 @@ meter::meter(MODULE *mod) : node(mod)
 		if (gl_publish_function(oclass,"reset",(FUNCTIONADDR)meter_reset)==NULL)
 			GL_THROW("unable to publish meter_reset function in %s",__FILE__);
 
+		// publish reliability flag observer function
+		if (gl_publish_function(oclass,"register_interruption_observer",(FUNCTIONADDR)register_interruption_observer_meter)==NULL)
+			GL_THROW("unable to publish meter interruption observer function in %s",__FILE__);
+
 		//Publish deltamode functions
 		if (gl_publish_function(oclass,	"delta_linkage_node", (FUNCTIONADDR)delta_linkage)==NULL)
 			GL_THROW("Unable to publish meter delta_linkage function");
@@ -336,6 +347,7 @@ int meter::create()
 
 	meter_interrupted = false;	//We default to being in service
 	meter_interrupted_secondary = false;	//Default to no momentary interruptions
+	interruption_observers = NULL;	//No one is watching the reliability flags yet
 
 	hourly_acc = 0.0;
 	monthly_bill = 0.0;
@@ -479,6 +491,9 @@ TIMESTAMP meter::presync(TIMESTAMP t0)
 	//Reliability addition - if momentary flag set - clear it
 	if ( meter_interrupted_secondary == true )
 		meter_interrupted_secondary = false;
+
+	//Let anyone watching know
+	update_interruption_observers();
 	
 	// Capturing first timestamp of simulation for use in delta energy measurements.
 	if ( t0 != 0 && start_timestamp == 0 )
@@ -487,6 +502,19 @@ TIMESTAMP meter::presync(TIMESTAMP t0)
 	return node::presync(t0);
 }
 
+//Register an object to be notified when the reliability flags change
+//notify is called as int notify(OBJECT *observer, OBJECT *customer, int interrupted_change, int interrupted_secondary_change)
+int meter::add_interruption_observer(OBJECT *observer, FUNCTIONADDR notify)
+{
+	return interruption_observer_add(&interruption_observers,THISOBJECTHDR,observer,notify,meter_interrupted,meter_interrupted_secondary);
+}
+
+//Notify the observers of any reliability flag change since they were last notified
+void meter::update_interruption_observers(void)
+{
+	interruption_observer_update(interruption_observers,THISOBJECTHDR,meter_interrupted,meter_interrupted_secondary);
+}
+
 //Functionalized portion for deltamode compatibility
 void meter::BOTH_meter_sync_fxn()
 {
@@ -542,6 +570,9 @@ void meter::BOTH_meter_sync_fxn()
 		}
 	}
 
+	//Let anyone watching know about any changes
+	update_interruption_observers();
+
 	if (meter_power_consumption != complex(0,0))
 	{
 		if (has_phase(PHASE_A))
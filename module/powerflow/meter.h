@@ -41,6 +41,7 @@ public:
 	complex indiv_measured_power[3];///< metered power on each phase
 	bool meter_interrupted;			///< Reliability flag - goes active if the customer is in an "interrupted" state
 	bool meter_interrupted_secondary;	///< Reliability flag - goes active if the customer is in an "secondary interrupted" state - i.e., momentary
+	INTERRUPTION_OBSERVER *interruption_observers;	///< Objects notified when the reliability flags change
 	bool meter_NR_servered;			///< Flag for NR solver, server mode (not standalone), and SWING designation
 	TIMESTAMP next_time;
 	TIMESTAMP dt;
@@ -85,6 +86,8 @@ public:
 	int check_prices();
 
 	void BOTH_meter_sync_fxn(void);
+	int add_interruption_observer(OBJECT *observer, FUNCTIONADDR notify);
+	void update_interruption_observers(void);
 
 	SIMULATIONMODE inter_deltaupdate_meter(unsigned int64 delta_time, unsigned long dt, unsigned int iteration_count_val, bool interupdate_pos);
 
@@ -48,6 +48,8 @@
 */
 
 #include "powerflow.h"
+#include "solver_iterative.h"
+#include "solver_reduce.h"
 using namespace std;
 
 //Library imports items - for external LU solver - stolen from somewhere else in GridLAB-D (tape, I believe)
@@ -876,6 +878,25 @@ int node::init(OBJECT *parent)
 			{
 				matrix_solver_method=MM_SUPERLU;	//This is the default, but we'll set it here anyways
 			}
+			else if (strcmp(LUSolverName.get_string(),ITERATIVE_SOLVER_NAME)==0)	//Built-in iterative solver
+			{
+				//Link the built-in routines through the external solver interface
+				LUSolverFcns.dllLink = NULL;
+				LUSolverFcns.ext_init = (void *)iterative_solver_init;
+				LUSolverFcns.ext_alloc = (void *)iterative_solver_alloc;
+				LUSolverFcns.ext_solve = (void *)iterative_solver_solve;
+				LUSolverFcns.ext_destroy = (void *)iterative_solver_destroy;
+				LUSolverFcns.ext_blocks = (void *)iterative_solver_blocks;
+
+				verbose("Built-in iterative solver found, utilizing for NR");
+				/*  TROUBLESHOOT
+				The built-in iterative matrix solver was specified, so NR will be calculated
+				using preconditioned GMRES instead of superLU.
+				*/
+
+				//Flag as an external solver - it uses the same interface
+				matrix_solver_method=MM_EXTERN;
+			}
 			else	//Something is there, see if we can find it
 			{
 				//Initialize the global
@@ -884,6 +905,7 @@ int node::init(OBJECT *parent)
 				LUSolverFcns.ext_alloc = NULL;
 				LUSolverFcns.ext_solve = NULL;
 				LUSolverFcns.ext_destroy = NULL;
+				LUSolverFcns.ext_blocks = NULL;
 
 #ifdef WIN32
 				snprintf(ext_lib_file_name, 1024, "solver_%s" DLEXT,LUSolverName.get_string());
@@ -990,6 +1012,9 @@ int node::init(OBJECT *parent)
 						}
 
 
+						//Now link functions - blocks (optional)
+						LUSolverFcns.ext_blocks = DLSYM(LUSolverFcns.dllLink,"LU_blocks");
+
 						//If any failed, just revert to superLU (probably shouldn't even check others after a failure, but meh)
 						if (ExtLinkFailure)
 						{
@@ -1708,6 +1733,10 @@ TIMESTAMP node::presync(TIMESTAMP t0)
 			}
 			NR_curr_branch = 0;	//Pull pointer off flag so other objects know it's built
 
+			//Account for the NR tables in the memory report
+			gl_heap_set(gl_heap_account("powerflow","NR bus table",sizeof(BUSDATA)),NR_bus_count,NR_bus_count*sizeof(BUSDATA));
+			gl_heap_set(gl_heap_account("powerflow","NR branch table",sizeof(BRANCHDATA)),NR_branch_count,NR_branch_count*sizeof(BRANCHDATA));
+
 			//Initialize the from - will be used for detection
 			for (index_val=0; index_val<NR_branch_count; index_val++)
 				NR_branchdata[index_val].from = -1;
@@ -2732,7 +2761,15 @@ TIMESTAMP node::sync(TIMESTAMP t0)
 					powerflow_type = PF_NORMAL;
 				}
 
-				int64 result = solver_nr(NR_bus_count, NR_busdata, NR_branch_count, NR_branchdata, &NR_powerflow, powerflow_type, NULL, &bad_computation);
+				//Reuse the last solution if the loads have barely changed since then
+				if (solver_nr_reuse_solution(NR_bus_count, NR_busdata, powerflow_type))
+				{
+					NR_retval = t1;
+					return NR_retval;
+				}
+
+				int64 result = solver_reduce_solve(NR_bus_count, NR_busdata, NR_branch_count, NR_branchdata, &NR_powerflow, powerflow_type, &bad_computation);
+				solver_nr_save_solution(NR_bus_count, NR_busdata, (result>0) && !bad_computation);
 
 				//De-flag the change - no contention should occur
 				NR_admit_change = false;
@@ -42,6 +42,8 @@ static char32 wind_dir_name = "wind_dir";
 static char32 wind_gust_name = "wind_gust";
 static double default_repair_time = 24.0;
 static bool stop_on_pole_failure = false;
+static bool pole_fragility_screening = false;
+static double pole_fragility_margin = 0.1;
 
 pole::pole(MODULE *mod)
 {
@@ -145,12 +147,20 @@ pole::pole(MODULE *mod)
                 PT_DEFAULT, "0 ft",
                 PT_DESCRIPTION, "guy wire attachment height",
 
+            PT_double, "fragility_wind_speed[m/s]", get_fragility_wind_speed_offset(),
+                PT_OUTPUT,
+                PT_DESCRIPTION, "wind speed below which pole analysis is skipped when fragility screening is enabled",
+
             NULL) < 1 ) throw "unable to publish properties in " __FILE__;
 		gl_global_create("powerflow::repair_time[h]",PT_double,&default_repair_time,NULL);
         gl_global_create("powerflow::wind_speed_name",PT_char32,&wind_speed_name,NULL);
         gl_global_create("powerflow::wind_dir_name",PT_char32,&wind_dir_name,NULL);
         gl_global_create("powerflow::wind_gust_name",PT_char32,&wind_gust_name,NULL);
         gl_global_create("powerflow::stop_on_pole_failure",PT_bool,&stop_on_pole_failure,NULL);
+        gl_global_create("powerflow::pole_fragility_screening",PT_bool,&pole_fragility_screening,
+            PT_DESCRIPTION,"only analyze poles when the wind speed could exceed their fragility wind speed",NULL);
+        gl_global_create("powerflow::pole_fragility_margin[pu]",PT_double,&pole_fragility_margin,
+            PT_DESCRIPTION,"fraction of resisting moment held in reserve when computing the fragility wind speed",NULL);
 	}
 }
 
@@ -190,9 +200,57 @@ int pole::create(void)
     wind_speed_ref = NULL;
     wind_direction_ref = NULL;
     wind_gusts_ref = NULL;
+    fragility_wind_speed = 0.0;
+    mount_moment_static = 0.0;
+    mount_moment_nowind = 0.0;
+    fragility_resisting_moment = NAN;
+    fragility_tilt_angle = NAN;
 	return 1;
 }
 
+void pole::add_mount_moments(double moment_static, double moment_nowind)
+{
+    mount_moment_static += moment_static;
+    mount_moment_nowind += moment_nowind;
+    fragility_resisting_moment = NAN; // force update of fragility wind speed
+}
+
+// Lowest wind speed at which the pole could fail.  The bound ignores the
+// wind direction and uses the pole moment per unit of wind pressure, so
+// that the full analysis done in precommit never fails the pole at a lower
+// wind speed.
+double pole::update_fragility_wind_speed(void)
+{
+    if ( resisting_moment == fragility_resisting_moment && tilt_angle == fragility_tilt_angle )
+    {
+        return fragility_wind_speed;
+    }
+    double moment_static = mount_moment_static;
+    if ( tilt_angle > 0.0 )
+    {
+        const double D1 = config->top_diameter/12;
+        const double D0 = config->ground_diameter/12;
+        const double DD = (D0-D1) / 2;
+        const double H = height;
+        const double rho = config->material_density;
+        moment_static += 0.125 * rho * PI * (H*H) * (D0*D0 - DD*DD) * sin(tilt_angle/180*PI);
+    }
+    double moment_available = (1-pole_fragility_margin) * resisting_moment - moment_static;
+    double moment_per_pressure = pole_moment_nowind + mount_moment_nowind;
+    if ( moment_available > 0.0 && moment_per_pressure > 0.0 )
+    {
+        fragility_wind_speed = sqrt(moment_available / moment_per_pressure / (0.00256 * 2.24));
+    }
+    else
+    {
+        fragility_wind_speed = moment_available > 0.0 ? INFINITY : 0.0;
+    }
+    fragility_resisting_moment = resisting_moment;
+    fragility_tilt_angle = tilt_angle;
+    verbose("fragility_wind_speed = %g m/s",fragility_wind_speed);
+    return fragility_wind_speed;
+}
+
 int pole::init(OBJECT *parent)
 {
 	// configuration
@@ -369,6 +427,12 @@ TIMESTAMP pole::precommit(TIMESTAMP t0)
         recalc = true;
         verbose("setting pole recalculation flag");
 	}
+	else if ( pole_status == PS_OK && last_wind_speed != wind_speed && pole_fragility_screening
+        && wind_speed < update_fragility_wind_speed() && last_wind_speed < fragility_wind_speed )
+    {
+        // neither the current nor the last analyzed wind can fail the pole
+        verbose("wind_speed = %g m/s is below fragility wind speed, pole analysis skipped",wind_speed);
+    }
 	else if ( pole_status == PS_OK && last_wind_speed != wind_speed )
 	{
         if ( resisting_moment < 0 )
@@ -51,6 +51,7 @@ public:
 	GL_ATOMIC(bool, is_deadend);
 	GL_ATOMIC(double, current_hollow_diameter);
 	GL_ATOMIC(double, guy_height);
+	GL_ATOMIC(double, fragility_wind_speed);
 private:
     gld_property *wind_speed_ref;
 	gld_property *wind_direction_ref;
@@ -62,9 +63,15 @@ private:
 	class pole_configuration *config;
 	double last_wind_speed;
 	TIMESTAMP down_time;
+	double mount_moment_static; // upper bound on wind-independent moment of mounted equipment and wires
+	double mount_moment_nowind; // moment of mounted equipment and wires per unit of wind pressure
+	double fragility_resisting_moment; // resisting moment used for last fragility wind speed calc
+	double fragility_tilt_angle; // tilt angle used for last fragility wind speed calc
+	double update_fragility_wind_speed(void);
 public:
 	double height; // effective pole height for moment calculations
     bool recalc; // flag for recalculation
+	void add_mount_moments(double moment_static, double moment_nowind);
 public:
 	pole(MODULE *);
 	int create(void);
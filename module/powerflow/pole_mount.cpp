@@ -147,6 +147,21 @@ int pole_mount::init(OBJECT *parent)
         verbose("line_load_nowind = %g ft.lb.s/m (TODO)",tension);
     }
 
+    // moments used by the pole fragility screening
+    if ( my()->parent != NULL && get_parent()->isa("pole") )
+    {
+        pole *mount = OBJECTDATA(my()->parent,pole);
+        double lever = fabs(height - mount->height);
+        if ( equipment_is_line )
+        {
+            mount->add_mount_moments(weight*lever + fabs(tension), fabs(line_moment_nowind));
+        }
+        else
+        {
+            mount->add_mount_moments(fabs(weight*offset) + weight*lever, area*lever);
+        }
+    }
+
 	return 1;
 }
 
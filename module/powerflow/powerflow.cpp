@@ -37,6 +37,53 @@ void print_matrix(complex mat[3][3])
 	gl_testmsg("\n");
 }
 
+//Register an object to be notified when a customer's interruption flags change
+//The observer starts from the current flags, so only later changes are reported to it
+int interruption_observer_add(INTERRUPTION_OBSERVER **list, OBJECT *customer, OBJECT *observer, FUNCTIONADDR notify, bool interrupted, bool interrupted_secondary)
+{
+	INTERRUPTION_OBSERVER *item = (INTERRUPTION_OBSERVER*)gl_malloc(sizeof(INTERRUPTION_OBSERVER));
+
+	//Make sure it worked
+	if (item == NULL)
+	{
+		gl_error("%s:%d - %s - unable to allocate interruption observer",customer->oclass->name,customer->id,customer->name?customer->name:"unnamed");
+		/*  TROUBLESHOOT
+		While registering an object to be notified of reliability flag changes, memory allocation failed.
+		Please try again.  If the error persists, please submit your code and a bug report via the issue tracker.
+		*/
+		return 0;
+	}
+
+	item->obj = observer;
+	item->notify = notify;
+	item->interrupted = interrupted;
+	item->interrupted_secondary = interrupted_secondary;
+	item->next = *list;
+	*list = item;
+
+	return 1;
+}
+
+//Notify each observer of any interruption flag change since it was last notified
+void interruption_observer_update(INTERRUPTION_OBSERVER *list, OBJECT *customer, bool interrupted, bool interrupted_secondary)
+{
+	INTERRUPTION_OBSERVER *item;
+	int change, change_secondary;
+
+	for (item=list; item!=NULL; item=item->next)
+	{
+		change = (int)interrupted - (int)item->interrupted;
+		change_secondary = (int)interrupted_secondary - (int)item->interrupted_secondary;
+
+		if ((change != 0) || (change_secondary != 0))
+		{
+			((int (*)(OBJECT *, OBJECT *, int, int))(*item->notify))(item->obj,customer,change,change_secondary);
+			item->interrupted = interrupted;
+			item->interrupted_secondary = interrupted_secondary;
+		}
+	}
+}
+
 EXPORT int kmldump(int (*stream)(const char*,...), OBJECT *obj)
 {
 	if (obj==NULL) /* dump document styles */
@@ -50,8 +50,21 @@ typedef struct s_ext_fxn {
 	void *ext_alloc;
 	void *ext_solve;
 	void *ext_destroy;
+	void *ext_blocks;	///< optional, receives the number of rows of each bus
 } EXT_LU_FXN_CALLS;
 
+//Structure to hold objects notified when a customer's interruption flags change (e.g., reliability metrics)
+typedef struct s_interruption_observer {
+	OBJECT *obj;			///< observing object
+	FUNCTIONADDR notify;	///< int notify(OBJECT *observer, OBJECT *customer, int interrupted_change, int interrupted_secondary_change)
+	bool interrupted;			///< Interruption flag value last sent to this observer
+	bool interrupted_secondary;	///< Secondary interruption flag value last sent to this observer
+	struct s_interruption_observer *next;
+} INTERRUPTION_OBSERVER;
+
+int interruption_observer_add(INTERRUPTION_OBSERVER **list, OBJECT *customer, OBJECT *observer, FUNCTIONADDR notify, bool interrupted, bool interrupted_secondary);
+void interruption_observer_update(INTERRUPTION_OBSERVER *list, OBJECT *customer, bool interrupted, bool interrupted_secondary);
+
 EXTERN char256 LUSolverName INIT("");				/**< filename for external LU solver */
 EXTERN EXT_LU_FXN_CALLS LUSolverFcns;				/**< links to external LU solver functions */
 EXTERN SOLVERMETHOD solver_method INIT(SM_FBS);		/**< powerflow solver methodology */
@@ -76,6 +89,27 @@ EXTERN TIMESTAMP NR_retval INIT(TS_NEVER);			/**< Newton-Raphson current return
 EXTERN OBJECT *NR_swing_bus INIT(NULL);				/**< Newton-Raphson swing bus */
 EXTERN int NR_swing_bus_reference INIT(-1);			/**< Newton-Raphson swing bus index reference in NR_busdata */
 EXTERN int64 NR_delta_iteration_limit INIT(10);		/**< Newton-Raphson iteration limit (per deltamode timestep) */
+EXTERN double NR_load_change_tolerance INIT(0.0);	/**< Newton-Raphson relative aggregate load change below which the previous solution is reused (0 disables) */
+EXTERN int64 NR_load_change_skip_limit INIT(10);	/**< Newton-Raphson limit on consecutive reused solutions */
+EXTERN int64 NR_solve_count INIT(0);				/**< Newton-Raphson number of full solutions */
+EXTERN int64 NR_skip_count INIT(0);					/**< Newton-Raphson number of reused solutions */
+EXTERN double NR_skip_error_bound INIT(0.0);		/**< Newton-Raphson largest relative load change ignored by a reused solution */
+EXTERN double NR_iterative_tolerance INIT(1e-10);	/**< Newton-Raphson iterative matrix solver relative residual tolerance */
+EXTERN int64 NR_iterative_iteration_limit INIT(500);	/**< Newton-Raphson iterative matrix solver iteration limit */
+EXTERN int64 NR_iterative_restart INIT(30);		/**< Newton-Raphson iterative matrix solver iterations between GMRES restarts */
+EXTERN double NR_iterative_refresh_ratio INIT(2.0);	/**< Newton-Raphson iterative matrix solver iteration growth that triggers a preconditioner rebuild */
+EXTERN int64 NR_iterative_refresh_count INIT(0);	/**< Newton-Raphson iterative matrix solver number of preconditioner builds */
+EXTERN int64 NR_iterative_iteration_count INIT(0);	/**< Newton-Raphson iterative matrix solver total number of iterations */
+EXTERN bool NR_secondary_reduction INIT(false);		/**< Newton-Raphson folds radial triplex secondaries into their transformer bus */
+EXTERN int64 NR_reduced_bus_count INIT(0);			/**< Newton-Raphson number of buses folded by the secondary reduction */
+EXTERN int64 NR_reduced_root_count INIT(0);			/**< Newton-Raphson number of transformer buses the secondaries are folded into */
+EXTERN bool NR_chord_newton INIT(false);			/**< Newton-Raphson reuses the last LU factorization across iterations and timesteps (chord method) */
+EXTERN double NR_chord_contraction INIT(0.5);		/**< Newton-Raphson chord method required reduction of the largest voltage update per reused iteration */
+EXTERN int64 NR_chord_age_limit INIT(20);			/**< Newton-Raphson chord method maximum number of iterations solved with one factorization */
+EXTERN int64 NR_chord_iteration_count INIT(0);		/**< Newton-Raphson chord method total number of iterations */
+EXTERN int64 NR_chord_factor_count INIT(0);			/**< Newton-Raphson chord method total number of factorizations */
+EXTERN int64 NR_chord_update_limit INIT(10);		/**< Newton-Raphson chord method maximum number of topology changes applied to one factorization as low-rank updates */
+EXTERN int64 NR_chord_update_count INIT(0);			/**< Newton-Raphson chord method total number of topology changes applied as low-rank updates */
 EXTERN bool FBS_swing_set INIT(false);				/**< Forward-Back Sweep swing assignment variable */
 EXTERN bool show_matrix_values INIT(false);			/**< flag to enable dumping matrix calculations as they occur */
 EXTERN double primary_voltage_ratio INIT(60.0);		/**< primary voltage ratio (@todo explain primary_voltage_ratio in powerflow (ticket #131) */
@@ -181,6 +215,7 @@ void schedule_deltamode_start(TIMESTAMP tstart);	/* Anticipated time for a delta
 #include "currdump.h"
 #include "impedance_dump.h"
 #include "load_tracker.h"
+#include "scenario_batch.h"
 #include "voltdump.h"
 
 #include "pole.h"
@@ -0,0 +1,521 @@
+// powerflow/scenario_batch.cpp
+// Copyright (C) 2026, Regents of the Leland Stanford Junior University
+
+#include "powerflow.h"
+#include "solver_reduce.h"
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////
+// scenario_batch CLASS FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+CLASS* scenario_batch::oclass = NULL;
+
+scenario_batch::scenario_batch(MODULE *mod)
+{
+	if (oclass==NULL)
+	{
+		// register the class definition
+		oclass = gl_register_class(mod,"scenario_batch",sizeof(scenario_batch),PC_BOTTOMUP|PC_AUTOLOCK);
+		if (oclass==NULL)
+			throw "unable to register class scenario_batch";
+		else
+			oclass->trl = TRL_PROTOTYPE;
+
+		// publish the class properties
+		if (gl_publish_variable(oclass,
+			PT_timestamp,"runtime",PADDR(runtime),
+				PT_DEFAULT, "NEVER",
+				PT_DESCRIPTION,"the time to solve the scenarios (first commit if NEVER)",
+			PT_double, "interval[s]", PADDR(interval),
+				PT_DEFAULT, "0 s",
+				PT_DESCRIPTION, "interval at which the scenarios are solved again (0 solves them once)",
+			PT_char1024,"scenarios",PADDR(scenarios),
+				PT_REQUIRED,
+				PT_DESCRIPTION,"CSV file of scenarios (scenario,node,power), rows with the same scenario name are injected together",
+			PT_char1024,"filename",PADDR(filename),
+				PT_REQUIRED,
+				PT_DESCRIPTION,"CSV file to write the results of the scenarios into",
+			PT_double, "voltage_low[pu]", PADDR(voltage_low),
+				PT_DEFAULT, "0.95 pu",
+				PT_DESCRIPTION, "voltage below which a bus is counted as a voltage violation",
+			PT_double, "voltage_high[pu]", PADDR(voltage_high),
+				PT_DEFAULT, "1.05 pu",
+				PT_DESCRIPTION, "voltage above which a bus is counted as a voltage violation",
+			PT_double, "loading_limit[%]", PADDR(loading_limit),
+				PT_DEFAULT, "100 %",
+				PT_DESCRIPTION, "line current, relative to its continuous rating, above which a line is counted as a thermal violation",
+			PT_bool, "reuse_factorization", PADDR(reuse_factorization),
+				PT_DEFAULT, "TRUE",
+				PT_DESCRIPTION, "solve the scenarios with the chord method, so later scenarios reuse the Jacobian factorization of an earlier solution",
+			PT_int32,"scenario_count",PADDR(scenario_count),
+				PT_ACCESS, PA_REFERENCE,
+				PT_DESCRIPTION,"the number of scenarios read",
+			PT_int32,"runcount",PADDR(runcount),
+				PT_ACCESS, PA_REFERENCE,
+				PT_DESCRIPTION,"the number of times the scenarios were solved",
+			PT_int64,"solve_count",PADDR(solve_count),
+				PT_ACCESS, PA_REFERENCE,
+				PT_DESCRIPTION,"the number of scenario solutions",
+			PT_int64,"iteration_count",PADDR(iteration_count),
+				PT_ACCESS, PA_REFERENCE,
+				PT_DESCRIPTION,"the number of NR iterations of all scenario solutions",
+			PT_int64,"factorization_count",PADDR(factorization_count),
+				PT_ACCESS, PA_REFERENCE,
+				PT_DESCRIPTION,"the number of factorizations of all scenario solutions",
+			NULL)<1) GL_THROW("unable to publish properties in %s",__FILE__);
+	}
+}
+
+int scenario_batch::create(void)
+{
+	return 1;
+}
+
+int scenario_batch::init(OBJECT *parent)
+{
+	if (solver_method != SM_NR)
+	{
+		error("scenario_batch requires the NR solver");
+		/*  TROUBLESHOOT
+		The scenario batch solves each scenario with the Newton-Raphson solver.  Set the powerflow
+		module's solver_method to NR.
+		*/
+		return 0;
+	}
+	if (interval < 0)
+	{
+		error("negative interval is not permitted");
+		return 0;
+	}
+	else if (interval > 0)
+	{
+		runtime = TS_NEVER;
+	}
+	if (voltage_low >= voltage_high)
+	{
+		error("voltage_low must be less than voltage_high");
+		return 0;
+	}
+	unlink(filename);
+	return load_scenarios() ? 1 : 0;
+}
+
+int scenario_batch::isa(CLASSNAME classname)
+{
+	return strcmp(classname,"scenario_batch")==0;
+}
+
+//Read the scenario file - rows with the same name are one scenario
+bool scenario_batch::load_scenarios(void)
+{
+	char path[1024];
+	if (gl_findfile(scenarios,NULL,R_OK,path,sizeof(path)) == NULL)
+	{
+		error("scenario file '%s' not found", scenarios.get_string());
+		/*  TROUBLESHOOT
+		The file named in the scenarios property of the scenario batch could not be found.  Check
+		the file name and the GLPATH.
+		*/
+		return false;
+	}
+	FILE *fp = fopen(path,"r");
+	if (fp == NULL)
+	{
+		error("unable to open scenario file '%s'", path);
+		return false;
+	}
+	char line[1024];
+	int lineno = 0;
+	bool ok = true;
+	while (fgets(line,sizeof(line),fp) != NULL)
+	{
+		lineno++;
+		char name[256], node[256], power[256];
+		char *p = line;
+		while (isspace(*p)) p++;
+		if (*p == '\0' || *p == '#')
+		{
+			continue;
+		}
+		if (sscanf(p,"%255[^,],%255[^,],%255[^,\r\n]",name,node,power) != 3)
+		{
+			error("%s(%d): scenario row must be 'scenario,node,power'", path, lineno);
+			ok = false;
+			continue;
+		}
+		if (lineno == 1 && strcmp(name,"scenario") == 0)	//Header row
+		{
+			continue;
+		}
+		double re = 0.0, im = 0.0;
+		if (sscanf(power,"%lg%lg",&re,&im) < 1)
+		{
+			error("%s(%d): power '%s' is not a valid complex value", path, lineno, power);
+			ok = false;
+			continue;
+		}
+		OBJECT *obj = gl_get_object(node);
+		if (obj == NULL || !gl_object_isa(obj,"node","powerflow"))
+		{
+			error("%s(%d): node '%s' is not a powerflow node", path, lineno, node);
+			/*  TROUBLESHOOT
+			Each row of the scenario file must name a powerflow node (or one of its subclasses) to inject
+			the scenario power into.  Check the node name.
+			*/
+			ok = false;
+			continue;
+		}
+		SCENARIO *scenario = NULL;
+		for (vector<SCENARIO>::iterator item=scenario_list.begin(); item!=scenario_list.end(); item++)
+		{
+			if (item->name == name)
+			{
+				scenario = &(*item);
+				break;
+			}
+		}
+		if (scenario == NULL)
+		{
+			scenario_list.push_back(SCENARIO());
+			scenario = &scenario_list.back();
+			scenario->name = name;
+		}
+		else
+		{
+			scenario->nodes += " ";
+		}
+		SCENARIO_INJECTION injection = {obj, complex(re,im)};
+		scenario->injection.push_back(injection);
+		scenario->nodes += node;
+		scenario->power += injection.power;
+	}
+	fclose(fp);
+	scenario_count = (int32)scenario_list.size();
+	verbose("read %d scenarios from '%s'", scenario_count, path);
+	return ok;
+}
+
+//Find the NR bus of a node - children share their parent's bus
+int scenario_batch::find_bus(OBJECT *obj)
+{
+	node *pnode = OBJECTDATA(obj,node);
+	if (pnode->NR_node_reference == -99 && pnode->NR_subnode_reference != NULL)
+	{
+		return *pnode->NR_subnode_reference;
+	}
+	return pnode->NR_node_reference;
+}
+
+//Scenario results - extremes of the bus voltages and line loadings
+typedef struct s_scenario_result {
+	double vmin, vmax, loading;
+	const char *vmin_name, *vmax_name;
+	char loading_name[64];
+	int voltage_violations, loading_violations;
+} SCENARIO_RESULT;
+
+static void scenario_measure(SCENARIO_RESULT &result, double voltage_low, double voltage_high, double loading_limit)
+{
+	unsigned int indexer;
+	int phase, rows;
+
+	result.vmin = 1e30;
+	result.vmax = 0.0;
+	result.loading = 0.0;
+	result.vmin_name = result.vmax_name = "";
+	result.loading_name[0] = '\0';
+	result.voltage_violations = result.loading_violations = 0;
+
+	for (indexer=0; indexer<NR_bus_count; indexer++)
+	{
+		BUSDATA *bus = &NR_busdata[indexer];
+		bool violation = false;
+		if (bus->volt_base <= 0.0)
+		{
+			continue;
+		}
+		for (phase=0; phase<3; phase++)
+		{
+			//Split-phase buses have the two 120V legs, others the phases present
+			if ((bus->phases & 0x80) == 0x80 ? (phase == 2) : ((bus->phases & (0x04>>phase)) == 0))
+			{
+				continue;
+			}
+			double vpu = bus->V[phase].Mag() / bus->volt_base;
+			if (vpu < result.vmin)
+			{
+				result.vmin = vpu;
+				result.vmin_name = bus->name ? bus->name : "";
+			}
+			if (vpu > result.vmax)
+			{
+				result.vmax = vpu;
+				result.vmax_name = bus->name ? bus->name : "";
+			}
+			if (vpu < voltage_low || vpu > voltage_high)
+			{
+				violation = true;
+			}
+		}
+		if (violation)
+		{
+			result.voltage_violations++;
+		}
+	}
+	if (result.vmin > result.vmax)	//No buses measured
+	{
+		result.vmin = 0.0;
+	}
+
+	//Line currents from the branch admittances - only lines have conductor ratings
+	for (indexer=0; indexer<NR_branch_count; indexer++)
+	{
+		BRANCHDATA *branch = &NR_branchdata[indexer];
+		if ((branch->lnk_type > 1) || (branch->from < 0) || (branch->to < 0) || (branch->obj == NULL))
+		{
+			continue;
+		}
+		link_object *lnk = OBJECTDATA(branch->obj,link_object);
+		complex *Vfrom = NR_busdata[branch->from].V;
+		complex *Vto = NR_busdata[branch->to].V;
+		bool violation = false;
+		rows = ((branch->phases & 0x80) == 0x80) ? 2 : 3;
+		for (phase=0; phase<rows; phase++)
+		{
+			if ((rows == 3) && ((branch->phases & (0x04>>phase)) == 0))
+			{
+				continue;
+			}
+			double rating = lnk->link_rating[0][phase];
+			if (rating <= 0.0)
+			{
+				continue;
+			}
+			complex current = 0.0;
+			for (int col=0; col<rows; col++)
+			{
+				current += branch->YSfrom[phase*3+col]*Vfrom[col] - branch->Yfrom[phase*3+col]*Vto[col];
+			}
+			double loading = current.Mag() / rating * 100.0;
+			if (loading > result.loading)
+			{
+				result.loading = loading;
+				if (branch->obj->name != NULL)
+				{
+					snprintf(result.loading_name,sizeof(result.loading_name),"%s",branch->obj->name);
+				}
+				else	//Unnamed links are reported as class:id
+				{
+					snprintf(result.loading_name,sizeof(result.loading_name),"%s:%d",branch->obj->oclass->name,branch->obj->id);
+				}
+			}
+			if (loading > loading_limit)
+			{
+				violation = true;
+			}
+		}
+		if (violation)
+		{
+			result.loading_violations++;
+		}
+	}
+}
+
+void scenario_batch::run(TIMESTAMP t)
+{
+	char timestr[64];
+	FILE *fp;
+	vector<complex> base_voltage(3*NR_bus_count);
+	vector<complex> base_power;
+	SCENARIO_RESULT result;
+	unsigned int indexer;
+	bool chord_newton = NR_chord_newton;
+
+	if (NR_bus_count == 0 || NR_busdata == NULL)
+	{
+		warning("no powerflow solution is available to solve the scenarios from");
+		return;
+	}
+
+	fp = fopen(filename, runcount == 0 ? "w" : "a");
+	if (fp == NULL)
+	{
+		error("unable to open '%s' for output", filename.get_string());
+		return;
+	}
+	if (runcount == 0)
+	{
+		fprintf(fp,"scenario,datetime,nodes,power_real[W],power_reactive[VAr],converged,iterations,factorizations,"
+			"min_voltage[pu],min_voltage_node,max_voltage[pu],max_voltage_node,voltage_violations,"
+			"max_loading[%%],max_loading_link,loading_violations\n");
+	}
+	gl_printtime(t, timestr, sizeof(timestr));
+
+	//Keep the base solution - each scenario starts from it
+	for (indexer=0; indexer<NR_bus_count; indexer++)
+	{
+		base_voltage[3*indexer] = NR_busdata[indexer].V[0];
+		base_voltage[3*indexer+1] = NR_busdata[indexer].V[1];
+		base_voltage[3*indexer+2] = NR_busdata[indexer].V[2];
+	}
+	scenario_measure(result,voltage_low,voltage_high,loading_limit);
+	fprintf(fp,"base,%s,,0,0,true,0,0,%.6f,%s,%.6f,%s,%d,%.3f,%s,%d\n", timestr,
+		result.vmin, result.vmin_name, result.vmax, result.vmax_name, result.voltage_violations,
+		result.loading, result.loading_name, result.loading_violations);
+
+	NR_chord_newton = reuse_factorization;
+	for (vector<SCENARIO>::iterator scenario=scenario_list.begin(); scenario!=scenario_list.end(); scenario++)
+	{
+		vector<SCENARIO_INJECTION>::iterator injection;
+
+		//Add the injections to the constant power of their buses
+		base_power.clear();
+		for (injection=scenario->injection.begin(); injection!=scenario->injection.end(); injection++)
+		{
+			int bus = find_bus(injection->obj);
+			if (bus < 0 || (unsigned int)bus >= NR_bus_count)
+			{
+				warning("node '%s' of scenario '%s' is not in the powerflow solution", injection->obj->name ? injection->obj->name : "unnamed", scenario->name.c_str());
+				base_power.push_back(complex(0.0));
+				base_power.push_back(complex(0.0));
+				base_power.push_back(complex(0.0));
+				continue;
+			}
+			BUSDATA *pbus = &NR_busdata[bus];
+			base_power.push_back(pbus->S[0]);
+			base_power.push_back(pbus->S[1]);
+			base_power.push_back(pbus->S[2]);
+			if ((pbus->phases & 0x80) == 0x80)	//Split-phase - inject across the 240V legs
+			{
+				pbus->S[2] -= injection->power;
+			}
+			else
+			{
+				int phases = ((pbus->phases&0x04)?1:0) + ((pbus->phases&0x02)?1:0) + ((pbus->phases&0x01)?1:0);
+				for (int phase=0; phase<3 && phases>0; phase++)
+				{
+					if ((pbus->phases & (0x04>>phase)) != 0)
+					{
+						pbus->S[phase] -= injection->power / phases;
+					}
+				}
+			}
+		}
+
+		//Solve the scenario
+		bool bad_computation = false;
+		int64 factors = NR_chord_factor_count;
+		int64 iterations = solver_reduce_solve(NR_bus_count, NR_busdata, NR_branch_count, NR_branchdata, &NR_powerflow, PF_NORMAL, &bad_computation);
+		bool converged = (iterations >= 0) && !bad_computation;
+		iterations = (iterations >= 0) ? iterations+1 : -iterations;
+		factors = reuse_factorization ? NR_chord_factor_count - factors : iterations;
+
+		scenario_measure(result,voltage_low,voltage_high,loading_limit);
+		fprintf(fp,"%s,%s,%s,%.3f,%.3f,%s,%lld,%lld,%.6f,%s,%.6f,%s,%d,%.3f,%s,%d\n",
+			scenario->name.c_str(), timestr, scenario->nodes.c_str(), scenario->power.Re(), scenario->power.Im(),
+			converged ? "true" : "false", iterations, factors,
+			result.vmin, result.vmin_name, result.vmax, result.vmax_name, result.voltage_violations,
+			result.loading, result.loading_name, result.loading_violations);
+		solve_count++;
+		iteration_count += iterations;
+		factorization_count += factors;
+
+		//Restore the base loads and solution - in reverse, in case a bus is injected more than once
+		for (indexer=(unsigned int)scenario->injection.size(); indexer>0; indexer--)
+		{
+			int bus = find_bus(scenario->injection[indexer-1].obj);
+			if (bus >= 0 && (unsigned int)bus < NR_bus_count)
+			{
+				NR_busdata[bus].S[0] = base_power[3*(indexer-1)];
+				NR_busdata[bus].S[1] = base_power[3*(indexer-1)+1];
+				NR_busdata[bus].S[2] = base_power[3*(indexer-1)+2];
+			}
+		}
+		for (indexer=0; indexer<NR_bus_count; indexer++)
+		{
+			NR_busdata[indexer].V[0] = base_voltage[3*indexer];
+			NR_busdata[indexer].V[1] = base_voltage[3*indexer+1];
+			NR_busdata[indexer].V[2] = base_voltage[3*indexer+2];
+		}
+	}
+	NR_chord_newton = chord_newton;
+	fclose(fp);
+	verbose("solved %d scenarios at %s", scenario_count, timestr);
+}
+
+TIMESTAMP scenario_batch::commit(TIMESTAMP t)
+{
+	if (interval > 0)
+	{
+		TIMESTAMP dt = (TIMESTAMP)interval;
+		if (t % dt == 0)
+		{
+			run(t);
+			++runcount;
+		}
+		return ((t/dt)+1)*dt;
+	}
+	if ((t >= runtime || runtime == TS_NEVER) && runcount == 0)
+	{
+		run(t);
+		++runcount;
+	}
+	return TS_NEVER;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION OF CORE LINKAGE: scenario_batch
+//////////////////////////////////////////////////////////////////////////
+
+EXPORT int create_scenario_batch(OBJECT **obj, OBJECT *parent)
+{
+	try
+	{
+		*obj = gl_create_object(scenario_batch::oclass);
+		if (*obj!=NULL)
+		{
+			scenario_batch *my = OBJECTDATA(*obj,scenario_batch);
+			gl_set_parent(*obj,parent);
+			return my->create();
+		}
+		else
+			return 0;
+	}
+	CREATE_CATCHALL(scenario_batch);
+}
+
+EXPORT int init_scenario_batch(OBJECT *obj)
+{
+	try {
+		scenario_batch *my = OBJECTDATA(obj,scenario_batch);
+		return my->init(obj->parent);
+	}
+	INIT_CATCHALL(scenario_batch);
+}
+
+EXPORT TIMESTAMP sync_scenario_batch(OBJECT *obj, TIMESTAMP t1, PASSCONFIG pass)
+{
+	try
+	{
+		scenario_batch *my = OBJECTDATA(obj,scenario_batch);
+		obj->clock = t1;
+		return (my->runtime > t1 && my->runcount == 0) ? my->runtime : TS_NEVER;
+	}
+	SYNC_CATCHALL(scenario_batch);
+}
+
+EXPORT TIMESTAMP commit_scenario_batch(OBJECT *obj, TIMESTAMP t1, TIMESTAMP t2)
+{
+	try {
+		scenario_batch *my = OBJECTDATA(obj,scenario_batch);
+		return my->commit(t1);
+	}
+	I_CATCHALL(commit,scenario_batch);
+}
+
+EXPORT int isa_scenario_batch(OBJECT *obj, CLASSNAME classname)
+{
+	return OBJECTDATA(obj,scenario_batch)->isa(classname);
+}
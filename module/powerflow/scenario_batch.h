@@ -0,0 +1,67 @@
+// powerflow/scenario_batch.h
+// Copyright (C) 2026, Regents of the Leland Stanford Junior University
+
+#ifndef _SCENARIO_BATCH_H
+#define _SCENARIO_BATCH_H
+
+#ifndef _POWERFLOW_H
+#error "this header must be included by powerflow.h"
+#endif
+
+#include <string>
+#include <vector>
+
+//	Batched powerflow scenarios
+//
+//	A scenario_batch object solves a list of injection scenarios on the base
+//	model, e.g., for hosting capacity or sensitivity studies.  Each scenario is
+//	solved from the base solution, sharing the matrix structure of the base
+//	powerflow and, when reuse_factorization is set, its numeric factorization
+//	(see NR_chord_newton).  The voltage and line loading extremes of each
+//	scenario are written as one row of the output file.
+
+typedef struct s_scenario_injection {
+	OBJECT *obj;			///< node the power is injected into
+	complex power;			///< power injected into the bus (generation is positive)
+} SCENARIO_INJECTION;
+
+typedef struct s_scenario {
+	std::string name;		///< scenario name
+	std::string nodes;		///< names of the nodes the scenario injects into
+	complex power;			///< total power injected by the scenario
+	std::vector<SCENARIO_INJECTION> injection;	///< injections of the scenario
+} SCENARIO;
+
+class scenario_batch : public gld_object
+{
+public:
+	TIMESTAMP runtime;
+	char1024 scenarios;
+	char1024 filename;
+	double interval;
+	double voltage_low;
+	double voltage_high;
+	double loading_limit;
+	bool reuse_factorization;
+	int32 scenario_count;
+	int32 runcount;
+	int64 solve_count;
+	int64 iteration_count;
+	int64 factorization_count;
+public:
+	static CLASS *oclass;
+public:
+	scenario_batch(MODULE *mod);
+	int create(void);
+	int init(OBJECT *parent);
+	TIMESTAMP commit(TIMESTAMP t);
+	int isa(CLASSNAME classname);
+
+	void run(TIMESTAMP t);
+private:
+	std::vector<SCENARIO> scenario_list;
+	bool load_scenarios(void);
+	int find_bus(OBJECT *obj);
+};
+
+#endif // _SCENARIO_BATCH_H
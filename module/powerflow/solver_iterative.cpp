@@ -0,0 +1,752 @@
+/** Iterative matrix solver
+	Solves the Newton-Raphson Jacobian with preconditioned restarted GMRES instead
+	of a direct sparse LU factorization.  The preconditioner is an incomplete
+	block LU factorization with no fill (block ILU0), using the dense 2x2 to
+	6x6 block of each bus.  The buses are eliminated in minimum degree order,
+	so a radial feeder factors without any fill and only the loops of a meshed
+	system are approximated.  Because the Jacobian changes little from one
+	iteration or timestep to the next, the preconditioner is kept until the
+	iteration count of the solver grows, and the previous solution is used as a
+	starting point.
+ **/
+
+#include "gridlabd.h"
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "powerflow.h"
+#include "solver_iterative.h"
+
+#define ITERATIVE_TINY 1e-30
+
+typedef struct s_iterative_solver {
+	unsigned int n;						///< size of the system
+	bool stale;							///< preconditioner must be rebuilt before the next solve
+	bool has_solution;					///< x holds the solution of the previous solve
+	int64 base_iterations;				///< iterations used by the first solve after the last rebuild
+	std::vector<double> x;				///< solution of the previous solve
+	unsigned int restart;				///< number of iterations between GMRES restarts
+	std::vector<double> r, z;			///< GMRES work vectors
+	std::vector<double> basis;			///< GMRES Krylov basis (up to restart+1 vectors)
+	std::vector<double> hessenberg;		///< GMRES Hessenberg matrix (by column)
+	std::vector<double> cosine, sine;	///< GMRES Givens rotations
+	std::vector<double> residual;		///< GMRES least squares right-hand side
+
+	// bus blocks
+	std::vector<unsigned int> blocks;		///< requested block sizes
+	std::vector<unsigned int> block_start;	///< first row of each block as built
+
+	// block ILU0 preconditioner (compressed block rows in elimination order)
+	std::vector<unsigned int> block_order;	///< block eliminated at each step
+	std::vector<int> bilu_ptr;				///< first entry of each block row
+	std::vector<unsigned int> bilu_col;		///< elimination step of the block column of each entry
+	std::vector<size_t> bilu_offset;		///< offset of each entry in bilu_val
+	std::vector<int> bilu_diag;				///< diagonal entry of each block row
+	std::vector<double> bilu_val;			///< dense L and U blocks
+	std::vector<size_t> bilu_inverse_offset;	///< offset of each block in bilu_inverse
+	std::vector<double> bilu_inverse;		///< inverse of the diagonal U blocks
+	std::vector<double> bilu_work;			///< block work vector
+} ITERATIVESOLVER;
+
+static HEAPACCOUNT *iterative_account = NULL;
+
+template <class T> static size_t vector_bytes(const std::vector<T> &data)
+{
+	return data.capacity()*sizeof(T);
+}
+
+static void iterative_account_update(ITERATIVESOLVER *solver)
+{
+	if ( iterative_account == NULL )
+	{
+		iterative_account = gl_heap_account("powerflow","NR iterative");
+	}
+	size_t bytes = sizeof(ITERATIVESOLVER)
+		+ vector_bytes(solver->x) + vector_bytes(solver->r) + vector_bytes(solver->z)
+		+ vector_bytes(solver->basis) + vector_bytes(solver->hessenberg)
+		+ vector_bytes(solver->cosine) + vector_bytes(solver->sine) + vector_bytes(solver->residual)
+		+ vector_bytes(solver->blocks) + vector_bytes(solver->block_start)
+		+ vector_bytes(solver->block_order) + vector_bytes(solver->bilu_ptr) + vector_bytes(solver->bilu_col)
+		+ vector_bytes(solver->bilu_offset) + vector_bytes(solver->bilu_diag) + vector_bytes(solver->bilu_val)
+		+ vector_bytes(solver->bilu_inverse_offset) + vector_bytes(solver->bilu_inverse) + vector_bytes(solver->bilu_work);
+	gl_heap_set(iterative_account,1,bytes);
+}
+
+static double vector_dot(unsigned int n, const double *a, const double *b)
+{
+	double sum = 0.0;
+	for ( unsigned int i = 0 ; i < n ; i++ )
+	{
+		sum += a[i]*b[i];
+	}
+	return sum;
+}
+
+static double vector_norm(unsigned int n, const double *a)
+{
+	return sqrt(vector_dot(n,a,a));
+}
+
+// y = A*x, where A is in compressed column form
+static void matrix_multiply(unsigned int n, NR_SOLVER_VARS *A, const double *x, double *y)
+{
+	memset(y,0,n*sizeof(double));
+	for ( unsigned int col = 0 ; col < n ; col++ )
+	{
+		double xc = x[col];
+		if ( xc != 0.0 )
+		{
+			for ( int k = A->cols_LU[col] ; k < A->cols_LU[col+1] ; k++ )
+			{
+				y[A->rows_LU[k]] += A->a_LU[k]*xc;
+			}
+		}
+	}
+}
+
+// lay out the bus blocks, or single rows when the blocks do not cover the system
+static void layout_blocks(ITERATIVESOLVER *solver)
+{
+	unsigned int n = solver->n;
+	unsigned int total = 0;
+	for ( std::vector<unsigned int>::iterator size = solver->blocks.begin() ; size != solver->blocks.end() ; size++ )
+	{
+		total += *size;
+	}
+	solver->block_start.clear();
+	if ( total == n )
+	{
+		unsigned int start = 0;
+		for ( std::vector<unsigned int>::iterator size = solver->blocks.begin() ; size != solver->blocks.end() ; size++ )
+		{
+			if ( *size > 0 )
+			{
+				solver->block_start.push_back(start);
+				start += *size;
+			}
+		}
+	}
+	else
+	{
+		for ( unsigned int row = 0 ; row < n ; row++ )
+		{
+			solver->block_start.push_back(row);
+		}
+	}
+	solver->block_start.push_back(n);
+}
+
+// order the bus blocks by minimum degree of the elimination graph
+static void order_blocks(ITERATIVESOLVER *solver, NR_SOLVER_VARS *A, std::vector<unsigned int> &order)
+{
+	unsigned int n = solver->n;
+	unsigned int nblocks = (unsigned int)solver->block_start.size()-1;
+	std::vector<unsigned int> block_of(n);
+	for ( unsigned int b = 0 ; b < nblocks ; b++ )
+	{
+		for ( unsigned int row = solver->block_start[b] ; row < solver->block_start[b+1] ; row++ )
+		{
+			block_of[row] = b;
+		}
+	}
+	std::vector< std::set<unsigned int> > adjacent(nblocks);
+	for ( unsigned int col = 0 ; col < n ; col++ )
+	{
+		for ( int k = A->cols_LU[col] ; k < A->cols_LU[col+1] ; k++ )
+		{
+			unsigned int from = block_of[A->rows_LU[k]], to = block_of[col];
+			if ( from != to )
+			{
+				adjacent[from].insert(to);
+				adjacent[to].insert(from);
+			}
+		}
+	}
+	std::set< std::pair<size_t,unsigned int> > queue;
+	for ( unsigned int b = 0 ; b < nblocks ; b++ )
+	{
+		queue.insert(std::make_pair(adjacent[b].size(),b));
+	}
+	order.clear();
+	while ( ! queue.empty() )
+	{
+		unsigned int b = queue.begin()->second;
+		queue.erase(queue.begin());
+		order.push_back(b);
+
+		// eliminating the block connects all its neighbors
+		std::vector<unsigned int> neighbors(adjacent[b].begin(),adjacent[b].end());
+		for ( std::vector<unsigned int>::iterator u = neighbors.begin() ; u != neighbors.end() ; u++ )
+		{
+			queue.erase(std::make_pair(adjacent[*u].size(),*u));
+			adjacent[*u].erase(b);
+			for ( std::vector<unsigned int>::iterator w = neighbors.begin() ; w != neighbors.end() ; w++ )
+			{
+				if ( *w != *u )
+				{
+					adjacent[*u].insert(*w);
+				}
+			}
+			queue.insert(std::make_pair(adjacent[*u].size(),*u));
+		}
+		adjacent[b].clear();
+	}
+}
+
+// invert a small dense block in place with partial pivoting
+static void invert_block(unsigned int size, double *block)
+{
+	std::vector<double> work(block,block+size*size);
+	std::vector<unsigned int> column(size);
+	for ( unsigned int i = 0 ; i < size ; i++ )
+	{
+		column[i] = i;
+	}
+	memset(block,0,size*size*sizeof(double));
+	for ( unsigned int i = 0 ; i < size ; i++ )
+	{
+		block[i*size+i] = 1.0;
+	}
+	for ( unsigned int col = 0 ; col < size ; col++ )
+	{
+		unsigned int best = col;
+		for ( unsigned int row = col+1 ; row < size ; row++ )
+		{
+			if ( fabs(work[row*size+col]) > fabs(work[best*size+col]) )
+			{
+				best = row;
+			}
+		}
+		if ( best != col )
+		{
+			for ( unsigned int k = 0 ; k < size ; k++ )
+			{
+				std::swap(work[col*size+k],work[best*size+k]);
+				std::swap(block[col*size+k],block[best*size+k]);
+			}
+		}
+		double pivot = work[col*size+col];
+		if ( fabs(pivot) < ITERATIVE_TINY )
+		{
+			pivot = work[col*size+col] = 1.0;	// leave a singular direction unscaled
+		}
+		for ( unsigned int k = 0 ; k < size ; k++ )
+		{
+			work[col*size+k] /= pivot;
+			block[col*size+k] /= pivot;
+		}
+		for ( unsigned int row = 0 ; row < size ; row++ )
+		{
+			double factor = work[row*size+col];
+			if ( row != col && factor != 0.0 )
+			{
+				for ( unsigned int k = 0 ; k < size ; k++ )
+				{
+					work[row*size+k] -= factor*work[col*size+k];
+					block[row*size+k] -= factor*block[col*size+k];
+				}
+			}
+		}
+	}
+}
+
+// incomplete block LU factorization restricted to the bus adjacency of the Jacobian
+static void build_block_ilu0(ITERATIVESOLVER *solver, NR_SOLVER_VARS *A)
+{
+	unsigned int n = solver->n;
+	unsigned int nblocks = (unsigned int)solver->block_start.size()-1;
+	std::vector<unsigned int> &order = solver->block_order;
+	order_blocks(solver,A,order);
+	std::vector<unsigned int> step(nblocks), block_of(n);
+	unsigned int largest = 0;
+	for ( unsigned int i = 0 ; i < nblocks ; i++ )
+	{
+		step[order[i]] = i;
+		unsigned int size = solver->block_start[i+1] - solver->block_start[i];
+		largest = ( size > largest ? size : largest );
+		for ( unsigned int row = solver->block_start[i] ; row < solver->block_start[i+1] ; row++ )
+		{
+			block_of[row] = i;
+		}
+	}
+	solver->bilu_work.resize(largest);
+#define BLOCKSIZE(I) (solver->block_start[order[I]+1]-solver->block_start[order[I]])
+#define BLOCKFIRST(I) (solver->block_start[order[I]])
+
+	// compressed rows of the original matrix
+	int nnz = A->cols_LU[n];
+	std::vector<int> row_ptr(n+1,0), row_col(nnz);
+	std::vector<double> row_val(nnz);
+	for ( int k = 0 ; k < nnz ; k++ )
+	{
+		row_ptr[A->rows_LU[k]+1]++;
+	}
+	for ( unsigned int row = 0 ; row < n ; row++ )
+	{
+		row_ptr[row+1] += row_ptr[row];
+	}
+	std::vector<int> next(row_ptr.begin(),row_ptr.end()-1);
+	for ( unsigned int col = 0 ; col < n ; col++ )
+	{
+		for ( int k = A->cols_LU[col] ; k < A->cols_LU[col+1] ; k++ )
+		{
+			row_col[next[A->rows_LU[k]]] = col;
+			row_val[next[A->rows_LU[k]]++] = A->a_LU[k];
+		}
+	}
+
+	// block structure and values in elimination order
+	std::vector<int> entry(nblocks,-1);
+	solver->bilu_ptr.assign(1,0);
+	solver->bilu_col.clear();
+	solver->bilu_offset.clear();
+	solver->bilu_diag.resize(nblocks);
+	size_t space = 0;
+	for ( unsigned int I = 0 ; I < nblocks ; I++ )
+	{
+		std::vector<unsigned int> columns(1,I);
+		for ( unsigned int row = BLOCKFIRST(I) ; row < BLOCKFIRST(I)+BLOCKSIZE(I) ; row++ )
+		{
+			for ( int k = row_ptr[row] ; k < row_ptr[row+1] ; k++ )
+			{
+				columns.push_back(step[block_of[row_col[k]]]);
+			}
+		}
+		std::sort(columns.begin(),columns.end());
+		columns.erase(std::unique(columns.begin(),columns.end()),columns.end());
+		for ( std::vector<unsigned int>::iterator J = columns.begin() ; J != columns.end() ; J++ )
+		{
+			if ( *J == I )
+			{
+				solver->bilu_diag[I] = (int)solver->bilu_col.size();
+			}
+			solver->bilu_col.push_back(*J);
+			solver->bilu_offset.push_back(space);
+			space += BLOCKSIZE(I)*BLOCKSIZE(*J);
+		}
+		solver->bilu_ptr.push_back((int)solver->bilu_col.size());
+	}
+	solver->bilu_val.assign(space,0.0);
+	for ( unsigned int I = 0 ; I < nblocks ; I++ )
+	{
+		for ( int e = solver->bilu_ptr[I] ; e < solver->bilu_ptr[I+1] ; e++ )
+		{
+			entry[solver->bilu_col[e]] = e;
+		}
+		for ( unsigned int row = BLOCKFIRST(I) ; row < BLOCKFIRST(I)+BLOCKSIZE(I) ; row++ )
+		{
+			for ( int k = row_ptr[row] ; k < row_ptr[row+1] ; k++ )
+			{
+				unsigned int J = step[block_of[row_col[k]]];
+				solver->bilu_val[solver->bilu_offset[entry[J]] + (row-BLOCKFIRST(I))*BLOCKSIZE(J) + (row_col[k]-BLOCKFIRST(J))] += row_val[k];
+			}
+		}
+		for ( int e = solver->bilu_ptr[I] ; e < solver->bilu_ptr[I+1] ; e++ )
+		{
+			entry[solver->bilu_col[e]] = -1;
+		}
+	}
+
+	// factor
+	solver->bilu_inverse_offset.resize(nblocks);
+	space = 0;
+	for ( unsigned int I = 0 ; I < nblocks ; I++ )
+	{
+		solver->bilu_inverse_offset[I] = space;
+		space += BLOCKSIZE(I)*BLOCKSIZE(I);
+	}
+	solver->bilu_inverse.assign(space,0.0);
+	std::vector<double> product;
+	for ( unsigned int I = 0 ; I < nblocks ; I++ )
+	{
+		unsigned int si = BLOCKSIZE(I);
+		for ( int e = solver->bilu_ptr[I] ; e < solver->bilu_ptr[I+1] ; e++ )
+		{
+			entry[solver->bilu_col[e]] = e;
+		}
+		for ( int e = solver->bilu_ptr[I] ; e < solver->bilu_ptr[I+1] && solver->bilu_col[e] < I ; e++ )
+		{
+			// L(I,J) = A(I,J) inverse(U(J,J))
+			unsigned int J = solver->bilu_col[e], sj = BLOCKSIZE(J);
+			double *L = &(solver->bilu_val[solver->bilu_offset[e]]);
+			const double *inverse = &(solver->bilu_inverse[solver->bilu_inverse_offset[J]]);
+			product.assign(si*sj,0.0);
+			for ( unsigned int i = 0 ; i < si ; i++ )
+			{
+				for ( unsigned int k = 0 ; k < sj ; k++ )
+				{
+					for ( unsigned int j = 0 ; j < sj ; j++ )
+					{
+						product[i*sj+j] += L[i*sj+k]*inverse[k*sj+j];
+					}
+				}
+			}
+			std::copy(product.begin(),product.end(),L);
+
+			// A(I,K) -= L(I,J) U(J,K) where A(I,K) is in the pattern
+			for ( int f = solver->bilu_diag[J]+1 ; f < solver->bilu_ptr[J+1] ; f++ )
+			{
+				unsigned int K = solver->bilu_col[f];
+				if ( entry[K] < 0 )
+				{
+					continue;
+				}
+				unsigned int sk = BLOCKSIZE(K);
+				const double *U = &(solver->bilu_val[solver->bilu_offset[f]]);
+				double *target = &(solver->bilu_val[solver->bilu_offset[entry[K]]]);
+				for ( unsigned int i = 0 ; i < si ; i++ )
+				{
+					for ( unsigned int k = 0 ; k < sj ; k++ )
+					{
+						double factor = L[i*sj+k];
+						if ( factor != 0.0 )
+						{
+							for ( unsigned int j = 0 ; j < sk ; j++ )
+							{
+								target[i*sk+j] -= factor*U[k*sk+j];
+							}
+						}
+					}
+				}
+			}
+		}
+		double *inverse = &(solver->bilu_inverse[solver->bilu_inverse_offset[I]]);
+		const double *diagonal = &(solver->bilu_val[solver->bilu_offset[solver->bilu_diag[I]]]);
+		std::copy(diagonal,diagonal+si*si,inverse);
+		invert_block(si,inverse);
+		for ( int e = solver->bilu_ptr[I] ; e < solver->bilu_ptr[I+1] ; e++ )
+		{
+			entry[solver->bilu_col[e]] = -1;
+		}
+	}
+#undef BLOCKSIZE
+#undef BLOCKFIRST
+}
+
+// z = inverse(LU) y
+static void apply_block_ilu0(ITERATIVESOLVER *solver, const double *y, double *z)
+{
+	unsigned int nblocks = (unsigned int)solver->block_order.size();
+	const std::vector<unsigned int> &order = solver->block_order;
+	double *work = &(solver->bilu_work[0]);
+#define BLOCKSIZE(I) (solver->block_start[order[I]+1]-solver->block_start[order[I]])
+#define BLOCKFIRST(I) (solver->block_start[order[I]])
+	for ( unsigned int I = 0 ; I < nblocks ; I++ )
+	{
+		unsigned int si = BLOCKSIZE(I);
+		double *zi = z + BLOCKFIRST(I);
+		memcpy(zi,y+BLOCKFIRST(I),si*sizeof(double));
+		for ( int e = solver->bilu_ptr[I] ; e < solver->bilu_diag[I] ; e++ )
+		{
+			unsigned int J = solver->bilu_col[e], sj = BLOCKSIZE(J);
+			const double *L = &(solver->bilu_val[solver->bilu_offset[e]]);
+			const double *zj = z + BLOCKFIRST(J);
+			for ( unsigned int i = 0 ; i < si ; i++ )
+			{
+				for ( unsigned int j = 0 ; j < sj ; j++ )
+				{
+					zi[i] -= L[i*sj+j]*zj[j];
+				}
+			}
+		}
+	}
+	for ( int I = (int)nblocks-1 ; I >= 0 ; I-- )
+	{
+		unsigned int si = BLOCKSIZE(I);
+		double *zi = z + BLOCKFIRST(I);
+		for ( int e = solver->bilu_diag[I]+1 ; e < solver->bilu_ptr[I+1] ; e++ )
+		{
+			unsigned int K = solver->bilu_col[e], sk = BLOCKSIZE(K);
+			const double *U = &(solver->bilu_val[solver->bilu_offset[e]]);
+			const double *zk = z + BLOCKFIRST(K);
+			for ( unsigned int i = 0 ; i < si ; i++ )
+			{
+				for ( unsigned int k = 0 ; k < sk ; k++ )
+				{
+					zi[i] -= U[i*sk+k]*zk[k];
+				}
+			}
+		}
+		const double *inverse = &(solver->bilu_inverse[solver->bilu_inverse_offset[I]]);
+		for ( unsigned int i = 0 ; i < si ; i++ )
+		{
+			work[i] = 0.0;
+			for ( unsigned int j = 0 ; j < si ; j++ )
+			{
+				work[i] += inverse[i*si+j]*zi[j];
+			}
+		}
+		memcpy(zi,work,si*sizeof(double));
+	}
+#undef BLOCKSIZE
+#undef BLOCKFIRST
+}
+
+static void build_preconditioner(ITERATIVESOLVER *solver, NR_SOLVER_VARS *A)
+{
+	layout_blocks(solver);
+	build_block_ilu0(solver,A);
+	solver->stale = false;
+	solver->base_iterations = 0;
+	NR_iterative_refresh_count++;
+	iterative_account_update(solver);
+}
+
+// right-preconditioned restarted GMRES starting from solver->x; returns the
+// number of iterations used, or -1 if the solver did not converge
+static int64 gmres(ITERATIVESOLVER *solver, NR_SOLVER_VARS *A, const double *b, double bnorm)
+{
+	unsigned int n = solver->n;
+	unsigned int m = solver->restart;
+	double *x = &(solver->x[0]);
+	double *r = &(solver->r[0]);
+	double *z = &(solver->z[0]);
+	double *V = &(solver->basis[0]);	// grows as the Krylov space is extended
+	double *H = &(solver->hessenberg[0]);
+	double *c = &(solver->cosine[0]);
+	double *sn = &(solver->sine[0]);
+	double *g = &(solver->residual[0]);
+	double limit = NR_iterative_tolerance*bnorm;
+	int64 iterations = 0;
+
+	while ( true )
+	{
+		matrix_multiply(n,A,x,r);
+		for ( unsigned int i = 0 ; i < n ; i++ )
+		{
+			r[i] = b[i] - r[i];
+		}
+		double beta = vector_norm(n,r);
+		if ( beta <= limit )
+		{
+			return iterations;
+		}
+		if ( iterations >= NR_iterative_iteration_limit )
+		{
+			return -1;
+		}
+		for ( unsigned int i = 0 ; i < n ; i++ )
+		{
+			V[i] = r[i]/beta;
+		}
+		memset(g,0,(m+1)*sizeof(double));
+		g[0] = beta;
+
+		// Arnoldi process with Givens rotations
+		unsigned int k = 0;
+		while ( k < m && iterations < NR_iterative_iteration_limit )
+		{
+			if ( solver->basis.size() < (size_t)(k+2)*n )
+			{
+				solver->basis.resize((size_t)(k+2)*n);
+				V = &(solver->basis[0]);
+				iterative_account_update(solver);
+			}
+			double *w = V + (size_t)(k+1)*n;
+			double *h = H + (size_t)k*(m+1);
+			apply_block_ilu0(solver,V+(size_t)k*n,z);
+			matrix_multiply(n,A,z,w);
+			for ( unsigned int i = 0 ; i <= k ; i++ )
+			{
+				h[i] = vector_dot(n,w,V+(size_t)i*n);
+				for ( unsigned int j = 0 ; j < n ; j++ )
+				{
+					w[j] -= h[i]*V[(size_t)i*n+j];
+				}
+			}
+			h[k+1] = vector_norm(n,w);
+			if ( h[k+1] > ITERATIVE_TINY )
+			{
+				for ( unsigned int j = 0 ; j < n ; j++ )
+				{
+					w[j] /= h[k+1];
+				}
+			}
+			for ( unsigned int i = 0 ; i < k ; i++ )
+			{
+				double temp = c[i]*h[i] + sn[i]*h[i+1];
+				h[i+1] = -sn[i]*h[i] + c[i]*h[i+1];
+				h[i] = temp;
+			}
+			double rho = sqrt(h[k]*h[k] + h[k+1]*h[k+1]);
+			if ( rho < ITERATIVE_TINY )
+			{
+				return -1;	// breakdown
+			}
+			c[k] = h[k]/rho;
+			sn[k] = h[k+1]/rho;
+			h[k] = rho;
+			h[k+1] = 0.0;
+			g[k+1] = -sn[k]*g[k];
+			g[k] = c[k]*g[k];
+			iterations++;
+			k++;
+			if ( fabs(g[k]) <= limit )
+			{
+				break;
+			}
+		}
+
+		// update the solution with the least squares combination of the basis
+		for ( int i = (int)k-1 ; i >= 0 ; i-- )
+		{
+			for ( unsigned int j = i+1 ; j < k ; j++ )
+			{
+				g[i] -= H[(size_t)j*(m+1)+i]*g[j];
+			}
+			g[i] /= H[(size_t)i*(m+1)+i];
+		}
+		memset(r,0,n*sizeof(double));
+		for ( unsigned int i = 0 ; i < k ; i++ )
+		{
+			for ( unsigned int j = 0 ; j < n ; j++ )
+			{
+				r[j] += g[i]*V[(size_t)i*n+j];
+			}
+		}
+		apply_block_ilu0(solver,r,z);
+		for ( unsigned int i = 0 ; i < n ; i++ )
+		{
+			x[i] += z[i];
+		}
+	}
+}
+
+// choose the starting point: the previous solution if it is closer than zero
+static void starting_point(ITERATIVESOLVER *solver, NR_SOLVER_VARS *A, const double *b, double bnorm)
+{
+	unsigned int n = solver->n;
+	if ( solver->has_solution )
+	{
+		double *r = &(solver->r[0]);
+		matrix_multiply(n,A,&(solver->x[0]),r);
+		for ( unsigned int i = 0 ; i < n ; i++ )
+		{
+			r[i] = b[i] - r[i];
+		}
+		if ( vector_norm(n,r) < bnorm )
+		{
+			return;
+		}
+	}
+	solver->x.assign(n,0.0);
+}
+
+static void resize(ITERATIVESOLVER *solver, unsigned int n)
+{
+	solver->n = n;
+	solver->restart = (unsigned int)( NR_iterative_restart < 1 ? 1 : ( NR_iterative_restart > n ? n : NR_iterative_restart ) );
+	solver->stale = true;
+	solver->has_solution = false;
+	solver->x.assign(n,0.0);
+	solver->r.resize(n);
+	solver->z.resize(n);
+	solver->basis.resize(n);
+	solver->hessenberg.resize((size_t)(solver->restart+1)*solver->restart);
+	solver->cosine.resize(solver->restart);
+	solver->sine.resize(solver->restart);
+	solver->residual.resize(solver->restart+1);
+}
+
+void *iterative_solver_init(void *ext_array)
+{
+	if ( ext_array == NULL )
+	{
+		ITERATIVESOLVER *solver = new ITERATIVESOLVER;
+		solver->n = 0;
+		solver->restart = 0;
+		solver->stale = true;
+		solver->has_solution = false;
+		solver->base_iterations = 0;
+		ext_array = (void*)solver;
+	}
+	return ext_array;
+}
+
+void iterative_solver_alloc(void *ext_array, unsigned int rowcount, unsigned int colcount, bool admittance_change)
+{
+	ITERATIVESOLVER *solver = (ITERATIVESOLVER*)ext_array;
+	if ( solver->n != rowcount )
+	{
+		resize(solver,rowcount);
+	}
+	else
+	{
+		// the sparsity pattern may have changed
+		solver->stale = true;
+	}
+}
+
+int iterative_solver_solve(void *ext_array, NR_SOLVER_VARS *system_info_vars, unsigned int rowcount, unsigned int colcount)
+{
+	ITERATIVESOLVER *solver = (ITERATIVESOLVER*)ext_array;
+	if ( solver->n != rowcount )
+	{
+		resize(solver,rowcount);
+	}
+	unsigned int n = solver->n;
+	double *b = system_info_vars->rhs_LU;
+	double bnorm = vector_norm(n,b);
+	if ( bnorm == 0.0 )
+	{
+		return 0; // the solution is zero, which is already in rhs_LU
+	}
+
+	bool refreshed = false;
+	if ( solver->stale || NR_iterative_refresh_ratio <= 0.0 )
+	{
+		build_preconditioner(solver,system_info_vars);
+		refreshed = true;
+	}
+	starting_point(solver,system_info_vars,b,bnorm);
+	int64 iterations = gmres(solver,system_info_vars,b,bnorm);
+	if ( iterations < 0 && ! refreshed )
+	{
+		// the preconditioner may have drifted too far from the Jacobian
+		build_preconditioner(solver,system_info_vars);
+		refreshed = true;
+		solver->x.assign(n,0.0);
+		iterations = gmres(solver,system_info_vars,b,bnorm);
+	}
+	if ( iterations < 0 )
+	{
+		gl_verbose("iterative_solver_solve(): GMRES did not converge within %lld iterations for a system of size %u", NR_iterative_iteration_limit, n);
+		solver->has_solution = false;
+		solver->stale = true;
+		return 1;
+	}
+	NR_iterative_iteration_count += iterations;
+
+	// refresh the preconditioner when the iteration count grows too much
+	if ( refreshed )
+	{
+		solver->base_iterations = iterations;
+	}
+	else if ( iterations > NR_iterative_refresh_ratio*(solver->base_iterations > 0 ? solver->base_iterations : 1) )
+	{
+		solver->stale = true;
+	}
+
+	memcpy(b,&(solver->x[0]),n*sizeof(double));
+	solver->has_solution = true;
+	return 0;
+}
+
+void iterative_solver_destroy(void *ext_array, bool new_iteration)
+{
+	// the preconditioner and previous solution are kept for the next solve
+}
+
+void iterative_solver_blocks(void *ext_array, unsigned int count, unsigned int *block_size)
+{
+	ITERATIVESOLVER *solver = (ITERATIVESOLVER*)ext_array;
+	if ( solver->blocks.size() != count || ! std::equal(solver->blocks.begin(),solver->blocks.end(),block_size) )
+	{
+		solver->blocks.assign(block_size,block_size+count);
+		solver->stale = true;
+	}
+}
@@ -0,0 +1,43 @@
+// powerflow/solver_iterative.h
+// Copyright (C) 2026, Regents of the Leland Stanford Junior University
+
+#ifndef _SOLVER_ITERATIVE
+#define _SOLVER_ITERATIVE
+
+#include "solver_nr.h"
+
+//	Built-in iterative matrix solver for Newton-Raphson
+//
+//	The iterative solver uses preconditioned restarted GMRES on the Jacobian built
+//	by solver_nr.  It is selected with `lu_solver "iterative"` and is linked
+//	through the same entry points as an external LU solver library, so
+//	solver_nr treats it as MM_EXTERN.  The solution of the previous solve is
+//	used as a starting point when it is closer than zero, and the
+//	preconditioner is only rebuilt when the system changes or the iteration
+//	count grows by more than NR_iterative_refresh_ratio.
+
+#define ITERATIVE_SOLVER_NAME "iterative"
+
+//	Function: iterative_solver_init
+//	Allocate the solver state (LU_init)
+void *iterative_solver_init(void *ext_array);
+
+//	Function: iterative_solver_alloc
+//	Prepare the solver state for a new system size (LU_alloc)
+void iterative_solver_alloc(void *ext_array, unsigned int rowcount, unsigned int colcount, bool admittance_change);
+
+//	Function: iterative_solver_solve
+//	Solve the system, leaving the solution in system_info_vars->rhs_LU (LU_solve)
+//
+//	Return: 0 on success, non-zero on failure
+int iterative_solver_solve(void *ext_array, NR_SOLVER_VARS *system_info_vars, unsigned int rowcount, unsigned int colcount);
+
+//	Function: iterative_solver_destroy
+//	Release per-solve data (LU_destroy); the preconditioner is kept
+void iterative_solver_destroy(void *ext_array, bool new_iteration);
+
+//	Function: iterative_solver_blocks
+//	Set the number of rows of each bus, used to order the preconditioner (LU_blocks)
+void iterative_solver_blocks(void *ext_array, unsigned int count, unsigned int *block_size);
+
+#endif
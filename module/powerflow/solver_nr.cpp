@@ -32,10 +32,13 @@ Initialization after returning to service?
 */
 
 #include <unistd.h>
+#include <map>
+#include <vector>
 
 #include "solver_nr.h"
 
 #include "solver_py.h"
+#include "solver_reduce.h"
 
 using namespace std;
 
@@ -59,11 +62,365 @@ NR_SOLVER_VARS matrices_LU;
 int *perm_c, *perm_r;
 SuperMatrix A_LU,B_LU;
 
+//Chord method variables - factorization retained across iterations and timesteps
+SuperMatrix L_chord,U_chord;
+NR_SOLVER_STRUCT *chord_owner = NULL;	//Solver structure the retained factors belong to (NULL = none retained)
+unsigned int chord_size = 0;			//Size of the retained factorization
+int64 chord_age = 0;					//Iterations solved with the retained factorization
+
+//Chord method topology updates - when the admittance changes, the retained factors of A0 solve A0 + E*D instead,
+//where E selects the rows of the buses whose couplings changed and D holds the difference of those rows
+//(Sherman-Morrison-Woodbury: inverse(A0 + E*D) = inverse(A0) - W*inverse(I + D*W)*D*inverse(A0), W = inverse(A0)*E)
+#define CHORD_UPDATE_MAX_ROWS 96		//Largest update applied to the retained factors, in matrix rows
+#define CHORD_UPDATE_TOLERANCE 1e-8		//Largest componentwise backward error of the first solution with an update
+std::vector<int> chord_A_cols, chord_A_rows;	//Copy of the factored matrix A0 (compressed column)
+std::vector<double> chord_A_vals;
+std::vector<int> chord_E_rows;			//Matrix rows replaced by the update (columns of E)
+std::vector<int> chord_D_ptr, chord_D_cols;	//Rows of D (compressed row)
+std::vector<double> chord_D_vals;
+std::vector<double> chord_W;			//W = inverse(A0)*E, column major
+std::vector<double> chord_C;			//LU factors of I + D*W, column major
+std::vector<int> chord_C_piv;			//Row pivots of the LU factors of I + D*W
+int64 chord_updates = 0;				//Topology updates applied since the last factorization
+
+//Release the retained chord factorization
+static void chord_release(void)
+{
+	if (chord_owner != NULL)
+	{
+#ifdef MT
+		Destroy_SuperNode_SCP(&L_chord);
+		Destroy_CompCol_NCP(&U_chord);
+#else
+		Destroy_SuperNode_Matrix(&L_chord);
+		Destroy_CompCol_Matrix(&U_chord);
+#endif
+		chord_owner = NULL;
+	}
+	std::vector<int>().swap(chord_A_cols);
+	std::vector<int>().swap(chord_A_rows);
+	std::vector<double>().swap(chord_A_vals);
+	chord_E_rows.clear();
+	std::vector<double>().swap(chord_W);
+	chord_updates = 0;
+}
+
+//Solve with the retained chord factors, including the topology update - B holds the right-hand side on entry and the solution on exit
+static void chord_solve(SuperMatrix *B, int *info)
+{
+#ifdef MT
+	//dgstrs only records its operation count
+	flops_t chord_ops[NPHASES];
+	Gstat_t chord_stat;
+	chord_stat.ops = chord_ops;
+
+	dgstrs(NOTRANS, &L_chord, &U_chord, perm_r, perm_c, B, &chord_stat, info);
+#else
+	SuperLUStat_t chord_stat;
+	StatInit(&chord_stat);
+
+	dgstrs(NOTRANS, &L_chord, &U_chord, perm_c, perm_r, B, &chord_stat, info);
+
+	StatFree(&chord_stat);
+#endif
+
+	size_t k = chord_E_rows.size();
+	if ((k == 0) || (*info != 0))
+	{
+		return;
+	}
+
+	//x = y - W*inverse(I + D*W)*D*y, with y = inverse(A0)*b
+	size_t n = chord_size;
+	double *x = (double*)((DNformat*)B->Store)->nzval;
+	std::vector<double> z(k,0.0);
+	for (size_t i=0; i<k; i++)
+	{
+		for (int p=chord_D_ptr[i]; p<chord_D_ptr[i+1]; p++)
+		{
+			z[i] += chord_D_vals[p]*x[chord_D_cols[p]];
+		}
+	}
+	for (size_t i=0; i<k; i++)
+	{
+		std::swap(z[i],z[chord_C_piv[i]]);
+		for (size_t j=0; j<i; j++)
+		{
+			z[i] -= chord_C[i+j*k]*z[j];
+		}
+	}
+	for (size_t i=k; i-->0; )
+	{
+		for (size_t j=i+1; j<k; j++)
+		{
+			z[i] -= chord_C[i+j*k]*z[j];
+		}
+		z[i] /= chord_C[i+i*k];
+	}
+	for (size_t j=0; j<k; j++)
+	{
+		const double *w = &chord_W[j*n];
+		for (size_t r=0; r<n; r++)
+		{
+			x[r] -= w[r]*z[j];
+		}
+	}
+}
+
+//Componentwise backward error of x as a solution of (A0 + E*D)*x = b, r receives the residual
+static double chord_error(const double *x, const double *b, std::vector<double> &r)
+{
+	size_t n = chord_size;
+	std::vector<double> s(n);
+	r.resize(n);
+	for (size_t i=0; i<n; i++)
+	{
+		r[i] = -b[i];
+		s[i] = fabs(b[i]);
+	}
+	for (size_t c=0; c<n; c++)
+	{
+		for (int p=chord_A_cols[c]; p<chord_A_cols[c+1]; p++)
+		{
+			r[chord_A_rows[p]] += chord_A_vals[p]*x[c];
+			s[chord_A_rows[p]] += fabs(chord_A_vals[p]*x[c]);
+		}
+	}
+	for (size_t i=0; i<chord_E_rows.size(); i++)
+	{
+		for (int p=chord_D_ptr[i]; p<chord_D_ptr[i+1]; p++)
+		{
+			r[chord_E_rows[i]] += chord_D_vals[p]*x[chord_D_cols[p]];
+			s[chord_E_rows[i]] += fabs(chord_D_vals[p]*x[chord_D_cols[p]]);
+		}
+	}
+	double error = 0.0;
+	for (size_t i=0; i<n; i++)
+	{
+		if (s[i] > 0.0 && fabs(r[i]) > error*s[i])
+		{
+			error = fabs(r[i])/s[i];
+		}
+	}
+	return error;
+}
+
+//Check a solution with a new topology update and refine it once if needed - returns its backward error
+static double chord_refine(double *x, const double *b)
+{
+	std::vector<double> r;
+	double error = chord_error(x,b,r);
+	if (error > CHORD_UPDATE_TOLERANCE)
+	{
+		DNformat R_store;
+		R_store.lda = chord_size;
+		R_store.nzval = &r[0];
+		SuperMatrix R_mat;
+		R_mat.Stype = SLU_DN;
+		R_mat.Dtype = SLU_D;
+		R_mat.Mtype = SLU_GE;
+		R_mat.nrow = chord_size;
+		R_mat.ncol = 1;
+		R_mat.Store = &R_store;
+		int info = 0;
+		chord_solve(&R_mat,&info);
+		if (info != 0)
+		{
+			return error;
+		}
+		for (size_t i=0; i<chord_size; i++)
+		{
+			x[i] -= r[i];
+		}
+		error = chord_error(x,b,r);
+	}
+	return error;
+}
+
+//Update the retained chord factors to the new matrix A1 after a topology change.  The rows of the buses with a changed
+//coupling to another bus are taken from A1, which also updates their self admittance.  The other rows keep A0, like any
+//chord iteration.  The update is always made relative to A0, so a change that is undone again costs nothing.
+//Returns false when the update is too large or too poorly conditioned, and the matrix must be factored instead.
+static bool chord_update(NR_SOLVER_VARS *A1, unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values)
+{
+	size_t n = chord_size;
+
+	//Bus of each matrix row
+	std::vector<int> block(n,-1);
+	for (unsigned int b=0; b<bus_count; b++)
+	{
+		for (int r=0; r<2*powerflow_values->BA_diag[b].size; r++)
+		{
+			block[2*bus[b].Matrix_Loc+r] = b;
+		}
+	}
+
+	//Find the buses whose couplings to other buses changed, and the differences of their rows
+	std::vector<bool> changed(bus_count,false);
+	std::vector<int> slot(n,-1);
+	std::vector<double> diff(n,0.0);
+	std::vector<int> touched;
+	std::vector< std::vector< std::pair<int,double> > > rows;
+	for (int pass=0; pass<2; pass++)
+	{
+		for (size_t c=0; c<n; c++)
+		{
+			touched.clear();
+			for (int p=chord_A_cols[c]; p<chord_A_cols[c+1]; p++)
+			{
+				diff[chord_A_rows[p]] -= chord_A_vals[p];
+				touched.push_back(chord_A_rows[p]);
+			}
+			for (int p=A1->cols_LU[c]; p<A1->cols_LU[c+1]; p++)
+			{
+				diff[A1->rows_LU[p]] += A1->a_LU[p];
+				touched.push_back(A1->rows_LU[p]);
+			}
+			for (size_t t=0; t<touched.size(); t++)
+			{
+				int r = touched[t];
+				if (diff[r] != 0.0)
+				{
+					if ((pass == 0) && (block[r] != block[c]) && (block[r] >= 0))
+					{
+						changed[block[r]] = true;
+					}
+					else if ((pass == 1) && (slot[r] >= 0))
+					{
+						rows[slot[r]].push_back(std::pair<int,double>(c,diff[r]));
+					}
+				}
+				diff[r] = 0.0;
+			}
+		}
+		if (pass == 0)
+		{
+			chord_E_rows.clear();
+			for (size_t r=0; r<n; r++)
+			{
+				if ((block[r] >= 0) && changed[block[r]])
+				{
+					slot[r] = chord_E_rows.size();
+					chord_E_rows.push_back(r);
+				}
+			}
+			if (chord_E_rows.size() > CHORD_UPDATE_MAX_ROWS)
+			{
+				chord_E_rows.clear();
+				return false;
+			}
+			rows.resize(chord_E_rows.size());
+		}
+	}
+
+	//Nothing to update, the factors describe the new matrix
+	size_t k = chord_E_rows.size();
+	if (k == 0)
+	{
+		std::vector<double>().swap(chord_W);
+		return true;
+	}
+
+	//Rows of D
+	chord_D_ptr.assign(1,0);
+	chord_D_cols.clear();
+	chord_D_vals.clear();
+	for (size_t i=0; i<k; i++)
+	{
+		for (size_t p=0; p<rows[i].size(); p++)
+		{
+			chord_D_cols.push_back(rows[i][p].first);
+			chord_D_vals.push_back(rows[i][p].second);
+		}
+		chord_D_ptr.push_back(chord_D_cols.size());
+	}
+
+	//W = inverse(A0)*E
+	chord_W.assign(n*k,0.0);
+	for (size_t j=0; j<k; j++)
+	{
+		chord_W[j*n+chord_E_rows[j]] = 1.0;
+	}
+	DNformat W_store;
+	W_store.lda = n;
+	W_store.nzval = &chord_W[0];
+	SuperMatrix W_mat;
+	W_mat.Stype = SLU_DN;
+	W_mat.Dtype = SLU_D;
+	W_mat.Mtype = SLU_GE;
+	W_mat.nrow = n;
+	W_mat.ncol = k;
+	W_mat.Store = &W_store;
+	std::vector<int> E_rows;
+	E_rows.swap(chord_E_rows);	//Solve with A0 alone
+	int info = 0;
+	chord_solve(&W_mat,&info);
+	E_rows.swap(chord_E_rows);
+	if (info != 0)
+	{
+		chord_E_rows.clear();
+		return false;
+	}
+
+	//LU factors of I + D*W with partial pivoting
+	chord_C.assign(k*k,0.0);
+	chord_C_piv.resize(k);
+	for (size_t j=0; j<k; j++)
+	{
+		chord_C[j+j*k] = 1.0;
+		for (size_t i=0; i<k; i++)
+		{
+			for (int p=chord_D_ptr[i]; p<chord_D_ptr[i+1]; p++)
+			{
+				chord_C[i+j*k] += chord_D_vals[p]*chord_W[j*n+chord_D_cols[p]];
+			}
+		}
+	}
+	double pivot_max = 0.0, pivot_min = 0.0;
+	for (size_t j=0; j<k; j++)
+	{
+		size_t pivot = j;
+		for (size_t i=j+1; i<k; i++)
+		{
+			if (fabs(chord_C[i+j*k]) > fabs(chord_C[pivot+j*k]))
+			{
+				pivot = i;
+			}
+		}
+		chord_C_piv[j] = pivot;
+		for (size_t c=0; c<k; c++)
+		{
+			std::swap(chord_C[j+c*k],chord_C[pivot+c*k]);
+		}
+		double u = fabs(chord_C[j+j*k]);
+		pivot_max = (j == 0 || u > pivot_max) ? u : pivot_max;
+		pivot_min = (j == 0 || u < pivot_min) ? u : pivot_min;
+		if (u == 0.0)
+		{
+			break;
+		}
+		for (size_t i=j+1; i<k; i++)
+		{
+			chord_C[i+j*k] /= chord_C[j+j*k];
+			for (size_t c=j+1; c<k; c++)
+			{
+				chord_C[i+c*k] -= chord_C[i+j*k]*chord_C[j+c*k];
+			}
+		}
+	}
+	if (pivot_min <= 1e-12*pivot_max)
+	{
+		chord_E_rows.clear();
+		return false;
+	}
+	return true;
+}
+
 //External solver global
 void *ext_solver_glob_vars;
 
 char1024 solver_profile_filename =  "solver_nr_profile.csv";
-char1024 solver_headers =  "timestamp,duration[microsec],iteration,bus_count,branch_count,error";
+char1024 solver_headers =  "timestamp,duration[microsec],iteration,bus_count,branch_count,error,factorizations";
 static FILE * nr_profile = NULL;
 bool solver_profile_headers_included = true;
 bool solver_profile_enable = false;
@@ -297,6 +654,15 @@ int64 solver_nr(unsigned int bus_count,
 	//Voltage mismatch tracking variable
 	double Maxmismatch = 0.0;
 
+	//Chord method tracking variables - only normal superLU powerflows retain their factorization
+	bool chord_enabled = NR_chord_newton && (matrix_solver_method==MM_SUPERLU) && (mesh_imped_vals==NULL) && (powerflow_type==PF_NORMAL);
+	bool chord_reuse = false;
+	bool chord_stale = false;
+	bool chord_topology = false;
+	bool chord_check = false;
+	double chord_prev_mismatch = -1.0;
+	int64 chord_factors = 0;
+
 	// SuperLU variable
 	int info;
 
@@ -2230,12 +2596,33 @@ int64 solver_nr(unsigned int bus_count,
 			}//End bus parse for fixed diagonal
 		}//End admittance update
 
+		//Drop the retained chord factorization if it no longer describes this system - an admittance change
+		//is applied to it as a low-rank update instead, until NR_chord_update_limit updates have been made
+		if ((chord_owner != NULL) && (!chord_enabled || (chord_owner != powerflow_values)))
+		{
+			chord_release();
+		}
+		else if ((chord_owner != NULL) && NR_admit_change)
+		{
+			if (chord_updates < NR_chord_update_limit)
+			{
+				chord_topology = true;
+			}
+			else
+			{
+				chord_release();
+			}
+		}
+
 		//Reset saturation checks
 		SaturationMismatchPresent = false;
 
 		//Calculate the system load - this is the specified power of the system
 		for (Iteration=0; Iteration<NR_iteration_limit; Iteration++)
 		{
+			//Refresh the equivalent loads of folded secondaries, if this is a reduced system
+			solver_reduce_update(bus);
+
 			//Call the load subfunction
 			compute_load_values(bus_count,bus,powerflow_values,false);
 		
@@ -2967,8 +3354,15 @@ int64 solver_nr(unsigned int bus_count,
 				}//End dynamic (generator postings)
 			}//End delta_I for each bus
 
-			//Call the load subfunction - flag for Jacobian update
-			compute_load_values(bus_count,bus,powerflow_values,true);
+			//Decide whether the retained chord factorization can solve this iteration - it skips the Jacobian update and factorization
+			chord_reuse = chord_enabled && (chord_owner == powerflow_values) && (chord_size == 2*powerflow_values->total_variables)
+				&& !chord_stale && (chord_age < NR_chord_age_limit) && !powerflow_values->NR_realloc_needed;
+
+			//Call the load subfunction - flag for Jacobian update, which a topology update of the retained factors needs too
+			if (!chord_reuse || chord_topology)
+			{
+				compute_load_values(bus_count,bus,powerflow_values,true);
+			}
 
 			//Build the dynamic diagnal elements of 6n*6n Y matrix. All the elements in this part will be updated at each iteration.
 
@@ -3401,6 +3795,29 @@ int64 solver_nr(unsigned int bus_count,
 				powerflow_values->prev_m = m;
 			}
 
+			//Update the memory report when the size of the matrices of this island changes
+			{
+				static HEAPACCOUNT *nr_account = gl_heap_account("powerflow","NR matrices");
+				static std::map<NR_SOLVER_STRUCT*,int64> nr_bytes;
+				int64 bytes = bus_count*sizeof(Bus_admit)
+					+ (powerflow_values->max_size_offdiag_PQ*2 + powerflow_values->max_size_diag_fixed*2 + powerflow_values->max_size_diag_update*4)*sizeof(Y_NR)
+					+ 2*powerflow_values->max_total_variables*sizeof(double)
+					+ size_Amatrix*sizeof(SP_E) + 6*NR_bus_count*sizeof(SP_E*)
+					+ nnz*(sizeof(double)+sizeof(int)) + (n+1)*sizeof(int) + m*sizeof(double) + (m+n)*sizeof(int);
+				std::map<NR_SOLVER_STRUCT*,int64>::iterator item = nr_bytes.find(powerflow_values);
+				if ( item == nr_bytes.end() )
+				{
+					gl_heap_add(nr_account,bytes);
+					nr_bytes[powerflow_values] = bytes;
+				}
+				else if ( item->second != bytes )
+				{
+					gl_heap_remove(nr_account,item->second);
+					gl_heap_add(nr_account,bytes);
+					item->second = bytes;
+				}
+			}
+
 	#ifndef MT
 			if (matrix_solver_method==MM_SUPERLU)
 			{
@@ -3410,8 +3827,12 @@ int64 solver_nr(unsigned int bus_count,
 			//Default else - not superLU
 	#endif
 			
-			sparse_tonr(powerflow_values->Y_Amatrix, &matrices_LU);
-			matrices_LU.cols_LU[n] = nnz ;// number of non-zeros;
+			//Retained chord factors don't need the matrix itself, unless they are updated to it
+			if (!chord_reuse || chord_topology)
+			{
+				sparse_tonr(powerflow_values->Y_Amatrix, &matrices_LU);
+				matrices_LU.cols_LU[n] = nnz ;// number of non-zeros;
+			}
 
 			//Determine how to populate the rhs vector
 			if (mesh_imped_vals == NULL)	//Normal powerflow, copy in the values
@@ -3439,6 +3860,22 @@ int64 solver_nr(unsigned int bus_count,
 				Bstore->lda = m;
 				Bstore->nzval = matrices_LU.rhs_LU;
 
+				//Apply a topology change to the retained chord factors, or factor the new matrix if it can't be
+				if (chord_topology)
+				{
+					chord_topology = false;
+					if (chord_reuse && chord_update(&matrices_LU,bus_count,bus,powerflow_values))
+					{
+						chord_updates++;
+						chord_check = true;
+					}
+					else
+					{
+						chord_release();
+						chord_reuse = false;
+					}
+				}
+
 				//See how to call the function - if normal mode or not
 				if (mesh_imped_vals != NULL)
 				{
@@ -3666,22 +4103,57 @@ int64 solver_nr(unsigned int bus_count,
 				}//End "just mesh impedance calculations"
 				else	//Nulled, "normal" powerflow
 				{
+	#ifndef MT
+					StatInit ( &stat );
+	#endif
+
+					if (chord_reuse)	//Chord method - triangular solves with the retained factors
+					{
+						//Check the first solution with a new topology update, and factor the matrix instead if it is inaccurate
+						std::vector<double> rhs_check;
+						if (chord_check)
+						{
+							rhs_check.assign(matrices_LU.rhs_LU,matrices_LU.rhs_LU+m);
+						}
+
+						chord_solve(&B_LU,&info);
+
+						if (chord_check)
+						{
+							chord_check = false;
+							double error = (info == 0) ? chord_refine(matrices_LU.rhs_LU,&rhs_check[0]) : 0.0;
+							gl_verbose("solver_nr: chord method topology update of %d rows has a backward error of %.3g",(int)chord_E_rows.size(),error);
+							if (error > CHORD_UPDATE_TOLERANCE)
+							{
+								gl_verbose("solver_nr: chord method topology update is inaccurate, refactoring");
+								memcpy(matrices_LU.rhs_LU,&rhs_check[0],m*sizeof(double));
+								chord_release();
+								chord_reuse = false;
+							}
+							else
+							{
+								NR_chord_update_count++;
+							}
+						}
+					}
+
+					if (!chord_reuse)
+					{
 	#ifdef MT
-					//superLU_MT commands
+						//superLU_MT commands
 
-					//Populate perm_c
-					get_perm_c(1, &A_LU, perm_c);
+						//Populate perm_c
+						get_perm_c(1, &A_LU, perm_c);
 
-					//Solve the system
-					pdgssv(NR_superLU_procs, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &info);
+						//Solve the system
+						pdgssv(NR_superLU_procs, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &info);
 	#else
-					//sequential superLU
-
-					StatInit ( &stat );
+						//sequential superLU
 
-					// solve the system
-					dgssv(&options, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &stat, &info);
+						// solve the system
+						dgssv(&options, &A_LU, perm_c, perm_r, &L_LU, &U_LU, &B_LU, &stat, &info);
 	#endif
+					}
 
 					sol_LU = (double*) ((DNformat*) B_LU.Store)->nzval;
 				}
@@ -3712,6 +4184,18 @@ int64 solver_nr(unsigned int bus_count,
 				}
 				//Default else -- not mesh fault mode, so go like normal
 
+				//Pass the number of rows of each bus, if the solver wants them (bus-ordered preconditioners)
+				if (LUSolverFcns.ext_blocks != NULL)
+				{
+					static std::vector<unsigned int> block_size;
+					block_size.resize(bus_count);
+					for (indexer=0; indexer<bus_count; indexer++)
+					{
+						block_size[indexer] = 2*powerflow_values->BA_diag[indexer].size;
+					}
+					((void (*)(void *, unsigned int, unsigned int *))(LUSolverFcns.ext_blocks))(ext_solver_glob_vars,bus_count,bus_count>0 ? &block_size[0] : NULL);
+				}
+
 				//Call the solver
 				info = ((int (*)(void *,NR_SOLVER_VARS *, unsigned int, unsigned int))(LUSolverFcns.ext_solve))(ext_solver_glob_vars,&matrices_LU,n,1);
 
@@ -3957,7 +4441,62 @@ int64 solver_nr(unsigned int bus_count,
 			//Turn off reallocation flag no matter what
 			powerflow_values->NR_realloc_needed = false;
 
-			if (matrix_solver_method==MM_SUPERLU)
+			//Chord method bookkeeping - refactor next iteration if the updates stopped shrinking fast enough
+			if (chord_enabled)
+			{
+				if (chord_reuse)
+				{
+					chord_age++;
+					if ((chord_prev_mismatch >= 0.0) && (Maxmismatch > NR_chord_contraction*chord_prev_mismatch))
+					{
+						chord_stale = true;
+					}
+				}
+				else
+				{
+					chord_factors++;
+					chord_stale = false;
+				}
+				chord_prev_mismatch = Maxmismatch;
+				NR_chord_iteration_count++;
+			}
+
+			if ((matrix_solver_method==MM_SUPERLU) && chord_enabled)
+			{
+				//Keep a fresh factorization for later iterations and timesteps
+				if (!chord_reuse)
+				{
+					chord_release();
+					if (info == 0)
+					{
+						L_chord = L_LU;
+						U_chord = U_LU;
+						chord_owner = powerflow_values;
+						chord_size = n;
+						chord_age = 0;
+						NR_chord_factor_count++;
+
+						//Keep the factored matrix for topology updates
+						chord_A_cols.assign(matrices_LU.cols_LU,matrices_LU.cols_LU+n+1);
+						chord_A_rows.assign(matrices_LU.rows_LU,matrices_LU.rows_LU+nnz);
+						chord_A_vals.assign(matrices_LU.a_LU,matrices_LU.a_LU+nnz);
+					}
+					else
+					{
+	#ifdef MT
+						Destroy_SuperNode_SCP(&L_LU);
+						Destroy_CompCol_NCP(&U_LU);
+	#else
+						Destroy_SuperNode_Matrix( &L_LU );
+						Destroy_CompCol_Matrix( &U_LU );
+	#endif
+					}
+				}
+	#ifndef MT
+				StatFree ( &stat );
+	#endif
+			}
+			else if (matrix_solver_method==MM_SUPERLU)
 			{
 				/* De-allocate storage - superLU matrix types must be destroyed at every iteration, otherwise they balloon fast (65 MB norma becomes 1.5 GB) */
 	#ifdef MT
@@ -3988,6 +4527,10 @@ int64 solver_nr(unsigned int bus_count,
 				if (newiter == false)
 				{
 					gl_verbose("Power flow calculation converges at Iteration %d \n",Iteration+1);
+					if (chord_enabled)
+					{
+						gl_verbose("Chord method used %lld factorizations for %lld iterations",chord_factors,Iteration+1);
+					}
 				}
 				break;
 			}
@@ -4037,7 +4580,8 @@ int64 solver_nr(unsigned int bus_count,
 			double t = clock() - t_start;	
 			char buffer[64];
 			if ( gl_printtime(gl_globalclock,buffer,sizeof(buffer)-1) > 0 )
-				fprintf(nr_profile, "%s,%.1f,%.1lld,%d,%d,%s\n", buffer, t, Iteration == 0 ? 1 : Iteration,bus_count,branch_count,bad_computations ? "false" : "true");
+				fprintf(nr_profile, "%s,%.1f,%.1lld,%d,%d,%s,%lld\n", buffer, t, Iteration == 0 ? 1 : Iteration,bus_count,branch_count,bad_computations ? "false" : "true",
+					chord_enabled ? chord_factors : (Iteration == 0 ? 1 : Iteration));
 		}
 		return Iteration;
 	}
@@ -5289,3 +5833,128 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 		}//End Jacobian pass for deltamode loads
 	}//end bus traversion for Jacobian or current injection items
 }//End load update function
+
+//Load-change tolerance solve skipping - bus loads, bus flags, and swing voltages at the last full solution
+#define NR_LOAD_STRIDE 31
+static std::vector<complex> NR_load_snapshot;
+static std::vector<int> NR_flag_snapshot;
+static std::vector<complex> NR_swing_snapshot;
+static int64 NR_consecutive_skips = 0;
+
+//Collects the load components of a bus, scaled to VA using the bus voltage base
+static void solver_nr_bus_loads(BUSDATA *bus, complex *loads)
+{
+	double vb = bus->volt_base;
+	int index;
+
+	for (index=0; index<3; index++)
+	{
+		loads[index] = bus->S[index];
+		loads[3+index] = bus->I[index]*vb;
+		loads[6+index] = bus->Y[index]*(vb*vb);
+		loads[28+index] = ((bus->phases & 0x40) == 0x40) ? bus->house_var[index]*vb : complex(0.0,0.0);
+	}
+	for (index=0; index<6; index++)
+	{
+		loads[9+index] = bus->S_dy[index];
+		loads[15+index] = bus->I_dy[index]*vb;
+		loads[21+index] = bus->Y_dy[index]*(vb*vb);
+	}
+
+	//Triplex current12 - other uses of extra_var are not loads, and house_var is only set for house-attached nodes
+	loads[27] = ((bus->phases & 0x80) == 0x80) ? *bus->extra_var*vb : complex(0.0,0.0);
+}
+
+//Determines if the last full solution can be reused because the aggregate load change since then is
+//below NR_load_change_tolerance.  Topology changes (NR_admit_change), bus type or phase changes, swing voltage
+//changes, deltamode solutions, and NR_load_change_skip_limit consecutive reuses all force a full solution.
+bool solver_nr_reuse_solution(unsigned int bus_count, BUSDATA *bus, NRSOLVERMODE powerflow_type)
+{
+	complex loads[NR_LOAD_STRIDE];
+	double change = 0.0, base = 0.0, measure;
+	unsigned int indexer, swing_index = 0;
+	int index;
+
+	if ((NR_load_change_tolerance <= 0.0) || (powerflow_type != PF_NORMAL) || NR_admit_change
+		|| (NR_load_snapshot.size() != (size_t)bus_count*NR_LOAD_STRIDE)
+		|| (NR_consecutive_skips >= NR_load_change_skip_limit))
+	{
+		return false;
+	}
+
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		if ((NR_flag_snapshot[2*indexer] != bus[indexer].type) || (NR_flag_snapshot[2*indexer+1] != bus[indexer].phases))
+		{
+			return false;
+		}
+
+		//Swing voltages are sources, so any change beyond the tolerance needs a new solution
+		if ((bus[indexer].type == 2) || (bus[indexer].type == 3))
+		{
+			for (index=0; index<3; index++, swing_index++)
+			{
+				double vmag = NR_swing_snapshot[swing_index].Mag();
+				if ((bus[indexer].V[index] - NR_swing_snapshot[swing_index]).Mag() > NR_load_change_tolerance*(vmag > 0.0 ? vmag : 1.0))
+				{
+					return false;
+				}
+			}
+		}
+
+		solver_nr_bus_loads(&bus[indexer],loads);
+		complex *prev = &NR_load_snapshot[(size_t)indexer*NR_LOAD_STRIDE];
+		for (index=0; index<NR_LOAD_STRIDE; index++)
+		{
+			change += (loads[index] - prev[index]).Mag();
+			base += prev[index].Mag();
+		}
+	}
+
+	measure = (base > 0.0) ? change/base : (change > 0.0 ? 1.0 : 0.0);
+	if (!(measure < NR_load_change_tolerance))	//Also catches invalid load values
+	{
+		return false;
+	}
+
+	NR_consecutive_skips++;
+	NR_skip_count++;
+	if (measure > NR_skip_error_bound)
+	{
+		NR_skip_error_bound = measure;
+	}
+	return true;
+}
+
+//Records the loads of a full solution for later comparison - a failed solution is never reused
+void solver_nr_save_solution(unsigned int bus_count, BUSDATA *bus, bool converged)
+{
+	unsigned int indexer;
+	int index;
+
+	NR_solve_count++;
+	NR_consecutive_skips = 0;
+
+	if ((NR_load_change_tolerance <= 0.0) || !converged)
+	{
+		NR_load_snapshot.clear();
+		return;
+	}
+
+	NR_load_snapshot.resize((size_t)bus_count*NR_LOAD_STRIDE);
+	NR_flag_snapshot.resize(2*bus_count);
+	NR_swing_snapshot.clear();
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		NR_flag_snapshot[2*indexer] = bus[indexer].type;
+		NR_flag_snapshot[2*indexer+1] = bus[indexer].phases;
+		if ((bus[indexer].type == 2) || (bus[indexer].type == 3))
+		{
+			for (index=0; index<3; index++)
+			{
+				NR_swing_snapshot.push_back(bus[indexer].V[index]);
+			}
+		}
+		solver_nr_bus_loads(&bus[indexer],&NR_load_snapshot[(size_t)indexer*NR_LOAD_STRIDE]);
+	}
+}
@@ -142,9 +142,12 @@ typedef struct {
 //void ext_solver_alloc(void *ext_array, unsigned int rowcount, unsigned int colcount, bool admittance_change);
 //int ext_solver_solve(void *ext_array, NR_SOLVER_VARS *system_info_vars, unsigned int rowcount, unsigned int colcount);
 //void ext_solver_destroy(void *ext_array, bool new_iteration);
+//void ext_solver_blocks(void *ext_array, unsigned int count, unsigned int *block_size);	(optional)
 
 int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type , NR_MESHFAULT_IMPEDANCE *mesh_imped_vals, bool *bad_computations);
 void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values, bool jacobian_pass);
+bool solver_nr_reuse_solution(unsigned int bus_count, BUSDATA *bus, NRSOLVERMODE powerflow_type);
+void solver_nr_save_solution(unsigned int bus_count, BUSDATA *bus, bool converged);
 
 extern bool solver_dump_enable;
 
@@ -0,0 +1,410 @@
+/** Secondary network reduction
+	Residential feeders model each service drop as triplex lines and meters
+	below a split-phase center-tapped (SPCT) transformer.  These buses are
+	usually most of the Newton-Raphson system, although they are radial stubs.
+
+	When NR_secondary_reduction is enabled, every radial secondary below the
+	secondary bus of an SPCT transformer (the "root") is removed from the
+	system passed to solver_nr.  Its load is replaced by an equivalent constant
+	current at the root, which is refreshed from the latest voltages at each NR
+	iteration: a backward sweep accumulates the line currents of the secondary
+	buses, and a forward sweep updates their voltages from the root voltage
+	through the triplex line admittances.  A final sweep after the solve leaves
+	the secondary voltages consistent with the solution.
+
+	A secondary is only folded when it is a tree of PQ triplex buses connected
+	by triplex lines.  Any switch, fuse, transformer, loop, PV/swing bus or bus
+	with a dynamic current injection below the root keeps that branch of the
+	secondary in the solved system.  The reduction is only used for normal
+	(static) powerflow solutions, and is rebuilt whenever the admittance
+	matrix changes.
+ **/
+
+#include "gridlabd.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "powerflow.h"
+#include "solver_reduce.h"
+
+typedef struct s_reduce_bus {
+	int bus;				///< index of the folded bus
+	int parent;				///< index of the upstream bus
+	int branch;				///< index of the triplex line from the upstream bus
+	complex current[2];		///< line currents drawn by the bus and the buses below it
+} REDUCE_BUS;
+
+typedef struct s_reduce_root {
+	int bus;				///< index of the SPCT secondary bus
+	complex injection[3];	///< constant current load of the root, including the folded secondaries
+} REDUCE_ROOT;
+
+static struct s_reduce_system {
+	unsigned int bus_count;				///< size of the full system the reduction was built for
+	unsigned int branch_count;
+	BUSDATA *bus;						///< full system
+	BRANCHDATA *branch;
+	std::vector<REDUCE_BUS> folded;		///< folded buses, each after its upstream bus
+	std::vector<REDUCE_ROOT> roots;		///< buses the secondaries are folded into
+	std::vector<int> bus_map;			///< index of each bus in the reduced system (-1 if folded)
+	std::vector<int> branch_map;		///< index of each branch in the reduced system (-1 if folded)
+	std::vector<int> folded_of;			///< index of each bus in the folded list (-1 if not folded)
+	std::vector<int> root_of;			///< index of each bus in the root list (-1 if not a root)
+	std::vector<BUSDATA> rbus;			///< reduced system
+	std::vector<BRANCHDATA> rbranch;
+	std::vector<int> links;				///< link tables of the reduced system
+	std::vector<unsigned int> link_start;
+} reduce = {0,0,NULL,NULL};
+
+//Triplex lines are the only branches folded
+static bool reduce_is_line(BUSDATA *bus, BRANCHDATA *branch)
+{
+	return (branch->lnk_type == 1) && (branch->v_ratio == 1.0) && ((branch->phases & 0x80) == 0x80)
+		&& ((bus[branch->from].phases & 0x80) == 0x80) && ((bus[branch->to].phases & 0x80) == 0x80);
+}
+
+//Plain triplex PQ buses are the only buses folded
+static bool reduce_is_foldable(BUSDATA *bus)
+{
+	return ((bus->phases & 0x80) == 0x80) && ((bus->phases & 0x20) != 0x20) && (bus->type == 0)
+		&& (bus->ExtraCurrentInjFunc == NULL) && ((bus->dynamics_enabled == NULL) || (*bus->dynamics_enabled == false))
+		&& (bus->obj != NR_swing_bus);
+}
+
+//Adds the secondary below the line from the root to the folded list - returns false (and adds nothing) if it is not radial and plain
+static bool reduce_add_secondary(BUSDATA *bus, BRANCHDATA *branch, int root, int line)
+{
+	size_t first = reduce.folded.size();
+	REDUCE_BUS item;
+	size_t next;
+	unsigned int index;
+
+	item.bus = (branch[line].from == root) ? branch[line].to : branch[line].from;
+	item.parent = root;
+	item.branch = line;
+	reduce.folded.push_back(item);
+	for (next=first; next<reduce.folded.size(); next++)
+	{
+		REDUCE_BUS here = reduce.folded[next];
+		BUSDATA *node = &bus[here.bus];
+		if (!reduce_is_foldable(node) || (reduce.folded_of[here.bus] != -1) || (reduce.root_of[here.bus] != -1))
+		{
+			break;
+		}
+		reduce.folded_of[here.bus] = (int)next;
+
+		for (index=0; index<node->Link_Table_Size; index++)
+		{
+			int link = node->Link_Table[index];
+			if (link == here.branch)
+			{
+				continue;
+			}
+			if (!reduce_is_line(bus,&branch[link]))
+			{
+				break;
+			}
+			item.bus = (branch[link].from == here.bus) ? branch[link].to : branch[link].from;
+			item.parent = here.bus;
+			item.branch = link;
+			reduce.folded.push_back(item);
+		}
+		if (index < node->Link_Table_Size)
+		{
+			break;
+		}
+	}
+
+	//Keep the whole secondary when any part of it cannot be folded
+	if (next < reduce.folded.size())
+	{
+		for (next=first; next<reduce.folded.size(); next++)
+		{
+			if (reduce.folded_of[reduce.folded[next].bus] == (int)next)
+			{
+				reduce.folded_of[reduce.folded[next].bus] = -1;
+			}
+		}
+		reduce.folded.resize(first);
+		return false;
+	}
+	return true;
+}
+
+//Finds the foldable secondaries and builds the reduced bus and branch lists
+static void reduce_build(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch)
+{
+	unsigned int indexer, index;
+
+	reduce.bus_count = bus_count;
+	reduce.branch_count = branch_count;
+	reduce.bus = bus;
+	reduce.branch = branch;
+	reduce.folded.clear();
+	reduce.roots.clear();
+	reduce.folded_of.assign(bus_count,-1);
+	reduce.root_of.assign(bus_count,-1);
+
+	//Roots are the secondary buses of SPCT transformers
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		if (((bus[indexer].phases & 0xA0) == 0xA0) && (bus[indexer].type == 0))
+		{
+			REDUCE_ROOT root;
+			root.bus = indexer;
+			reduce.root_of[indexer] = (int)reduce.roots.size();
+			reduce.roots.push_back(root);
+		}
+	}
+
+	//Fold the secondaries below each root line by line
+	for (indexer=0; indexer<reduce.roots.size(); indexer++)
+	{
+		int root = reduce.roots[indexer].bus;
+		for (index=0; index<bus[root].Link_Table_Size; index++)
+		{
+			int line = bus[root].Link_Table[index];
+			if (reduce_is_line(bus,&branch[line]))
+			{
+				reduce_add_secondary(bus,branch,root,line);
+			}
+		}
+	}
+
+	//Map the remaining buses and branches
+	reduce.bus_map.assign(bus_count,-1);
+	reduce.branch_map.assign(branch_count,-1);
+	reduce.rbus.clear();
+	reduce.rbranch.clear();
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		if (reduce.folded_of[indexer] == -1)
+		{
+			reduce.bus_map[indexer] = (int)reduce.rbus.size();
+			reduce.rbus.push_back(bus[indexer]);
+		}
+	}
+	for (indexer=0; indexer<branch_count; indexer++)
+	{
+		if ((reduce.bus_map[branch[indexer].from] != -1) && (reduce.bus_map[branch[indexer].to] != -1))
+		{
+			reduce.branch_map[indexer] = (int)reduce.rbranch.size();
+			reduce.rbranch.push_back(branch[indexer]);
+		}
+	}
+
+	//Link tables of the reduced system only list the branches kept
+	reduce.links.clear();
+	reduce.link_start.assign(reduce.rbus.size()+1,0);
+	for (indexer=0; indexer<reduce.rbus.size(); indexer++)
+	{
+		BUSDATA *node = &reduce.rbus[indexer];
+		reduce.link_start[indexer] = reduce.links.size();
+		for (index=0; index<node->Link_Table_Size; index++)
+		{
+			if (reduce.branch_map[node->Link_Table[index]] != -1)
+			{
+				reduce.links.push_back(reduce.branch_map[node->Link_Table[index]]);
+			}
+		}
+	}
+	reduce.link_start[reduce.rbus.size()] = reduce.links.size();
+
+	std::vector<bool> used(reduce.roots.size(),false);
+	for (indexer=0; indexer<reduce.folded.size(); indexer++)
+	{
+		if (reduce.root_of[reduce.folded[indexer].parent] != -1)
+		{
+			used[reduce.root_of[reduce.folded[indexer].parent]] = true;
+		}
+	}
+	NR_reduced_bus_count = reduce.folded.size();
+	NR_reduced_root_count = std::count(used.begin(),used.end(),true);
+	gl_verbose("NR secondary reduction folded %lld of %u buses into %lld transformer buses", NR_reduced_bus_count, bus_count, NR_reduced_root_count);
+}
+
+//Copies the current state of the full system into the reduced system, keeping its own indexing
+static void reduce_refresh(void)
+{
+	size_t indexer;
+
+	for (indexer=0; indexer<reduce.bus_map.size(); indexer++)
+	{
+		int index = reduce.bus_map[indexer];
+		if (index != -1)
+		{
+			BUSDATA *node = &reduce.rbus[index];
+			unsigned int location = node->Matrix_Loc;	//Assigned by solver_nr for the reduced system
+			*node = reduce.bus[indexer];
+			node->Matrix_Loc = location;
+			node->Link_Table = reduce.links.data() + reduce.link_start[index];
+			node->Link_Table_Size = reduce.link_start[index+1] - reduce.link_start[index];
+			if (reduce.root_of[indexer] != -1)
+			{
+				node->I = reduce.roots[reduce.root_of[indexer]].injection;
+			}
+		}
+	}
+	for (indexer=0; indexer<reduce.branch_map.size(); indexer++)
+	{
+		int index = reduce.branch_map[indexer];
+		if (index != -1)
+		{
+			BRANCHDATA *link = &reduce.rbranch[index];
+			*link = reduce.branch[indexer];
+			link->from = reduce.bus_map[link->from];
+			link->to = reduce.bus_map[link->to];
+		}
+	}
+}
+
+//Line currents drawn by the loads of a triplex bus (same as compute_load_values)
+static void reduce_load_current(BUSDATA *bus, complex *line)
+{
+	complex v12 = bus->V[0] + bus->V[1];
+	complex current[3];
+	complex angle;
+	int index;
+
+	current[0] = bus->I[0];
+	current[1] = bus->I[1];
+	current[2] = *bus->extra_var;
+
+	current[0] += (bus->V[0] == 0.0) ? complex(0.0,0.0) : ~(bus->S[0]/bus->V[0]);
+	current[1] += (bus->V[1] == 0.0) ? complex(0.0,0.0) : ~(bus->S[1]/bus->V[1]);
+	current[2] += (v12 == 0.0) ? complex(0.0,0.0) : ~(bus->S[2]/v12);
+
+	current[0] += bus->Y[0]*bus->V[0];
+	current[1] += bus->Y[1]*bus->V[1];
+	current[2] += bus->Y[2]*v12;
+
+	if ((bus->phases & 0x40) == 0x40)	//House currents
+	{
+		for (index=0; index<3; index++)
+		{
+			angle.SetPolar(1.0,(index < 2 ? bus->V[index] : v12).Arg());
+			current[index] += bus->house_var[index]/(~angle);
+		}
+	}
+
+	line[0] = current[0] + current[2];
+	line[1] = -current[1] - current[2];
+}
+
+//Backward/forward sweep of the folded secondaries and update of the root injections
+static void reduce_sweep(void)
+{
+	BUSDATA *bus = reduce.bus;
+	BRANCHDATA *branch = reduce.branch;
+	size_t indexer;
+
+	//Backward - loads of each bus plus the lines below it (triplex lines have no shunt, so a line carries the current drawn at its far end)
+	for (indexer=0; indexer<reduce.folded.size(); indexer++)
+	{
+		reduce_load_current(&bus[reduce.folded[indexer].bus],reduce.folded[indexer].current);
+	}
+	for (indexer=reduce.folded.size(); indexer>0; indexer--)
+	{
+		REDUCE_BUS *item = &reduce.folded[indexer-1];
+		int parent = reduce.folded_of[item->parent];
+		if (parent != -1)
+		{
+			reduce.folded[parent].current[0] += item->current[0];
+			reduce.folded[parent].current[1] += item->current[1];
+		}
+	}
+
+	//Forward - each bus from its upstream voltage, V = YS^-1 (Y Vup - I)
+	for (indexer=0; indexer<reduce.folded.size(); indexer++)
+	{
+		REDUCE_BUS *item = &reduce.folded[indexer];
+		BRANCHDATA *link = &branch[item->branch];
+		complex *self = (link->from == item->bus) ? link->YSfrom : link->YSto;
+		complex *mutual = (link->from == item->bus) ? link->Yfrom : link->Yto;
+		complex *vup = bus[item->parent].V;
+		complex rhs[2], det;
+		int row;
+
+		for (row=0; row<2; row++)
+		{
+			rhs[row] = mutual[row*3]*vup[0] + mutual[row*3+1]*vup[1] - item->current[row];
+		}
+		det = self[0]*self[4] - self[1]*self[3];
+		if (det.Mag() == 0.0)	//Open line - leave the voltage alone
+		{
+			continue;
+		}
+		bus[item->bus].V[0] = (self[4]*rhs[0] - self[1]*rhs[1])/det;
+		bus[item->bus].V[1] = (self[0]*rhs[1] - self[3]*rhs[0])/det;
+	}
+
+	//Root injections - the root's own current loads plus the lines folded into it
+	for (indexer=0; indexer<reduce.roots.size(); indexer++)
+	{
+		REDUCE_ROOT *root = &reduce.roots[indexer];
+		root->injection[0] = bus[root->bus].I[0];
+		root->injection[1] = bus[root->bus].I[1];
+		root->injection[2] = bus[root->bus].I[2];
+	}
+	for (indexer=0; indexer<reduce.folded.size(); indexer++)
+	{
+		REDUCE_BUS *item = &reduce.folded[indexer];
+		int root = reduce.root_of[item->parent];
+		if (root != -1)
+		{
+			reduce.roots[root].injection[0] += item->current[0];
+			reduce.roots[root].injection[1] -= item->current[1];	//Line 2 current convention
+		}
+	}
+}
+
+void solver_reduce_update(BUSDATA *bus)
+{
+	if ((bus != NULL) && (reduce.rbus.size() > 0) && (bus == &reduce.rbus[0]))
+	{
+		reduce_sweep();
+	}
+}
+
+int64 solver_reduce_solve(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type, bool *bad_computations)
+{
+	int64 result;
+
+	if (!NR_secondary_reduction || (powerflow_type != PF_NORMAL))
+	{
+		return solver_nr(bus_count, bus, branch_count, branch, powerflow_values, powerflow_type, NULL, bad_computations);
+	}
+
+	if (NR_admit_change || (reduce.bus != bus) || (reduce.bus_count != bus_count) || (reduce.branch != branch) || (reduce.branch_count != branch_count))
+	{
+		reduce_build(bus_count,bus,branch_count,branch);
+		NR_admit_change = true;	//The reduced system needs a new admittance matrix
+	}
+	if (reduce.folded.size() == 0)
+	{
+		return solver_nr(bus_count, bus, branch_count, branch, powerflow_values, powerflow_type, NULL, bad_computations);
+	}
+
+	//The bus admittance storage is only allocated once, so make sure it fits the full system too
+	if (powerflow_values->BA_diag == NULL)
+	{
+		powerflow_values->BA_diag = (Bus_admit *)gl_malloc(bus_count*sizeof(Bus_admit));
+		if (powerflow_values->BA_diag == NULL)
+		{
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			/*  TROUBLESHOOT
+			During the allocation stage of the NR algorithm, one of the matrices failed to be allocated.
+			Please try again and if this bug persists, submit your code and a bug report using the trac
+			website.
+			*/
+		}
+	}
+
+	reduce_refresh();
+	result = solver_nr((unsigned int)reduce.rbus.size(), &reduce.rbus[0], (unsigned int)reduce.rbranch.size(), &reduce.rbranch[0], powerflow_values, powerflow_type, NULL, bad_computations);
+
+	//Reconstruct the secondary voltages from the final root voltages
+	reduce_sweep();
+	return result;
+}
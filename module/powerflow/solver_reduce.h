@@ -0,0 +1,29 @@
+// powerflow/solver_reduce.h
+// Copyright (C) 2026, Regents of the Leland Stanford Junior University
+
+#ifndef _SOLVER_REDUCE
+#define _SOLVER_REDUCE
+
+#include "solver_nr.h"
+
+//	Secondary network reduction for Newton-Raphson
+//
+//	When NR_secondary_reduction is enabled, each radial triplex secondary fed by
+//	a split-phase transformer is removed from the system solved by solver_nr and
+//	replaced by an equivalent current injection at the transformer's secondary
+//	bus.  The injection is refreshed from the latest voltages at every NR
+//	iteration by a backward/forward sweep of the secondary, and the secondary
+//	voltages are reconstructed by a final sweep after the solve, so meters and
+//	recorders downstream see the same values as an unreduced solution.
+
+//	Function: solver_reduce_solve
+//	Solve the powerflow, folding reducible secondaries when enabled.  Takes the
+//	same arguments and returns the same values as solver_nr.
+int64 solver_reduce_solve(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type, bool *bad_computations);
+
+//	Function: solver_reduce_update
+//	Refresh the equivalent injections from the latest voltages; called by
+//	solver_nr at each iteration and ignored unless bus is the reduced system
+void solver_reduce_update(BUSDATA *bus);
+
+#endif
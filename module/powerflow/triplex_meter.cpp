@@ -17,6 +17,13 @@ EXPORT int64 triplex_meter_reset(OBJECT *obj)
 	return 0;
 }
 
+// reliability flag observer registration function
+EXPORT int register_interruption_observer_triplex_meter(OBJECT *obj, OBJECT *observer, FUNCTIONADDR notify)
+{
+	triplex_meter *pMeter = OBJECTDATA(obj,triplex_meter);
+	return pMeter->add_interruption_observer(observer,notify);
+}
+
 char1024 market_price_name = "current_market.clearing_price";
 
 //////////////////////////////////////////////////////////////////////////
@@ -117,6 +124,10 @@ triplex_meter::triplex_meter(MODULE *mod) : triplex_node(mod)
 
 			NULL)<1) GL_THROW("unable to publish properties in %s",__FILE__);
 
+			//Reliability flag observer function
+			if (gl_publish_function(oclass,	"register_interruption_observer", (FUNCTIONADDR)register_interruption_observer_triplex_meter)==NULL)
+				GL_THROW("Unable to publish triplex_meter interruption observer function");
+
 			//Deltamode functions
 			if (gl_publish_function(oclass,	"delta_linkage_node", (FUNCTIONADDR)delta_linkage)==NULL)
 				GL_THROW("Unable to publish triplex_meter delta_linkage function");
@@ -177,6 +188,7 @@ int triplex_meter::create()
 
 	tpmeter_interrupted = false;	//Assumes we start as "uninterrupted"
 	tpmeter_interrupted_secondary = false;	//Assumes start with no momentary interruptions
+	interruption_observers = NULL;	//No one is watching the reliability flags yet
 
 
 	return result;
@@ -259,6 +271,9 @@ TIMESTAMP triplex_meter::presync(TIMESTAMP t0)
 		tpmeter_interrupted_secondary = false;
 	}
 
+	//Let anyone watching know
+	update_interruption_observers();
+
     // Capturing first timestamp of simulation for use in delta energy measurements.
     if (t0 != 0 && start_timestamp == 0)
     {
@@ -267,6 +282,19 @@ TIMESTAMP triplex_meter::presync(TIMESTAMP t0)
 
 	return triplex_node::presync(t0);
 }
+//Register an object to be notified when the reliability flags change
+//notify is called as int notify(OBJECT *observer, OBJECT *customer, int interrupted_change, int interrupted_secondary_change)
+int triplex_meter::add_interruption_observer(OBJECT *observer, FUNCTIONADDR notify)
+{
+	return interruption_observer_add(&interruption_observers,THISOBJECTHDR,observer,notify,tpmeter_interrupted,tpmeter_interrupted_secondary);
+}
+
+//Notify the observers of any reliability flag change since they were last notified
+void triplex_meter::update_interruption_observers(void)
+{
+	interruption_observer_update(interruption_observers,THISOBJECTHDR,tpmeter_interrupted,tpmeter_interrupted_secondary);
+}
+
 //Sync needed for reliability
 TIMESTAMP triplex_meter::sync(TIMESTAMP t0)
 {
@@ -333,6 +361,9 @@ TIMESTAMP triplex_meter::sync(TIMESTAMP t0)
 		}
 	}
 
+	//Let anyone watching know about any changes
+	update_interruption_observers();
+
 	if (tpmeter_power_consumption != complex(0,0))
 	{
 		power[0] += tpmeter_power_consumption/2;
@@ -729,6 +760,9 @@ SIMULATIONMODE triplex_meter::inter_deltaupdate_triplex_meter(unsigned int64 del
 				}
 			}
 
+			//Let anyone watching know about any changes
+			update_interruption_observers();
+
 			if (tpmeter_power_consumption != complex(0,0))
 			{
 				power[0] += tpmeter_power_consumption/2;
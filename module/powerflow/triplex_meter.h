@@ -37,6 +37,7 @@ public:
 	complex tpmeter_power_consumption; ///< power consumed by meter operation
 	bool tpmeter_interrupted;		///< Reliability flag - goes active if the customer is in an "interrupted" state
 	bool tpmeter_interrupted_secondary;	///< Reliability flag - goes active if the customer is in a "secondary interrupted" state - i.e., momentary
+	INTERRUPTION_OBSERVER *interruption_observers;	///< Objects notified when the reliability flags change
 	TIMESTAMP next_time;
 	TIMESTAMP dt;
 	TIMESTAMP last_t;
@@ -74,6 +75,8 @@ public:
 
 	double process_bill(TIMESTAMP t1);	///< function for processing current bill
 	int check_prices();				///< checks to make sure current prices are valid
+	int add_interruption_observer(OBJECT *observer, FUNCTIONADDR notify);	///< registers an object notified when the reliability flags change
+	void update_interruption_observers(void);	///< notifies the observers of reliability flag changes
 
 private:
 	double previous_energy_total;  ///< Used to track what the meter reading was the previous month
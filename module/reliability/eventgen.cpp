@@ -1368,15 +1368,6 @@ int eventgen::add_unhandled_event(OBJECT *obj_to_fault, const char *event_type,
 	return 1;	//Always successful here
 }
 
-//Retrieve the address of a double
-double *eventgen::get_double(OBJECT *obj, const char *name)
-{
-	PROPERTY *p = gl_get_property(obj,name);
-	if (p==NULL || p->ptype!=PT_double)
-		return NULL;
-	return (double*)GETADDR(obj,p);
-}
-
 //Function to update any event times after a successful state change
 void eventgen::regen_events(TIMESTAMP t1_ts, double t1_dbl){
 	OBJECT *hdr = THISOBJECTHDR;
@@ -20,6 +20,8 @@ bool metrics::report_event_log = true; /* dumps detailed event log by default */
 
 static PASSCONFIG clockpass = PC_POSTTOPDOWN;
 
+EXPORT int notify_metrics_interruption(OBJECT *obj, OBJECT *customer, int change, int change_secondary);
+
 /* Class registration is only called once to register the class with the core */
 metrics::metrics(MODULE *module)
 {
@@ -38,6 +40,8 @@ metrics::metrics(MODULE *module)
 			PT_char1024, "metrics_of_interest", PADDR(metrics_oi),
 			PT_double, "metric_interval[s]", PADDR(metric_interval_dbl),
 			PT_double, "report_interval[s]", PADDR(report_interval_dbl),
+			PT_double, "customer_minutes_interrupted[min]", PADDR(customer_minutes_interrupted), PT_OUTPUT,
+				PT_DESCRIPTION, "Customer-minutes of interruption accumulated from customers that report their flag changes",
 			NULL)<1) GL_THROW("unable to publish properties in %s",__FILE__);
 	}
 }
@@ -62,6 +66,14 @@ int metrics::create(void)
 	report_interval = 0;
 	CustomerCount = 0;
 	Customers = NULL;
+	PolledCount = 0;
+	PolledCustomers = NULL;
+	interrupted_count = 0;
+	interrupted_count_secondary = 0;
+	customer_seconds = 0.0;
+	customer_minutes_interrupted = 0.0;
+	last_count_change = TS_NEVER;
+	count_lock = 0;
 	curr_time = TS_NEVER;	//Flagging value
 	metric_interval_event_count = 0;
 	annual_interval_event_count = 0;
@@ -387,9 +399,10 @@ int metrics::init(OBJECT *parent)
 
 	//Make us an array!
 	Customers = (CUSTARRAY*)gl_malloc(CustomerCount*sizeof(CUSTARRAY));
+	PolledCustomers = (int*)gl_malloc(CustomerCount*sizeof(int));
 
 	//Make sure it worked
-	if (Customers == NULL)
+	if ((Customers == NULL) || (PolledCustomers == NULL))
 	{
 		GL_THROW("Failure to allocate customer list memory in metrics:%s",hdr->name);
 		/*  TROUBLESHOOT
@@ -482,6 +495,33 @@ int metrics::init(OBJECT *parent)
 		}
 		//Defaulted else - unwanted
 
+		//See if the customer can tell us when its flags change, so we don't have to poll it on every event
+		Customers[index].Observed = false;
+		funadd = (FUNCTIONADDR)(gl_get_function(temp_obj,"register_interruption_observer"));
+
+		if (funadd != NULL)
+		{
+			returnval = ((int (*)(OBJECT *, OBJECT *, FUNCTIONADDR))(*funadd))(temp_obj,hdr,(FUNCTIONADDR)notify_metrics_interruption);
+
+			if (returnval == 1)
+			{
+				Customers[index].Observed = true;
+
+				//Start from its current state
+				if (*Customers[index].CustInterrupted == true)
+					interrupted_count++;
+
+				if ((secondary_interruptions_count == true) && (*Customers[index].CustInterrupted_Secondary == true))
+					interrupted_count_secondary++;
+			}
+		}
+
+		//Otherwise, it gets polled
+		if (Customers[index].Observed == false)
+		{
+			PolledCustomers[PolledCount] = index;
+			PolledCount++;
+		}
 	}//end population loop
 
 	//Free up list
@@ -530,6 +570,12 @@ TIMESTAMP metrics::postsync(TIMESTAMP t0, TIMESTAMP t1)
 	OBJECT *hdr = THISOBJECTHDR;
 	FILE *FPVal;
 
+	//Update the customer-minutes from the notified counts
+	::rlock(&count_lock);
+	if (last_count_change != TS_NEVER)
+		customer_minutes_interrupted = (customer_seconds + (double)(interrupted_count) * (double)(t1 - last_count_change)) / 60.0;
+	::runlock(&count_lock);
+
 	//Initialization
 	if (curr_time == TS_NEVER)
 	{
@@ -805,18 +851,37 @@ void metrics::event_ended_sec(OBJECT *event_obj, OBJECT *fault_obj, OBJECT *faul
 	}
 }
 
+//Function to update the counts when a customer notifies us of a flag change
+void metrics::interruption_changed(int change, int change_secondary)
+{
+	TIMESTAMP t_now = gl_globalclock;
+
+	//Customers sync in parallel, so one at a time
+	::wlock(&count_lock);
+
+	//Accumulate the customer-time at the old count
+	if (last_count_change != TS_NEVER)
+		customer_seconds += (double)(interrupted_count) * (double)(t_now - last_count_change);
+	last_count_change = t_now;
+
+	interrupted_count += change;
+	interrupted_count_secondary += change_secondary;
+
+	::wunlock(&count_lock);
+}
+
 //Function to obtain number of customers experiencing outage condition
 int metrics::get_interrupted_count(void)
 {
 	int index, in_outage;
 
-	//Reset counter
-	in_outage = 0;
+	//Start from the customers that keep us up to date
+	in_outage = interrupted_count;
 
-	//Loop through the list and get the number of customer objects reported as interrupted
-	for (index=0; index<CustomerCount; index++)
+	//Loop through the customers that must be polled and get the number reported as interrupted
+	for (index=0; index<PolledCount; index++)
 	{
-		if (*Customers[index].CustInterrupted == true)
+		if (*Customers[PolledCustomers[index]].CustInterrupted == true)
 			in_outage++;
 	}
 
@@ -829,18 +894,18 @@ void metrics::get_interrupted_count_secondary(int *in_outage, int *in_outage_sec
 {
 	int index, in_outage_temp, in_outage_temp_sec;
 
-	//Reset counter
-	in_outage_temp = 0;
-	in_outage_temp_sec = 0;
+	//Start from the customers that keep us up to date
+	in_outage_temp = interrupted_count;
+	in_outage_temp_sec = interrupted_count_secondary;
 
-	//Loop through the list and get the number of customer objects reported as interrupted
-	for (index=0; index<CustomerCount; index++)
+	//Loop through the customers that must be polled and get the number reported as interrupted
+	for (index=0; index<PolledCount; index++)
 	{
-		if (*Customers[index].CustInterrupted == true)
+		if (*Customers[PolledCustomers[index]].CustInterrupted == true)
 			in_outage_temp++;
 
 		//Assumes secondary metric exists, otherwise we shouldn't be here
-		if (*Customers[index].CustInterrupted_Secondary == true)
+		if (*Customers[PolledCustomers[index]].CustInterrupted_Secondary == true)
 			in_outage_temp_sec++;
 	}
 
@@ -982,3 +1047,11 @@ EXPORT TIMESTAMP sync_metrics(OBJECT *obj, TIMESTAMP t1, PASSCONFIG pass)
 	}
 	SYNC_CATCHALL(metrics);
 }
+
+//Exported function for customers to notify us of changes in their interruption flags
+EXPORT int notify_metrics_interruption(OBJECT *obj, OBJECT *customer, int change, int change_secondary)
+{
+	metrics *my = OBJECTDATA(obj,metrics);
+	my->interruption_changed(change,change_secondary);
+	return 1;
+}
@@ -23,6 +23,7 @@ typedef struct s_custarray {
 	OBJECT *CustomerObj;	//Object pointer to the customer
 	bool *CustInterrupted;	//Pointer to customer "interrupted" flag
 	bool *CustInterrupted_Secondary;	//Pointer to secondary customer "interrupted" flag - may or may not be used
+	bool Observed;			//Customer notifies us of flag changes, so it is never polled
 } CUSTARRAY;
 
 class metrics : public gld_object {
@@ -41,6 +42,13 @@ private:
 	bool metric_equal_annual;			//Flag to see if annual and "metric interval" are the same length
 	int CustomerCount;		//Number of candidate objects (customers) found
 	CUSTARRAY *Customers;	//Array of candidate objects (customers)
+	int PolledCount;		//Number of customers that do not notify us of flag changes
+	int *PolledCustomers;	//Index of customers that must be polled for their flags
+	int interrupted_count;	//Number of interrupted customers that notify us
+	int interrupted_count_secondary;	//Number of secondary interrupted customers that notify us
+	double customer_seconds;	//Customer-seconds of interruption up to last_count_change
+	TIMESTAMP last_count_change;	//Time of the last change in interrupted_count
+	LOCKVAR count_lock;		//Lock for the notified counts
 	FUNCTIONADDR reset_interval_func;	//Pointer to metric "interval" reset
 	FUNCTIONADDR reset_annual_func;		//Pointer to metric annual reset
 	FUNCTIONADDR compute_metrics;		//Pointer to metric computation function
@@ -65,9 +73,11 @@ public:
 	char1024 metrics_oi;
 	double metric_interval_dbl;
 	double report_interval_dbl;
+	double customer_minutes_interrupted;	//Customer-minutes of interruption of customers that notify us
 	void *Extra_Data;		//Pointer to extra data array - if needed
 	void event_ended(OBJECT *event_obj,OBJECT *fault_obj,OBJECT *faulting_obj,TIMESTAMP event_start_time,TIMESTAMP event_end_time,const char *fault_type,const char *impl_fault,int number_customers_int);
 	void event_ended_sec(OBJECT *event_obj,OBJECT *fault_obj,OBJECT *faulting_obj,TIMESTAMP event_start_time,TIMESTAMP event_end_time,const char *fault_type,const char *impl_fault,int number_customers_int, int number_customers_int_secondary);
+	void interruption_changed(int change, int change_secondary);
 	int get_interrupted_count(void);
 	void get_interrupted_count_secondary(int *in_outage, int *in_outage_secondary);
 	void write_metrics(void);
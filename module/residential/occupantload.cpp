@@ -219,4 +219,23 @@ EXPORT TIMESTAMP sync_occupantload(OBJECT *obj, TIMESTAMP t0)
 	SYNC_CATCHALL(occupantload);
 }
 
+EXPORT unsigned int syncbatch_occupantload(OBJECT **objs, unsigned int n, TIMESTAMP t0, PASSCONFIG pass, TIMESTAMP *t1)
+{
+	OBJECT *obj = NULL;
+	unsigned int k;
+	for ( k = 0 ; k < n ; k++ )
+	{
+		obj = objs[k];
+		try
+		{
+			gld_wlock lock(obj);
+			occupantload *my = OBJECTDATA(obj, occupantload);
+			t1[k] = my->sync(obj->clock, t0);
+			obj->clock = t0;
+		}
+		SYNCBATCH_CATCHALL(occupantload);
+	}
+	return n;
+}
+
 /**@}**/
@@ -646,4 +646,23 @@ EXPORT TIMESTAMP sync_ZIPload(OBJECT *obj, TIMESTAMP t0)
 	SYNC_CATCHALL(ZIPload);
 }
 
+EXPORT unsigned int syncbatch_ZIPload(OBJECT **objs, unsigned int n, TIMESTAMP t0, PASSCONFIG pass, TIMESTAMP *t1)
+{
+	OBJECT *obj = NULL;
+	unsigned int k;
+	for ( k = 0 ; k < n ; k++ )
+	{
+		obj = objs[k];
+		try
+		{
+			gld_wlock lock(obj);
+			ZIPload *my = OBJECTDATA(obj, ZIPload);
+			t1[k] = my->sync(obj->clock, t0);
+			obj->clock = t0;
+		}
+		SYNCBATCH_CATCHALL(ZIPload);
+	}
+	return n;
+}
+
 /**@}**/
@@ -0,0 +1,16 @@
+# batch billing function used by test_billing_batch.glm
+import csv
+
+RATE = 0.25 # $/kWh
+
+csvfile = open("billing_batch.csv","w")
+csvwriter = csv.writer(csvfile)
+csvwriter.writerow(["bill_date","billing_days","name","meter","tariff","energy","demand","charges"])
+
+def compute_bills(gridlabd,**kwargs):
+	charges = []
+	for name, meter, tariff, energy, demand in zip(kwargs["name"],kwargs["meter"],kwargs["tariff"],kwargs["energy"],kwargs["demand"]):
+		charges.append(round(energy*RATE,2))
+		csvwriter.writerow([kwargs["bill_date"],round(kwargs["billing_days"]),name,meter,tariff,round(energy,3),round(demand,3),charges[-1]])
+	csvfile.flush()
+	return charges
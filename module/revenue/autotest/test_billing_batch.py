@@ -0,0 +1,36 @@
+# check the output of test_billing_batch.glm
+import csv, json, sys
+from datetime import datetime
+from zoneinfo import ZoneInfo
+
+tz = ZoneInfo("America/Los_Angeles")
+expected = {
+	"bill1" : ["2020-01-15","2020-02-15","2020-03-15"],
+	"bill5" : ["2020-01-31","2020-02-29","2020-03-31"],
+	}
+
+bills = {}
+batches = {}
+with open("billing_batch.csv") as fh:
+	for row in csv.DictReader(fh):
+		date = datetime.fromtimestamp(int(row["bill_date"]),tz)
+		assert date.hour == 0 and date.minute == 0, f"bill {row['name']} not generated at midnight"
+		bills.setdefault(row["name"],[]).append((date.strftime("%Y-%m-%d"),float(row["energy"]),float(row["demand"]),float(row["charges"])))
+		batches.setdefault(row["bill_date"],set()).add(row["name"])
+
+for name, dates in expected.items():
+	found = [x[0] for x in bills[name]]
+	assert found == dates, f"{name} bill dates {found} do not match expected {dates}"
+	assert bills[name][0][1] > 0 and bills[name][0][2] > 0, f"{name} energy or demand not metered"
+
+# one batch per billing cycle and group
+assert len(batches) == 6, f"{len(batches)} batches found"
+for date, names in batches.items():
+	assert names in [{"bill1","bill2","bill3","bill4"},{"bill5","bill6"}], f"batch {date} has customers {names}"
+
+# charges returned are applied to the billing objects
+with open("test_billing_batch.json") as fh:
+	model = json.load(fh)
+for name, data in bills.items():
+	total = float(model["objects"][name]["total_bill"].split()[0])
+	assert abs(total-sum([x[3] for x in data])) < 0.01, f"{name} total_bill {total} does not match charges"
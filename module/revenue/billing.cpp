@@ -9,6 +9,7 @@ EXPORT_COMMIT(billing);
 
 CLASS *billing::oclass = NULL;
 billing *billing::defaults = NULL;
+BILLINGGROUP *billing::group_list = NULL;
 
 #define CLASSOPTIONS PC_AUTOLOCK
 
@@ -95,6 +96,10 @@ int billing::create(void)
 		return 0;
 	}
 	python_data = PyDict_New();
+	group = NULL;
+	group_index = 0;
+	meter_energy = NULL;
+	meter_power = NULL;
 	return 1; /* return 1 on success, 0 on failure */
 }
 
@@ -115,16 +120,71 @@ int billing::init(OBJECT *parent)
 		metering_interval = 86400;
 	}
 
-	// need to call billing code once to initialize it
-	compute_bill();
+	// join the group of bills generated on the same day
+	group = get_group(bill_day);
+	if ( group == NULL )
+	{
+		exception("unable to create billing group for bill_day %d",bill_day);
+	}
+	group_index = group->customer.size();
+	group->customer.push_back(this);
+	group->start_energy.push_back(0.0);
+	group->energy.push_back(0.0);
+	group->demand.push_back(0.0);
+
+	if ( billing_batch_function[0] != '\0' )
+	{
+		// bills are computed by the batch billing function from the metered data
+		gld_property energy(get_meter(),"measured_real_energy");
+		gld_property power(get_meter(),"measured_real_power");
+		if ( ! energy.is_valid() || ! power.is_valid() )
+		{
+			exception("meter does not publish measured_real_energy and measured_real_power");
+		}
+		meter_energy = (double*)energy.get_addr();
+		meter_power = (double*)power.get_addr();
+	}
+	else
+	{
+		// need to call billing code once to initialize it
+		compute_bill();
+	}
 
 	return 1; /* return 2 on deferral, 1 on success, 0 on failure */
 }
 
 TIMESTAMP billing::commit(TIMESTAMP t0, TIMESTAMP t1)
 {
-	gld_clock dt0(t0);
-	if ( is_billing_time(dt0) )
+	// accumulate metered data
+	if ( meter_energy != NULL )
+	{
+		group->energy[group_index] = *meter_energy/1000;
+		if ( *meter_power/1000 > group->demand[group_index] )
+		{
+			group->demand[group_index] = *meter_power/1000;
+		}
+	}
+
+	// check the group's bill date
+	::wlock(&group->lock);
+	if ( t0 > group->next_bill )
+	{
+		if ( group->ready > 0 ) 
+		{
+			// some customers were not metered on the last bill date
+			compute_group_bills(group,group->next_bill);
+		}
+		group->next_bill = next_billing_time(bill_day,t0);
+	}
+	bool is_billing_time = ( t0 == group->next_bill );
+	if ( is_billing_time && meter_energy != NULL && ++group->ready == group->customer.size() )
+	{
+		// last customer of the group metered on the bill date
+		compute_group_bills(group,t0);
+	}
+	::wunlock(&group->lock);
+
+	if ( is_billing_time && meter_energy == NULL )
 	{
 		compute_bill();
 		bill_date = gl_globalclock;
@@ -132,19 +192,154 @@ TIMESTAMP billing::commit(TIMESTAMP t0, TIMESTAMP t1)
 	return (TIMESTAMP)(ceil(t0/metering_interval)*metering_interval);
 }
 
-bool billing::is_billing_time(gld_clock &dt0)
+TIMESTAMP billing::next_billing_time(int32 bill_day, TIMESTAMP t0)
 {
+	gld_clock dt0(t0);
 	int year = dt0.get_year();
-	bool is_leapyear = false;
-	if ( year % 4 == 0 ) is_leapyear = true;
-	if ( year % 100 == 0 ) is_leapyear = false;
-	if ( year % 400 == 0 ) is_leapyear = true;
-	int days_in_month[12] = {31,is_leapyear?29:28,31,30,31,30,31,31,30,31,30,31};
-	int effective_bill_day = bill_day;
-	int month = dt0.get_month()-1;
-	if ( bill_day > days_in_month[month] )
-		effective_bill_day = days_in_month[month];
-	return ( effective_bill_day == dt0.get_day() && dt0.get_hour() == 0 && dt0.get_minute() == 0 && dt0.get_second() == 0 );
+	int month = dt0.get_month();
+	for ( int n = 0 ; n < 13 ; n++ )
+	{
+		bool is_leapyear = false;
+		if ( year % 4 == 0 ) is_leapyear = true;
+		if ( year % 100 == 0 ) is_leapyear = false;
+		if ( year % 400 == 0 ) is_leapyear = true;
+		int days_in_month[12] = {31,is_leapyear?29:28,31,30,31,30,31,31,30,31,30,31};
+		int days = days_in_month[month-1];
+		int effective_bill_day = bill_day;
+		if ( bill_day > days )
+			effective_bill_day = days;
+		else if ( bill_day < 0 )
+			effective_bill_day = ( -bill_day > days ? 1 : days+1+bill_day );
+
+		// midnight local time on the bill day
+		DATETIME dt;
+		memset(&dt,0,sizeof(dt));
+		dt.year = year;
+		dt.month = month;
+		dt.day = effective_bill_day;
+		TIMESTAMP ts = callback->time.mkdatetime(&dt);
+		if ( ts >= t0 )
+		{
+			return ts;
+		}
+		if ( ++month > 12 )
+		{
+			month = 1;
+			year++;
+		}
+	}
+	return TS_NEVER;
+}
+
+BILLINGGROUP *billing::get_group(int32 bill_day)
+{
+	BILLINGGROUP *group;
+	for ( group = group_list ; group != NULL ; group = group->next )
+	{
+		if ( group->bill_day == bill_day )
+		{
+			return group;
+		}
+	}
+	group = new BILLINGGROUP;
+	if ( group == NULL )
+	{
+		return NULL;
+	}
+	group->bill_day = bill_day;
+	group->next_bill = TS_ZERO;
+	group->last_bill = gl_globalclock;
+	group->ready = 0;
+	group->lock = 0;
+	group->python_data = PyDict_New();
+	group->next = group_list;
+	group_list = group;
+	return group;
+}
+
+void billing::compute_group_bills(BILLINGGROUP *group, TIMESTAMP t0)
+{
+	size_t n, size = group->customer.size();
+	double days = (t0 - group->last_bill)/86400.0;
+
+	// columnar data for all the customers in the group
+	PyObject *name = PyList_New(size);
+	PyObject *meter = PyList_New(size);
+	PyObject *tariff = PyList_New(size);
+	PyObject *baseline = PyList_New(size);
+	PyObject *energy = PyList_New(size);
+	PyObject *demand = PyList_New(size);
+	for ( n = 0 ; n < size ; n++ )
+	{
+		billing *bill = group->customer[n];
+		PyList_SET_ITEM(name,n,PyUnicode_FromString(bill->get_name()));
+		PyList_SET_ITEM(meter,n,PyUnicode_FromString(get_object(bill->get_meter())->get_name()));
+		PyList_SET_ITEM(tariff,n,PyUnicode_FromString(get_object(bill->get_tariff())->get_name()));
+		PyList_SET_ITEM(baseline,n,PyFloat_FromDouble(bill->get_baseline_demand()));
+		PyList_SET_ITEM(energy,n,PyFloat_FromDouble(group->energy[n]-group->start_energy[n]));
+		PyList_SET_ITEM(demand,n,PyFloat_FromDouble(group->demand[n]));
+		group->start_energy[n] = group->energy[n];
+		group->demand[n] = 0.0;
+	}
+
+	// one call for the whole billing cycle
+	billing *first = group->customer[0];
+	PyObject *charges = NULL;
+	if ( ! python_call(first->python_module,&charges,billing_batch_function,"{sLsdsOsOsOsOsOsOsO}",
+			"bill_date",(long long)t0,
+			"billing_days",days,
+			"name",name,
+			"meter",meter,
+			"tariff",tariff,
+			"baseline_demand",baseline,
+			"energy",energy,
+			"demand",demand,
+			"data",group->python_data) )
+	{
+		first->error("call to %s.%s() failed", (const char*)billing_module, (const char*)billing_batch_function);
+	}
+	else
+	{
+		// apply the charges returned, if any
+		if ( charges != NULL && PySequence_Check(charges) && (size_t)PySequence_Size(charges) == size )
+		{
+			for ( n = 0 ; n < size ; n++ )
+			{
+				PyObject *item = PySequence_GetItem(charges,n);
+				group->customer[n]->apply_bill(t0,days,PyFloat_AsDouble(item));
+				Py_XDECREF(item);
+			}
+		}
+		else if ( charges != NULL && charges != Py_None )
+		{
+			first->error("%s.%s() did not return one charge per customer", (const char*)billing_module, (const char*)billing_batch_function);
+		}
+		else
+		{
+			for ( n = 0 ; n < size ; n++ )
+			{
+				group->customer[n]->bill_date = t0;
+			}
+		}
+	}
+	Py_XDECREF(charges);
+	Py_DECREF(name);
+	Py_DECREF(meter);
+	Py_DECREF(tariff);
+	Py_DECREF(baseline);
+	Py_DECREF(energy);
+	Py_DECREF(demand);
+	group->last_bill = t0;
+	group->ready = 0;
+}
+
+void billing::apply_bill(TIMESTAMP t0, double days, double charges)
+{
+	bill_date = t0;
+	billing_days = (int32)days;
+	energy_charges += charges;
+	total_charges += charges;
+	total_bill += charges;
 }
 
 void billing::compute_bill(void)
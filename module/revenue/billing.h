@@ -5,8 +5,33 @@
 
 #define _BILLING_H
 
+#include <vector>
+
 #include "revenue.h"
 
+class billing;
+
+// Struct: BILLINGGROUP
+// Billing objects that share a bill day
+//
+// The bill dates of a group are computed once per billing cycle, and the
+// meter data of its customers are kept in contiguous arrays so that all the
+// bills of a cycle can be computed with a single call to the batch billing
+// function (see revenue::billing_batch_function).
+typedef struct s_billinggroup {
+	int32 bill_day; // day of month bills are generated
+	TIMESTAMP next_bill; // next billing time
+	TIMESTAMP last_bill; // last billing time
+	std::vector<billing*> customer; // billing objects in the group
+	std::vector<double> start_energy; // meter reading at last bill (kWh)
+	std::vector<double> energy; // latest meter reading (kWh)
+	std::vector<double> demand; // peak demand since last bill (kW)
+	size_t ready; // number of customers metered at next_bill
+	LOCKVAR lock; // group lock
+	PyObject *python_data; // data kept by the batch billing function
+	struct s_billinggroup *next;
+} BILLINGGROUP;
+
 class billing : public gld_object 
 {
 
@@ -15,6 +40,10 @@ private:
 	// TODO: add private data
 	PyObject *python_module;
 	PyObject *python_data;
+	BILLINGGROUP *group;
+	size_t group_index;
+	double *meter_energy;
+	double *meter_power;
 
 public:
 
@@ -41,8 +70,11 @@ public:
 private:
 
 	// TODO: add private methods
-	bool is_billing_time(gld_clock &dt);
 	void compute_bill(void);
+	void apply_bill(TIMESTAMP t0, double days, double charges);
+	static TIMESTAMP next_billing_time(int32 bill_day, TIMESTAMP t0);
+	static BILLINGGROUP *get_group(int32 bill_day);
+	static void compute_group_bills(BILLINGGROUP *group, TIMESTAMP t0);
 
 public:
 	
@@ -60,6 +92,7 @@ public:
 
 	static CLASS *oclass;
 	static billing *defaults;
+	static BILLINGGROUP *group_list;
 };
 
 #endif // _BILLING_H
\ No newline at end of file
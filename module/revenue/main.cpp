@@ -27,6 +27,7 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 	gl_global_create("revenue::billing_module",PT_char1024,&billing_module,NULL);
 	gl_global_create("revenue::billing_library",PT_char1024,&billing_library,NULL);
 	gl_global_create("revenue::billing_function",PT_char1024,&billing_function,NULL);
+	gl_global_create("revenue::billing_batch_function",PT_char1024,&billing_batch_function,NULL);
 	// TODO: register module globals here
 
 	// always return the first class registered */
@@ -18,6 +18,7 @@
 GLOBAL char1024 billing_library INIT("/usr/local/opt/gridlabd/current/share");
 GLOBAL char1024 billing_module INIT("default_billing.py");
 GLOBAL char1024 billing_function INIT("compute_bill");
+GLOBAL char1024 billing_batch_function INIT("");
 // GLOBAL double lowincome_discount INIT(0);
 // GLOBAL double program_credit INIT(0);
 // GLOBAL char1024 program_credit_months;
@@ -0,0 +1,21 @@
+import os, math, struct, sys
+
+with open("test_recorder_plot.plt") as fh:
+	script = fh.read()
+if "'test_recorder_plot.bin' binary format=\"%float64%float64%float64%float64\" using 1:3" not in script:
+	print("test_recorder_plot.plt does not plot the binary data file",file=sys.stderr)
+	exit(1)
+
+with open("test_recorder_plot.bin","rb") as fh:
+	data = fh.read()
+if len(data) == 0 or len(data) % 32 != 0:
+	print(f"test_recorder_plot.bin has an invalid size {len(data)}",file=sys.stderr)
+	exit(1)
+for n in range(0,len(data),32):
+	t,x,y,z = struct.unpack("dddd",data[n:n+32])
+	if x != 1.5 or y != -2.5 or not math.isnan(z):
+		print(f"test_recorder_plot.bin record {n//32} has incorrect values {x},{y},{z}",file=sys.stderr)
+		exit(1)
+	if t != 946684800+(n//32)*60:
+		print(f"test_recorder_plot.bin record {n//32} has incorrect time {t}",file=sys.stderr)
+		exit(1)
@@ -5,6 +5,13 @@ CLASS *group_recorder::oclass = NULL;
 CLASS *group_recorder::pclass = NULL;
 group_recorder *group_recorder::defaults = NULL;
 
+// memory account of the line buffers
+static HEAPACCOUNT *line_account(void)
+{
+	static HEAPACCOUNT *account = gl_heap_account("tape","group line buffers");
+	return account;
+}
+
 void new_group_recorder(MODULE *mod)
 {
 	new group_recorder(mod);
@@ -340,8 +347,11 @@ int group_recorder::commit(TIMESTAMP t1, double t1dbl, bool deltacall){
 		write_footer();
 		fclose(rec_file);
 		rec_file = 0;
+		gl_heap_remove(line_account(), prev_line_buffer ? 2*line_size : line_size);
 		free(line_buffer);
 		line_buffer = 0;
+		free(prev_line_buffer);
+		prev_line_buffer = 0;
 		line_size = 0;
 		tape_status = TS_DONE;
 	}
@@ -465,6 +475,7 @@ int group_recorder::read_line()
 			}
 			memset((void*)prev_line_buffer, 0, line_size);
 		}
+		gl_heap_add(line_account(), prev_line_buffer ? 2*line_size : line_size);
 	}
 
 	// if we need the previous buffer to compare against, swap the buffers
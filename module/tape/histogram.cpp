@@ -70,6 +70,9 @@ histogram::histogram(MODULE *mod)
 		group_list = NULL;
 		binctr = NULL;
 		prop_ptr = NULL;
+		sample_obj = NULL;
+		sample_prop = NULL;
+		sample_count = 0;
 		next_count = t_count = next_sample = t_sample = TS_ZERO;
 		strcpy(mode, "file");
 		flags[0]='w';
@@ -82,6 +85,15 @@ int histogram::create()
 	return 1;
 }
 
+void histogram::destroy(void)
+{
+	free(sample_obj);
+	sample_obj = NULL;
+	delete [] sample_prop;
+	sample_prop = NULL;
+	sample_count = 0;
+}
+
 
 /* consume spaces */
 void eat_white(char **pos){
@@ -245,6 +257,8 @@ int histogram::init(OBJECT *parent)
 		/* parse complex part of property */
 		test_for_complex(tprop, tpart);
 	
+		sample_obj = (OBJECT**)malloc(sizeof(OBJECT*)*group_list->hit_count);
+		sample_prop = new gld_binding[group_list->hit_count];
 		while( (group_obj=gl_find_next(group_list, group_obj)) )
 		{
 			prop = gl_find_property(group_obj->oclass, property.get_string());
@@ -252,15 +266,16 @@ int histogram::init(OBJECT *parent)
 				gl_error("Histogram group is unable to find prop '%s' in class '%s' for group '%s'", property.get_string(), group_obj->oclass->name, group.get_string());
 				return 0;
 			}
-			/* check to see if all the group objects are in the same class, allowing us to cache the target property */
+			/* bind the property of each group object so sampling does not look it up again */
+			if ( ! sample_prop[sample_count].bind(group_obj->oclass, property.get_string()) )
+			{
+				return 0;
+			}
+			sample_obj[sample_count++] = group_obj;
 			if (oclass == NULL){
 				oclass = group_obj->oclass;
 				prop_ptr = prop;
 			}
-			if(oclass != group_obj->oclass){
-				prop_ptr = NULL;
-			} 
-			
 		}
 	} else { /* if we have a parent, we only focus on that one object */
 
@@ -274,6 +289,13 @@ int histogram::init(OBJECT *parent)
 		} else {
 			prop_ptr = prop; /* saved for later */
 		}
+		sample_obj = (OBJECT**)malloc(sizeof(OBJECT*));
+		sample_prop = new gld_binding[1];
+		if ( ! sample_prop[0].bind(parent->oclass, property.get_string()) )
+		{
+			return 0;
+		}
+		sample_obj[sample_count++] = parent;
 	}
 
 	// initialize first timesteps
@@ -386,16 +408,17 @@ int histogram::init(OBJECT *parent)
 	return ops->open(this, fname, flags);
 }
 
-int histogram::feed_bins(OBJECT *obj)
+int histogram::feed_bins(OBJECT *obj, const gld_binding &binding)
 {
+	void *addr = binding.get_addr(obj);
 	double value = 0.0;
 	complex cval = 0.0; //gl_get_complex(obj, ;
 	int64 ival = 0;
 	int i = 0;
 
-	switch(prop_ptr->ptype){
+	switch(binding.get_type()){
 		case PT_complex:
-			cval = (prop_ptr ? *gl_get_complex(obj, prop_ptr) : *gl_get_complex_by_name(obj, property) );
+			cval = *(complex*)addr;
 			switch(this->comp_part){
 				case REAL:
 					value = cval.Re();
@@ -416,7 +439,7 @@ int histogram::feed_bins(OBJECT *obj)
 			/* fall through */
 		case PT_double:
 			if(ival == 0) 
-				value = (prop_ptr ? *gl_get_double(obj, prop_ptr) : *gl_get_double_by_name(obj, property.get_string()) );
+				value = *(double*)addr;
 			for(i = 0; i < bin_count; ++i){
 				if(value > bin_list[i].low_val && value < bin_list[i].high_val){
 					++binctr[i];
@@ -428,26 +451,26 @@ int histogram::feed_bins(OBJECT *obj)
 			}
 			break;
 		case PT_int16:
-			ival = (prop_ptr ? *gl_get_int16(obj, prop_ptr) : *gl_get_int16_by_name(obj, property.get_string()) );
+			ival = *(int16*)addr;
 			value = 1.0;
 		case PT_int32:
 			if(value == 0.0){
-				ival = (prop_ptr ? *gl_get_int32(obj, prop_ptr) : *gl_get_int32_by_name(obj, property.get_string()) );
+				ival = *(int32*)addr;
 				value = 1.0;
 			}
 		case PT_int64:
 			if(value == 0.0){
-				ival = (prop_ptr ? *gl_get_int64(obj, prop_ptr) : *gl_get_int64_by_name(obj, property.get_string()) );
+				ival = *(int64*)addr;
 				value = 1.0;
 			}
 		case PT_enumeration:
 			if(value == 0.0){
-				ival = (prop_ptr ? *gl_get_enum(obj, prop_ptr) : *gl_get_enum_by_name(obj, property.get_string()) );
+				ival = *(enumeration*)addr;
 				value = 1.0;
 			}
 		case PT_set:
 			if(value == 0.0){
-				ival = (prop_ptr ? *gl_get_set(obj, prop_ptr) : *gl_get_set_by_name(obj, property.get_string()) );
+				ival = *(set*)addr;
 				value = 1.0;
 			}
 			
@@ -477,13 +500,9 @@ TIMESTAMP histogram::sync(TIMESTAMP t0, TIMESTAMP t1)
 		sampling_interval == 0.0 ||
 		(sampling_interval > 0.0 && t1 >= next_sample))
 	{
-		if(group_list == NULL){
-			feed_bins(obj->parent);
-		} else {
-			OBJECT *obj = gl_find_next(group_list, NULL);
-			for(; obj != NULL; obj = gl_find_next(group_list, obj)){
-				feed_bins(obj);
-			}
+		for ( int n = 0 ; n < sample_count ; n++ )
+		{
+			feed_bins(sample_obj[n],sample_prop[n]);
 		}
 		t_sample = t1;
 		if(sampling_interval > 0.0001){
@@ -574,6 +593,11 @@ EXPORT int create_histogram(OBJECT **obj, OBJECT *parent)
 	return 0;
 }
 
+EXPORT void destroy_histogram(OBJECT *obj)
+{
+	OBJECTDATA(obj,histogram)->destroy();
+}
+
 EXPORT int init_histogram(OBJECT *obj)
 {
 	histogram *my = OBJECTDATA(obj,histogram);
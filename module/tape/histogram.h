@@ -25,6 +25,9 @@ protected:
 	int *binctr;
 	CPLPT comp_part;
 	PROPERTY *prop_ptr;
+	OBJECT **sample_obj; /* objects sampled */
+	gld_binding *sample_prop; /* property of each object sampled */
+	int sample_count;
 	TAPEOPS *ops;
 
 public:
@@ -62,12 +65,13 @@ public:
 public:
 	histogram(MODULE *mod);
 	int create(void);
+	void destroy(void);
 	int init(OBJECT *parent);
 	TIMESTAMP sync(TIMESTAMP t0, TIMESTAMP t1);
 	int isa(char *classname);
 protected:
 	void test_for_complex(char *, char *);
-	int feed_bins(OBJECT *);
+	int feed_bins(OBJECT *, const gld_binding &);
 };
 
 #endif // C++
@@ -18,6 +18,51 @@ CLASS *metrics_collector::oclass = NULL;
 CLASS *metrics_collector::pclass = NULL;
 metrics_collector *metrics_collector::defaults = NULL;
 
+// Parent properties sampled for each parent type, and the parent_property[] slot each is bound to
+static struct s_parentproperties {
+	const char *parent; // parent_string
+	const char *isa; // optional parent class restriction
+	struct {
+		int slot;
+		const char *name;
+		PROPERTYTYPE ptype;
+	} property[PP_ARRAY_SIZE];
+} parent_properties[] = {
+	{"triplex_meter", NULL, {
+		{PP_REAL_POWER,"measured_real_power",PT_double}, {PP_REAC_POWER,"measured_reactive_power",PT_double},
+		{PP_PRICE,"price",PT_double}, {PP_NOMINAL_VOLTAGE,"nominal_voltage",PT_double},
+		{PP_VOLTAGE_1,"voltage_1",PT_complex}, {PP_VOLTAGE_2,"voltage_2",PT_complex}, {PP_VOLTAGE_12,"voltage_12",PT_complex},
+	}},
+	{"meter", NULL, {
+		{PP_REAL_POWER,"measured_real_power",PT_double}, {PP_REAC_POWER,"measured_reactive_power",PT_double},
+		{PP_PRICE,"price",PT_double}, {PP_NOMINAL_VOLTAGE,"nominal_voltage",PT_double},
+		{PP_VOLTAGE_A,"voltage_A",PT_complex}, {PP_VOLTAGE_B,"voltage_B",PT_complex}, {PP_VOLTAGE_C,"voltage_C",PT_complex},
+		{PP_VOLTAGE_AB,"voltage_AB",PT_complex}, {PP_VOLTAGE_BC,"voltage_BC",PT_complex}, {PP_VOLTAGE_CA,"voltage_CA",PT_complex},
+	}},
+	{"house", NULL, {
+		{PP_TOTAL_LOAD,"total_load",PT_double}, {PP_HVAC_LOAD,"hvac_load",PT_double}, {PP_AIR_TEMP,"air_temperature",PT_double},
+		{PP_COOLING_SETPOINT,"cooling_setpoint",PT_double}, {PP_HEATING_SETPOINT,"heating_setpoint",PT_double},
+	}},
+	{"waterheater", NULL, {
+		{PP_ACTUAL_LOAD,"actual_load",PT_double},
+	}},
+	{"inverter", NULL, {
+		{PP_VA_OUT,"VA_Out",PT_complex},
+	}},
+	{"capacitor", NULL, {
+		{PP_OPERATION_CNT_A,"cap_A_switch_count",PT_double}, {PP_OPERATION_CNT_B,"cap_B_switch_count",PT_double}, {PP_OPERATION_CNT_C,"cap_C_switch_count",PT_double},
+	}},
+	{"regulator", NULL, {
+		{PP_OPERATION_CNT_A,"tap_A_change_count",PT_double}, {PP_OPERATION_CNT_B,"tap_B_change_count",PT_double}, {PP_OPERATION_CNT_C,"tap_C_change_count",PT_double},
+	}},
+	{"swingbus", "substation", {
+		{PP_FEEDER_POWER,"distribution_load",PT_complex},
+	}},
+	{"swingbus", NULL, {
+		{PP_FEEDER_POWER,"measured_power",PT_complex},
+	}},
+};
+
 void new_metrics_collector(MODULE *mod){
 	new metrics_collector(mod);
 }
@@ -142,6 +187,28 @@ int metrics_collector::init(OBJECT *parent){
 		return 0;
 	}
 
+	// Bind the parent properties once so read_line does not look them up by name every step
+	for ( size_t n = 0 ; n < sizeof(parent_properties)/sizeof(parent_properties[0]) ; n++ )
+	{
+		if ( strcmp(parent_string,parent_properties[n].parent) != 0 )
+			continue;
+		if ( parent_properties[n].isa != NULL && ! gl_object_isa(parent,parent_properties[n].isa) )
+			continue;
+		for ( size_t m = 0 ; m < PP_ARRAY_SIZE && parent_properties[n].property[m].name != NULL ; m++ )
+		{
+			if ( ! parent_property[parent_properties[n].property[m].slot].bind(parent->oclass,parent_properties[n].property[m].name,parent_properties[n].property[m].ptype) )
+			{
+				gl_error("metrics_collector:%d parent %s does not have a usable property '%s'", obj->id, parent->name?parent->name:"unnamed", parent_properties[n].property[m].name);
+				/*  TROUBLESHOOT
+				The parent of the metrics_collector does not publish a property the collector needs, or publishes it with a different type.
+				Check the parent class of the metrics_collector.
+				*/
+				return 0;
+			}
+		}
+		break;
+	}
+
 	// Create the structures for JSON outputs
 	if (strcmp(parent_string, "triplex_meter") == 0)
 	{
@@ -519,6 +586,18 @@ int metrics_collector::init(OBJECT *parent){
 	}
 
 
+	// Account for the interval arrays in the memory report
+	double *arrays[] = {real_power_array, reactive_power_array, voltage_vll_array, voltage_vln_array,
+		voltage_unbalance_array, total_load_array, hvac_load_array, air_temperature_array, dev_cooling_array,
+		dev_heating_array, wh_load_array, count_array, real_power_loss_array, reactive_power_loss_array};
+	size_t n_arrays = 0;
+	for ( size_t n = 0 ; n < sizeof(arrays)/sizeof(arrays[0]) ; n++ )
+	{
+		if ( arrays[n] != NULL ) n_arrays++;
+	}
+	static HEAPACCOUNT *interval_account = gl_heap_account("tape","metrics intervals");
+	gl_heap_add(interval_account,n_arrays*interval_length*sizeof(double));
+
 	// Initialize tracking variables
 	curr_index = 0;
 	last_index = 0;
@@ -597,18 +676,18 @@ int metrics_collector::read_line(OBJECT *obj)
 	if (strcmp(parent_string, "triplex_meter") == 0) 
 	{
 		// Get power values
-		double realPower = *gl_get_double_by_name(obj->parent, "measured_real_power");
-		double reactivePower = *gl_get_double_by_name(obj->parent, "measured_reactive_power");
+		double realPower = parent_property[PP_REAL_POWER].get_double(obj->parent);
+		double reactivePower = parent_property[PP_REAC_POWER].get_double(obj->parent);
 		interpolate (real_power_array, last_index, curr_index, realPower);
 		interpolate (reactive_power_array, last_index, curr_index, reactivePower);
 
 		// Get bill value, price unit given in triplex_meter is [$/kWh]
-		price_parent = *gl_get_double_by_name(obj->parent, "price");
+		price_parent = parent_property[PP_PRICE].get_double(obj->parent);
 
 		// Get voltage values, s1 to ground, s2 to ground, s1 to s2
-		double v1 = (*gl_get_complex_by_name(obj->parent, "voltage_1")).Mag();  
-		double v2 = (*gl_get_complex_by_name(obj->parent, "voltage_2")).Mag();  
-		double v12 = (*gl_get_complex_by_name(obj->parent, "voltage_12")).Mag();
+		double v1 = parent_property[PP_VOLTAGE_1].get_complex(obj->parent).Mag();  
+		double v2 = parent_property[PP_VOLTAGE_2].get_complex(obj->parent).Mag();  
+		double v12 = parent_property[PP_VOLTAGE_12].get_complex(obj->parent).Mag();
 
 		// If it is at the starting time, record the voltage for violation analysis
 		if (start_time == gl_globalclock) {
@@ -623,18 +702,18 @@ int metrics_collector::read_line(OBJECT *obj)
 	}
 	else if (strcmp(parent_string, "meter") == 0)
 	{
-		double realPower = *gl_get_double_by_name(obj->parent, "measured_real_power");
-		double reactivePower = *gl_get_double_by_name(obj->parent, "measured_reactive_power");
+		double realPower = parent_property[PP_REAL_POWER].get_double(obj->parent);
+		double reactivePower = parent_property[PP_REAC_POWER].get_double(obj->parent);
 		interpolate (real_power_array, last_index, curr_index, realPower);
 		interpolate (reactive_power_array, last_index, curr_index, reactivePower);
 
 		// Get bill value, price unit given is [$/kWh]
-		price_parent = *gl_get_double_by_name(obj->parent, "price");
+		price_parent = parent_property[PP_PRICE].get_double(obj->parent);
 
 		// assuming these are three-phase loads; this is the only difference with triplex meters 
-		double va = (*gl_get_complex_by_name(obj->parent, "voltage_A")).Mag();   
-		double vb = (*gl_get_complex_by_name(obj->parent, "voltage_B")).Mag();   
-		double vc = (*gl_get_complex_by_name(obj->parent, "voltage_C")).Mag();
+		double va = parent_property[PP_VOLTAGE_A].get_complex(obj->parent).Mag();   
+		double vb = parent_property[PP_VOLTAGE_B].get_complex(obj->parent).Mag();   
+		double vc = parent_property[PP_VOLTAGE_C].get_complex(obj->parent).Mag();
 		double vavg = (va + vb + vc) / 3.0;
 		double vmin = va;
 		double vmax = va;
@@ -642,9 +721,9 @@ int metrics_collector::read_line(OBJECT *obj)
 		if (vb > vmax) vmax = vb;
 		if (vc < vmin) vmin = vc;
 		if (vc > vmax) vmax = vc;
-		double vab = (*gl_get_complex_by_name(obj->parent, "voltage_AB")).Mag();   
-		double vbc = (*gl_get_complex_by_name(obj->parent, "voltage_BC")).Mag();   
-		double vca = (*gl_get_complex_by_name(obj->parent, "voltage_CA")).Mag();
+		double vab = parent_property[PP_VOLTAGE_AB].get_complex(obj->parent).Mag();   
+		double vbc = parent_property[PP_VOLTAGE_BC].get_complex(obj->parent).Mag();   
+		double vca = parent_property[PP_VOLTAGE_CA].get_complex(obj->parent).Mag();
 		double vll = (vab + vbc + vca) / 3.0;
 		// determine unbalance per C84.1
 		double vdev = fabs(vab - vll);
@@ -665,49 +744,44 @@ int metrics_collector::read_line(OBJECT *obj)
 	else if (strcmp(parent_string, "house") == 0)
 	{
 		// Get load values
-		double totalload = *gl_get_double_by_name(obj->parent, "total_load");
+		double totalload = parent_property[PP_TOTAL_LOAD].get_double(obj->parent);
 		interpolate (total_load_array, last_index, curr_index, totalload);
-		double hvacload = *gl_get_double_by_name(obj->parent, "hvac_load");
+		double hvacload = parent_property[PP_HVAC_LOAD].get_double(obj->parent);
 		interpolate (hvac_load_array, last_index, curr_index, hvacload);
 		// Get air temperature values
-		double airTemperature = *gl_get_double_by_name(obj->parent, "air_temperature");
+		double airTemperature = parent_property[PP_AIR_TEMP].get_double(obj->parent);
 		interpolate (air_temperature_array, last_index, curr_index, airTemperature);
 		// Get air temperature deviation from house cooling setpoint
-		double cooling_setpoint = *gl_get_double_by_name(obj->parent, "cooling_setpoint");
+		double cooling_setpoint = parent_property[PP_COOLING_SETPOINT].get_double(obj->parent);
 		interpolate (dev_cooling_array, last_index, curr_index, airTemperature - cooling_setpoint);
 		// Get air temperature deviation from house heating setpoint
-		double heating_setpoint = *gl_get_double_by_name(obj->parent, "heating_setpoint");
+		double heating_setpoint = parent_property[PP_HEATING_SETPOINT].get_double(obj->parent);
 		interpolate (dev_heating_array, last_index, curr_index, airTemperature - heating_setpoint);
 	}
 	else if (strcmp(parent_string, "waterheater") == 0) {
 		// Get load values
-		double actualload = *gl_get_double_by_name(obj->parent, "actual_load");
+		double actualload = parent_property[PP_ACTUAL_LOAD].get_double(obj->parent);
 		interpolate (wh_load_array, last_index, curr_index, actualload);
 	}
 	else if (strcmp(parent_string, "inverter") == 0) {
 		// Get VA_Out values
-		complex VAOut = *gl_get_complex_by_name(obj->parent, "VA_Out");
+		complex VAOut = parent_property[PP_VA_OUT].get_complex(obj->parent);
 		interpolate (real_power_array, last_index, curr_index, (double)VAOut.Re());
 		interpolate (reactive_power_array, last_index, curr_index, (double)VAOut.Im());
 	}
 	else if (strcmp(parent_string, "capacitor") == 0) {
-		double opcount = *gl_get_double_by_name(obj->parent, "cap_A_switch_count")
-			+ *gl_get_double_by_name(obj->parent, "cap_B_switch_count") + *gl_get_double_by_name(obj->parent, "cap_C_switch_count");
+		double opcount = parent_property[PP_OPERATION_CNT_A].get_double(obj->parent)
+			+ parent_property[PP_OPERATION_CNT_B].get_double(obj->parent) + parent_property[PP_OPERATION_CNT_C].get_double(obj->parent);
 		interpolate (count_array, last_index, curr_index, opcount);
 	}
 	else if (strcmp(parent_string, "regulator") == 0) {
-		double opcount = *gl_get_double_by_name(obj->parent, "tap_A_change_count")
-			+ *gl_get_double_by_name(obj->parent, "tap_B_change_count") + *gl_get_double_by_name(obj->parent, "tap_C_change_count");
+		double opcount = parent_property[PP_OPERATION_CNT_A].get_double(obj->parent)
+			+ parent_property[PP_OPERATION_CNT_B].get_double(obj->parent) + parent_property[PP_OPERATION_CNT_C].get_double(obj->parent);
 		interpolate (count_array, last_index, curr_index, opcount);
 	}
 	else if (strcmp(parent_string, "swingbus") == 0) {
 		// Get VAfeeder values
-		complex VAfeeder;
-		if (gl_object_isa(obj->parent,"substation")) {
-			VAfeeder = *gl_get_complex_by_name(obj->parent, "distribution_load");
-		} else {
-			VAfeeder = *gl_get_complex_by_name(obj->parent, "measured_power");
-		}
+		complex VAfeeder = parent_property[PP_FEEDER_POWER].get_complex(obj->parent); // distribution_load on substations, measured_power otherwise
 		interpolate (real_power_array, last_index, curr_index, (double)VAfeeder.Re());
 		interpolate (reactive_power_array, last_index, curr_index, (double)VAfeeder.Im());
 		// Get feeder loss values
@@ -819,7 +893,7 @@ int metrics_collector::write_line(TIMESTAMP t1, OBJECT *obj)
 		metrics[MTR_AVG_VUNB] = findAverage(voltage_unbalance_array, interval_length);
 
 		// Voltage above/below ANSI C84 A/B Range
-		double normVol = *gl_get_double_by_name(obj->parent, "nominal_voltage");
+		double normVol = parent_property[PP_NOMINAL_VOLTAGE].get_double(obj->parent);
 		double aboveRangeA = normVol* 1.05 * (std::sqrt(3));
 		double belowRangeA = normVol* 0.95 * (std::sqrt(3));
 		double aboveRangeB = normVol* 1.058 * (std::sqrt(3));
@@ -101,6 +101,33 @@
 #define REG_OPERATION_CNT   0
 #define REG_ARRAY_SIZE      1
 
+// parent property slots, bound in init from parent_properties[] in metrics_collector.cpp
+#define PP_REAL_POWER        0 // triplex_meter and meter
+#define PP_REAC_POWER        1
+#define PP_PRICE             2
+#define PP_NOMINAL_VOLTAGE   3
+#define PP_VOLTAGE_1         4 // triplex_meter
+#define PP_VOLTAGE_2         5
+#define PP_VOLTAGE_12        6
+#define PP_VOLTAGE_A         4 // meter
+#define PP_VOLTAGE_B         5
+#define PP_VOLTAGE_C         6
+#define PP_VOLTAGE_AB        7
+#define PP_VOLTAGE_BC        8
+#define PP_VOLTAGE_CA        9
+#define PP_TOTAL_LOAD        0 // house
+#define PP_HVAC_LOAD         1
+#define PP_AIR_TEMP          2
+#define PP_COOLING_SETPOINT  3
+#define PP_HEATING_SETPOINT  4
+#define PP_ACTUAL_LOAD       0 // waterheater
+#define PP_VA_OUT            0 // inverter
+#define PP_OPERATION_CNT_A   0 // capacitor and regulator
+#define PP_OPERATION_CNT_B   1
+#define PP_OPERATION_CNT_C   2
+#define PP_FEEDER_POWER      0 // swingbus
+#define PP_ARRAY_SIZE       10
+
 void new_metrics_collector(MODULE *);
 
 #ifdef __cplusplus
@@ -150,6 +177,7 @@ private:
 
 	const char* parent_string;
 	char parent_name[256];
+	gld_binding parent_property[PP_ARRAY_SIZE]; // parent properties read by read_line/write_line, bound in init
 	double *metrics; // depends on the parent class
 
 	// Parameters related to triplex_meter object
@@ -65,6 +65,9 @@ inline char* strtok_t(char *str, const char *delim, char **nextp)
 CLASS *recorder_class = NULL;
 static OBJECT *last_recorder = NULL;
 
+static struct s_recorder_compression *compression_create(const char *deadband);
+static int multirun_open(OBJECT *obj);
+
 EXPORT int create_recorder(OBJECT **obj, OBJECT *parent)
 {
 	*obj = gl_create_object(recorder_class);
@@ -114,6 +117,27 @@ static int recorder_open(OBJECT *obj)
 		return 0;
 	}
 
+	if ( my->compression != RC_NONE )
+	{
+		if ( my->multifile[0] != 0 )
+		{
+			gl_error("compressed recorders cannot use multi-run output files");
+			return 0;
+		}
+		my->compress = compression_create(my->deadband);
+		if ( my->compress == NULL )
+		{
+			gl_error("deadband '%s' is not valid", (const char*)my->deadband);
+			/* TROUBLESHOOT
+				The recorder deadband must be a comma-separated list of non-negative values, one for each
+				property recorded.  A value followed by % is relative to the magnitude of the last value
+				written.  When the list is shorter than the property list, the last value is used for the
+				remaining properties.
+			 */
+			return 0;
+		}
+	}
+
 	/* if no filename given */
 	if (strcmp(my->file,"")==0)
 	{
@@ -121,8 +145,21 @@ static int recorder_open(OBJECT *obj)
 		sprintf(my->file,"%s-%d.%s",obj->parent->oclass->name,obj->parent->id, (char*)my->filetype);
 	}
 
+	/* open multiple-run column files */
+	if ( my->type == FT_FILE && my->multifile[0] != 0 && my->multiformat == MF_COLUMNS )
+	{
+		if ( my->interval < 1 )
+		{
+			gl_error("transient recorders cannot use multi-run output files");
+			return 0;
+		}
+		if ( ! multirun_open(obj) )
+		{
+			return 0;
+		}
+	}
 	/* open multiple-run input file & temp output file */
-	if ( my->type == FT_FILE && my->multifile[0] != 0 )
+	else if ( my->type == FT_FILE && my->multifile[0] != 0 )
 	{
 		if ( my->interval < 1 )
 		{
@@ -396,12 +433,298 @@ static int write_recorder(struct recorder *my, char *ts, char *value)
 	return rc;
 }
 
+/* Column-oriented multi-run output
+
+	Each run writes its values to its own column file <multifile>.<run>, and
+	the first run also writes the time index <multifile>.index, so adding a
+	run only writes the data of that run.  The wide CSV file <multifile> is
+	only written when multimerge is set, by reading the index and the column
+	files of all the runs side by side.
+ */
+static int multirun_open(OBJECT *obj)
+{
+	struct recorder *my = OBJECTDATA(obj,struct recorder);
+	char1024 name;
+
+	// the run number is the first run without a column file
+	for ( my->multirun_ct = 0 ; ; my->multirun_ct++ )
+	{
+		if ( snprintf(name,sizeof(name)-1,"%s.%d",(char*)my->multifile,my->multirun_ct) >= (int)sizeof(name)-1 )
+		{
+			gl_error("multi-run file name '%s' is too long", (char*)my->multifile);
+			/* TROUBLESHOOT
+				The names of the multi-run column, index and temporary files are made by adding
+				a suffix to the multifile or file name, and the result does not fit in 1024 characters.
+				Use a shorter multifile or file name and try again.
+			 */
+			return 0;
+		}
+		if ( access(name,F_OK) != 0 )
+		{
+			break;
+		}
+	}
+	char1024 target;
+	if ( snprintf(my->multitempfile,sizeof(my->multitempfile)-1,"temp_%s.%d",(char*)my->file,my->multirun_ct) >= (int)sizeof(my->multitempfile)-1
+		|| snprintf(target,sizeof(target)-1,"%s %d",obj->parent->oclass->name,obj->parent->id) >= (int)sizeof(target)-1
+		|| snprintf(name,sizeof(name)-1,"%s.index",(char*)my->multifile) >= (int)sizeof(name)-1 )
+	{
+		gl_error("multi-run file name '%s' is too long", (char*)my->multifile);
+		return 0;
+	}
+	if ( my->multirun_ct == 0 )
+	{
+		my->indexfp = fopen(name,"w");
+		if ( my->indexfp == NULL )
+		{
+			gl_error("unable to open '%s' for multi-run output", (char*)name);
+			return 0;
+		}
+		time_t now = time(NULL);
+		fprintf(my->indexfp,"# file...... %s\n", (char*)my->file);
+		fprintf(my->indexfp,"# date...... %s", asctime(localtime(&now)));
+		fprintf(my->indexfp,"# user...... %s\n", getenv("USER"));
+		fprintf(my->indexfp,"# host...... %s\n", getenv("HOST"));
+		fprintf(my->indexfp,"# target.... %s\n", (char*)target);
+		fprintf(my->indexfp,"# trigger... %s\n", my->trigger[0]=='\0'?"(none)":(char*)my->trigger);
+		fprintf(my->indexfp,"# interval.. %lld\n", my->interval);
+		fprintf(my->indexfp,"# limit..... %d\n", my->limit);
+		fprintf(my->indexfp,"# flush..... %d\n", my->flush);
+		fprintf(my->indexfp,"# property.. %s\n", my->property);
+		fprintf(my->indexfp,"# timestamp\n");
+	}
+	else
+	{
+		my->inputfp = fopen(name,"r");
+		if ( my->inputfp == NULL )
+		{
+			gl_error("unable to open multi-run index '%s'", (char*)name);
+			/* TROUBLESHOOT
+				A column file of a previous run exists but the multi-run index file does not.
+				Remove the column files of the previous runs, or restore the index file, and try again.
+			 */
+			return 0;
+		}
+		// verify the index header, which ends with the timestamp column header
+		char1024 inbuffer;
+		while ( fgets(inbuffer,sizeof(inbuffer)-1,my->inputfp) != NULL && strncmp(inbuffer,"# timestamp",11) != 0 )
+		{
+			char *end = strchr(inbuffer,'\n');
+			char *data = inbuffer+strlen("# file...... ");
+			if ( end != NULL )
+			{
+				*end = '\0';
+			}
+			if ( strncmp(inbuffer,"# target",8) == 0 && strcmp(target,data) != 0 )
+			{
+				gl_error("recorder:%i: re-recording target mismatch: was %s, now %s", obj->id, data, (char*)target);
+			}
+			else if ( strncmp(inbuffer,"# interval",10) == 0 && atoi(data) != my->interval )
+			{
+				gl_error("recorder:%i: re-recording interval mismatch: was %i, now %i", obj->id, atoi(data), my->interval);
+			}
+			else if ( strncmp(inbuffer,"# limit",7) == 0 && atoi(data) != my->limit )
+			{
+				gl_error("recorder:%i: re-recording limit mismatch: was %i, now %i", obj->id, atoi(data), my->limit);
+			}
+			else if ( strncmp(inbuffer,"# property",10) == 0 && strcmp(my->property,data) != 0 )
+			{
+				gl_error("recorder:%i: re-recording property mismatch: was %s, now %s", obj->id, data, my->property);
+			}
+		}
+	}
+
+	my->multifp = fopen(my->multitempfile,"w");
+	if ( my->multifp == NULL )
+	{
+		gl_error("unable to open '%s' for multi-run output", (char*)my->multitempfile);
+		return 0;
+	}
+	fprintf(my->multifp,"# repetition %d\n", my->multirun_ct);
+	fprintf(my->multifp,"#");
+	for ( PROPERTY *prop = my->target ; prop != NULL ; prop = prop->next )
+	{
+		fprintf(my->multifp,"%c%s(%d)", prop==my->target?' ':',', prop->name, my->multirun_ct);
+	}
+	fprintf(my->multifp,"\n");
+	return 1;
+}
+
+/* write a row to the multi-run column file, returns 0 when the index of the first run is exhausted */
+static int multirun_write(struct recorder *my, const char *ts, const char *value)
+{
+	if ( my->indexfp != NULL )
+	{
+		fprintf(my->indexfp,"%s\n",ts);
+	}
+	else
+	{
+		char1024 inbuffer;
+		do {
+			if ( fgets(inbuffer,sizeof(inbuffer)-1,my->inputfp) == NULL )
+			{
+				return 0;
+			}
+		} while ( inbuffer[0] == '#' );
+		char *end = strchr(inbuffer,'\n');
+		if ( end != NULL )
+		{
+			*end = '\0';
+		}
+		if ( strcmp(inbuffer,ts) != 0 )
+		{
+			gl_warning("timestamp mismatch between current input line and simulation time");
+		}
+	}
+	fprintf(my->multifp,"%s\n",value);
+	return 1;
+}
+
+/* merge the multi-run index and column files into the wide CSV file */
+static int multirun_merge(struct recorder *my)
+{
+	char1024 name;
+	int runs;
+	for ( runs = 0 ; ; runs++ )
+	{
+		if ( snprintf(name,sizeof(name)-1,"%s.%d",(char*)my->multifile,runs) >= (int)sizeof(name)-1 )
+		{
+			gl_error("multi-run file name '%s' is too long", (char*)my->multifile);
+			return 0;
+		}
+		if ( access(name,F_OK) != 0 )
+		{
+			break;
+		}
+	}
+	char1024 indexname;
+	if ( snprintf(indexname,sizeof(indexname)-1,"%s.index",(char*)my->multifile) >= (int)sizeof(indexname)-1
+		|| snprintf(name,sizeof(name)-1,"temp_%s",(char*)my->file) >= (int)sizeof(name)-1 )
+	{
+		gl_error("multi-run file name '%s' is too long", (char*)my->multifile);
+		return 0;
+	}
+	FILE *index = fopen(indexname,"r");
+	FILE **column = (FILE**)calloc(runs,sizeof(FILE*));
+	char *line = (char*)malloc(65536);
+	FILE *out = fopen(name,"w");
+	int ok = ( index != NULL && column != NULL && line != NULL && out != NULL );
+	for ( int n = 0 ; ok && n < runs ; n++ )
+	{
+		char1024 colname;
+		ok = ( snprintf(colname,sizeof(colname)-1,"%s.%d",(char*)my->multifile,n) < (int)sizeof(colname)-1 );
+		column[n] = ok ? fopen(colname,"r") : NULL;
+		ok = ( column[n] != NULL );
+	}
+	if ( ok )
+	{
+		// header of the index, and the column names of each run
+		while ( fgets(line,65536,index) != NULL && strncmp(line,"# timestamp",11) != 0 )
+		{
+			fputs(line,out);
+		}
+		fprintf(out,"# repetition %d\n# timestamp",runs-1);
+		for ( int n = 0 ; n < runs ; n++ )
+		{
+			while ( fgets(line,65536,column[n]) != NULL && strncmp(line,"# repetition",12) == 0 ) {}
+			line[strcspn(line,"\n")] = '\0';
+			fprintf(out,",%s",line+2);
+		}
+		fprintf(out,"\n");
+
+		// rows
+		while ( fgets(line,65536,index) != NULL )
+		{
+			line[strcspn(line,"\n")] = '\0';
+			fputs(line,out);
+			for ( int n = 0 ; n < runs ; n++ )
+			{
+				fputc(',',out);
+				if ( fgets(line,65536,column[n]) != NULL )
+				{
+					line[strcspn(line,"\n")] = '\0';
+					fputs(line,out);
+				}
+			}
+			fputc('\n',out);
+		}
+	}
+	else
+	{
+		gl_error("unable to merge multi-run column files of '%s'", (char*)my->multifile);
+		/* TROUBLESHOOT
+			The multi-run index or column files could not be read, or the merged CSV file could not be written.
+			Check that the files of all the previous runs are present and that the folder is writable.
+		 */
+	}
+	for ( int n = 0 ; column != NULL && n < runs ; n++ )
+	{
+		if ( column[n] != NULL )
+		{
+			fclose(column[n]);
+		}
+	}
+	free(column);
+	free(line);
+	if ( index != NULL )
+	{
+		fclose(index);
+	}
+	if ( out != NULL && fclose(out) != 0 )
+	{
+		ok = 0;
+	}
+	if ( ok && rename(name,my->multifile) != 0 )
+	{
+		gl_error("unable to rename multi-run file '%s' to '%s'", (char*)name, (char*)my->multifile);
+		ok = 0;
+	}
+	return ok;
+}
+
+/* close the multi-run column files, and merge them if requested */
+static void multirun_close(struct recorder *my)
+{
+	if ( my->indexfp != NULL )
+	{
+		fclose(my->indexfp);
+		my->indexfp = NULL;
+	}
+	if ( my->inputfp != NULL )
+	{
+		fclose(my->inputfp);
+		my->inputfp = NULL;
+	}
+	if ( my->multifp != NULL )
+	{
+		fclose(my->multifp);
+		my->multifp = NULL;
+		char1024 name;
+		if ( snprintf(name,sizeof(name)-1,"%s.%d",(char*)my->multifile,my->multirun_ct) >= (int)sizeof(name)-1 )
+		{
+			gl_error("multi-run file name '%s' is too long", (char*)my->multifile);
+		}
+		else if ( rename(my->multitempfile,name) != 0 )
+		{
+			gl_error("unable to rename multi-run file '%s' to '%s'", (char*)my->multitempfile, (char*)name);
+		}
+		else if ( my->multimerge )
+		{
+			multirun_merge(my);
+		}
+	}
+}
+
 static void close_recorder(struct recorder *my)
 {
 	if (my->ops){
 		my->ops->close(my);
 	}
-	if(my->multifp){
+	if ( my->multiformat == MF_COLUMNS )
+	{
+		multirun_close(my);
+	}
+	else if(my->multifp){
 		if(0 != fclose(my->multifp)){
 			gl_error("unable to close multi-run temp file \'%s\'", (char*)my->multitempfile);
 			perror("fclose(): ");
@@ -424,28 +747,34 @@ static void close_recorder(struct recorder *my)
 	}
 }
 
-static TIMESTAMP recorder_write(OBJECT *obj)
+static void recorder_timestamp(struct recorder *my, TIMESTAMP t0, char *ts, size_t size)
 {
-	struct recorder *my = OBJECTDATA(obj,struct recorder);
-	char ts[64]="0"; /* 0 = INIT */
+	strcpy(ts,"0"); /* 0 = INIT */
 	if (my->format==0)
 	{
-		if (my->last.ts>TS_ZERO)
+		if (t0>TS_ZERO)
 		{
-			time_t t = (time_t)(my->last.ts);
-			if ( my->strftime_format[0]==0 || strftime(ts,sizeof(ts),(char*)(my->strftime_format),localtime(&t))==0 )
+			time_t t = (time_t)(t0);
+			if ( my->strftime_format[0]==0 || strftime(ts,size,(char*)(my->strftime_format),localtime(&t))==0 )
 			{
 				DATETIME dt;
-				gl_localtime(my->last.ts,&dt);
-				gl_strtime(&dt,ts,sizeof(ts));
+				gl_localtime(t0,&dt);
+				gl_strtime(&dt,ts,size);
 			}
 		}
 		/* else leave INIT in the buffer */
 	}
 	else
-		sprintf(ts,"%" FMT_INT64 "d", my->last.ts);
+		snprintf(ts,size,"%" FMT_INT64 "d", t0);
+}
+
+static TIMESTAMP recorder_write_row(OBJECT *obj, TIMESTAMP t0, const char *value)
+{
+	struct recorder *my = OBJECTDATA(obj,struct recorder);
+	char ts[64];
+	recorder_timestamp(my,t0,ts,sizeof(ts));
 	if ((my->limit>0 && my->samples > my->limit) /* limit reached */
-		|| write_recorder(my, ts, my->last.value)==0) /* write failed */
+		|| write_recorder(my, ts, (char*)value)==0) /* write failed */
 	{
 		close_recorder(my);
 		my->status = TS_DONE;
@@ -455,8 +784,13 @@ static TIMESTAMP recorder_write(OBJECT *obj)
 
 	/* at this point we've written the sample to the normal recorder output */
 
+	// if column files
+	if ( my->multifp != NULL && my->multiformat == MF_COLUMNS )
+	{
+		multirun_write(my,ts,value);
+	}
 	// if file based
-	if(my->multifp != NULL){
+	else if(my->multifp != NULL){
 		char1024 inbuffer;
 		char outbuffer[5100];
 		char *lasts = 0;
@@ -497,9 +831,9 @@ static TIMESTAMP recorder_write(OBJECT *obj)
 			if(strcmp(in_ts, ts) != 0){
 				gl_warning("timestamp mismatch between current input line and simulation time");
 			}
-			snprintf(outbuffer,sizeof(outbuffer)-1,"%s,%s", in_tok, (char*)my->last.value);
+			snprintf(outbuffer,sizeof(outbuffer)-1,"%s,%s", in_tok, value);
 		} else { // no input file ~ write normal output
-			strcpy(outbuffer, my->last.value);
+			strcpy(outbuffer, value);
 		}
 		// fprintf 
 		fprintf(my->multifp, "%s,%s\n", ts, (char*)outbuffer);
@@ -507,6 +841,302 @@ static TIMESTAMP recorder_write(OBJECT *obj)
 	return TS_NEVER;
 }
 
+/* Recorder compression
+
+	Rows are compared numerically with the last row written.  A DEADBAND
+	recorder only writes a row when a value differs from the last row written
+	by more than its deadband.  A SWINGDOOR recorder holds each row until the
+	next row shows that no straight line from the last row written can pass
+	within the deadband of every row since, and then writes the held row, so
+	the series can be reconstructed within the deadband by linear
+	interpolation.  Columns that are not numbers are compared as text and any
+	change is written.
+ */
+#define RC_MAXCOLUMNS 256
+struct s_recorder_compression {
+	unsigned int nbands;
+	double band[RC_MAXCOLUMNS]; // deadband of each column
+	bool relative[RC_MAXCOLUMNS]; // deadband is relative to the magnitude of the last value written
+	int ncols;
+	char kind[RC_MAXCOLUMNS]; // 'r' real, 'c' complex, 'x' text
+	double value[2*RC_MAXCOLUMNS]; // last values written (real and imaginary parts)
+	double upper[2*RC_MAXCOLUMNS]; // swinging door upper slopes
+	double lower[2*RC_MAXCOLUMNS]; // swinging door lower slopes
+	bool started;
+	TIMESTAMP ts; // time of last row written
+	char text[sizeof(((struct recorder*)NULL)->last.value)]; // last row written
+	bool is_held;
+	TIMESTAMP held_ts; // time of row held by swinging door
+	char held[sizeof(((struct recorder*)NULL)->last.value)]; // row held by swinging door
+};
+
+/* parse a recorded row into its columns, returns the number of columns or -1 if there are too many */
+static int compression_parse(const char *row, char *kind, double *value)
+{
+	int n;
+	const char *p = row;
+	for ( n = 0 ; ; n++ )
+	{
+		if ( n >= RC_MAXCOLUMNS )
+		{
+			return -1;
+		}
+		const char *next = strchr(p,',');
+		const char *end = next ? next : p+strlen(p);
+		char *e;
+		double a = strtod(p,&e);
+		kind[n] = 'x';
+		value[2*n] = value[2*n+1] = 0.0;
+		if ( e > p )
+		{
+			char part = '\0';
+			double b = 0.0;
+			if ( *e == '+' || *e == '-' )
+			{
+				char *e2;
+				b = strtod(e,&e2);
+				part = ( e2 > e && e2 < end ) ? *e2 : '\0';
+				e = ( part != '\0' && strchr("ijdr",part) != NULL ) ? e2+1 : (char*)p;
+			}
+			if ( e > p && ( e == end || *e == ' ' ) )
+			{
+				switch ( part ) {
+				case '\0':
+					kind[n] = 'r';
+					value[2*n] = a;
+					break;
+				case 'd':
+					b *= PI/180;
+					/* no break */
+				case 'r':
+					kind[n] = 'c';
+					value[2*n] = a*cos(b);
+					value[2*n+1] = a*sin(b);
+					break;
+				default:
+					kind[n] = 'c';
+					value[2*n] = a;
+					value[2*n+1] = b;
+					break;
+				}
+			}
+		}
+		if ( next == NULL )
+		{
+			return n+1;
+		}
+		p = next+1;
+	}
+}
+
+/* parse the deadband list */
+static bool compression_bands(struct s_recorder_compression *c, const char *spec)
+{
+	const char *p = spec;
+	for ( c->nbands = 0 ; *p != '\0' && c->nbands < RC_MAXCOLUMNS ; c->nbands++ )
+	{
+		char *e;
+		double band = strtod(p,&e);
+		while ( isspace(*e) ) e++;
+		c->relative[c->nbands] = ( *e == '%' );
+		if ( *e == '%' )
+		{
+			band /= 100;
+			e++;
+			while ( isspace(*e) ) e++;
+		}
+		if ( e == p || band < 0 || ( *e != ',' && *e != '\0' ) )
+		{
+			return false;
+		}
+		c->band[c->nbands] = band;
+		p = ( *e == ',' ) ? e+1 : e;
+	}
+	return c->nbands > 0;
+}
+
+/* create the compression state, returns NULL if the deadband list is not valid */
+static struct s_recorder_compression *compression_create(const char *deadband)
+{
+	struct s_recorder_compression *c = (struct s_recorder_compression*)calloc(1,sizeof(struct s_recorder_compression));
+	if ( c != NULL && ! compression_bands(c,deadband) )
+	{
+		free(c);
+		c = NULL;
+	}
+	return c;
+}
+
+/* get the deadband of a column relative to the last row written */
+static double compression_band(struct s_recorder_compression *c, int n)
+{
+	int k = ( n < (int)c->nbands ) ? n : c->nbands-1;
+	return c->relative[k] ? c->band[k] * hypot(c->value[2*n],c->value[2*n+1]) : c->band[k];
+}
+
+/* check whether a row differs from the last row written (text only, or also numbers by more than their deadband) */
+static bool compression_changed(struct s_recorder_compression *c, const char *row, int ncols, const char *kind, const double *value, bool numeric)
+{
+	if ( ncols != c->ncols )
+	{
+		return true;
+	}
+	const char *p = row, *q = c->text;
+	for ( int n = 0 ; n < ncols ; n++ )
+	{
+		const char *pnext = strchr(p,','), *qnext = strchr(q,',');
+		size_t plen = pnext ? (size_t)(pnext-p) : strlen(p);
+		size_t qlen = qnext ? (size_t)(qnext-q) : strlen(q);
+		if ( kind[n] != c->kind[n] )
+		{
+			return true;
+		}
+		else if ( kind[n] == 'x' )
+		{
+			if ( plen != qlen || strncmp(p,q,plen) != 0 )
+			{
+				return true;
+			}
+		}
+		else if ( numeric && hypot(value[2*n]-c->value[2*n],value[2*n+1]-c->value[2*n+1]) > compression_band(c,n) )
+		{
+			return true;
+		}
+		p += plen + (pnext?1:0);
+		q += qlen + (qnext?1:0);
+	}
+	return false;
+}
+
+/* narrow the swinging door to include a row, returns false if the door closes */
+static bool compression_door(struct s_recorder_compression *c, TIMESTAMP t, const double *value, bool open)
+{
+	double dt = (double)(t - c->ts);
+	double upper[2*RC_MAXCOLUMNS], lower[2*RC_MAXCOLUMNS];
+	for ( int n = 0 ; n < 2*c->ncols ; n++ )
+	{
+		double band = compression_band(c,n/2);
+		upper[n] = (value[n] + band - c->value[n]) / dt;
+		lower[n] = (value[n] - band - c->value[n]) / dt;
+		if ( ! open )
+		{
+			upper[n] = ( upper[n] < c->upper[n] ) ? upper[n] : c->upper[n];
+			lower[n] = ( lower[n] > c->lower[n] ) ? lower[n] : c->lower[n];
+			if ( lower[n] > upper[n] )
+			{
+				return false;
+			}
+		}
+	}
+	memcpy(c->upper,upper,sizeof(double)*2*c->ncols);
+	memcpy(c->lower,lower,sizeof(double)*2*c->ncols);
+	return true;
+}
+
+/* write a row and make it the reference for compression */
+static void compression_write(OBJECT *obj, TIMESTAMP t, const char *row, int ncols, const char *kind, const double *value)
+{
+	struct recorder *my = OBJECTDATA(obj,struct recorder);
+	struct s_recorder_compression *c = my->compress;
+	recorder_write_row(obj,t,row);
+	c->started = true;
+	c->ts = t;
+	snprintf(c->text,sizeof(c->text),"%s",row);
+	c->ncols = ncols;
+	memcpy(c->kind,kind,ncols);
+	memcpy(c->value,value,sizeof(double)*2*ncols);
+}
+
+/* account for a row that is not written */
+static void compression_omit(struct recorder *my, TIMESTAMP t, const char *row)
+{
+	char ts[64];
+	recorder_timestamp(my,t,ts,sizeof(ts));
+	my->compressed_rows++;
+	my->compressed_bytes += strlen(ts) + strlen(row) + 2;
+}
+
+/* write the row held by the swinging door */
+static void compression_flush(OBJECT *obj)
+{
+	struct recorder *my = OBJECTDATA(obj,struct recorder);
+	struct s_recorder_compression *c = my->compress;
+	if ( c != NULL && c->is_held )
+	{
+		char kind[RC_MAXCOLUMNS];
+		double value[2*RC_MAXCOLUMNS];
+		c->is_held = false;
+		compression_write(obj,c->held_ts,c->held,compression_parse(c->held,kind,value),kind,value);
+	}
+}
+
+static void recorder_compress(OBJECT *obj, TIMESTAMP t, const char *row)
+{
+	struct recorder *my = OBJECTDATA(obj,struct recorder);
+	struct s_recorder_compression *c = my->compress;
+	char kind[RC_MAXCOLUMNS];
+	double value[2*RC_MAXCOLUMNS];
+	int ncols = compression_parse(row,kind,value);
+	if ( ncols < 0 )
+	{
+		compression_flush(obj);
+		recorder_write_row(obj,t,row);
+		c->started = false;
+		return;
+	}
+	if ( ! c->started )
+	{
+		compression_write(obj,t,row,ncols,kind,value);
+	}
+	else if ( my->compression == RC_DEADBAND || ( ! c->is_held && t <= c->ts ) )
+	{
+		if ( compression_changed(c,row,ncols,kind,value,true) )
+		{
+			compression_write(obj,t,row,ncols,kind,value);
+		}
+		else
+		{
+			compression_omit(my,t,row);
+		}
+	}
+	else if ( ! c->is_held )
+	{
+		if ( compression_changed(c,row,ncols,kind,value,false) )
+		{
+			compression_write(obj,t,row,ncols,kind,value);
+		}
+		else
+		{
+			compression_door(c,t,value,true);
+			c->is_held = true;
+			c->held_ts = t;
+			snprintf(c->held,sizeof(c->held),"%s",row);
+		}
+	}
+	else if ( t <= c->held_ts || compression_changed(c,row,ncols,kind,value,false) || ! compression_door(c,t,value,false) )
+	{
+		compression_flush(obj);
+		recorder_compress(obj,t,row);
+	}
+	else
+	{
+		compression_omit(my,c->held_ts,c->held);
+		c->held_ts = t;
+		snprintf(c->held,sizeof(c->held),"%s",row);
+	}
+}
+
+static TIMESTAMP recorder_write(OBJECT *obj)
+{
+	struct recorder *my = OBJECTDATA(obj,struct recorder);
+	if ( my->compress == NULL )
+	{
+		return recorder_write_row(obj,my->last.ts,my->last.value);
+	}
+	recorder_compress(obj,my->last.ts,my->last.value);
+	return TS_NEVER;
+}
+
 #define BLOCKSIZE 1024
 EXPORT int method_recorder_property(OBJECT *obj, ...)
 {
@@ -849,6 +1479,16 @@ CDECL int read_properties(struct recorder *my, OBJECT *obj, PROPERTY *prop, char
 EXPORT int finalize_recorder(OBJECT *obj)
 {
 	struct recorder *my = OBJECTDATA(obj,struct recorder);
+	if ( my->compress != NULL )
+	{
+		if ( my->status == TS_OPEN )
+		{
+			compression_flush(obj);
+		}
+		gl_verbose("recorder:%d: %d rows written, %" FMT_INT64 "d rows and %" FMT_INT64 "d bytes omitted by compression", obj->id, my->samples, my->compressed_rows, my->compressed_bytes);
+		free(my->compress);
+		my->compress = NULL;
+	}
 	close_recorder(my);
 	return 1;
 }
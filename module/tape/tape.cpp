@@ -82,6 +82,7 @@ static char1024 tape_gnuplot_path;
 int32 flush_interval = 0;
 int csv_data_only = 0; /* enable this option to suppress addition of lines starting with # in CSV */
 int csv_keep_clean = 0; /* enable this option to keep data flushed at end of line */
+static TAPEOPTIONS options = {2,0};
 
 typedef int (*OPENFUNC)(void *, char *, char *);
 typedef char *(*READFUNC)(void *, char *, unsigned int);
@@ -111,6 +112,7 @@ TAPEFUNCS *get_ftable(char *mode){
 	TAPEOPS *ops = NULL;
 	void *lib = NULL;
 	CALLBACKS **c = NULL;
+	TAPEOPTIONS **o = NULL;
 	char tpath[1024];
 	while(fptr != NULL){
 		if(strcmp(fptr->mode, mode) == 0)
@@ -138,6 +140,9 @@ TAPEFUNCS *get_ftable(char *mode){
 	c = (CALLBACKS **)DLSYM(lib, "callback");
 	if(c)
 		*c = callback;
+	o = (TAPEOPTIONS **)DLSYM(lib, "tape_options");
+	if(o)
+		*o = &options;
 
 	//	nonfatal ommission
 	ops = fptr->collector = (TAPEOPS*)malloc(sizeof(TAPEOPS));
@@ -224,6 +229,8 @@ EXPORT CLASS *init(CALLBACKS *fntable, void *module, int argc, char *argv[])
 		PT_KEYWORD,"NAME",(enumeration)2,
 		NULL);
 	gl_global_create("tape::csv_keep_clean",PT_int32,&csv_keep_clean,NULL);
+	gl_global_create("tape::plot_renderers",PT_int32,&options.plot_renderers,PT_DESCRIPTION,"maximum number of background gnuplot renderers used by plot tapes (0 renders synchronously)",NULL);
+	gl_global_create("tape::plot_refresh",PT_int32,&options.plot_refresh,PT_DESCRIPTION,"simulation seconds between partial renders of plot tapes (0 disables partial renders)",NULL);
 
 	/* control delta mode */
 	gl_global_create("tape::delta_mode_needed", PT_timestamp, &delta_mode_needed,NULL);
@@ -277,6 +284,14 @@ EXPORT CLASS *init(CALLBACKS *fntable, void *module, int argc, char *argv[])
 			PT_DEFAULT, "file",
 			PT_DESCRIPTION, "recorder operating mode",
 		PT_char1024,"multifile", ((char*)&(my1.multifile) - (char*)&my1),
+		PT_enumeration,"multiformat", ((char*)&(my1.multiformat) - (char*)&my1),
+			PT_DEFAULT, "WIDE",
+			PT_KEYWORD, "WIDE", MF_WIDE,
+			PT_KEYWORD, "COLUMNS", MF_COLUMNS,
+			PT_DESCRIPTION, "multi-run output layout (WIDE rewrites the CSV file each run, COLUMNS writes a column file per run)",
+		PT_bool,"multimerge", ((char*)&(my1.multimerge) - (char*)&my1),
+			PT_DEFAULT, "FALSE",
+			PT_DESCRIPTION, "merge the multi-run column files into the CSV file at the end of the run",
 		PT_int32,"limit", ((char*)&(my1.limit) - (char*)&my1),
 			PT_DEFAULT, "0",
 			PT_DESCRIPTION, "limit on number of rows to record (0=none)",
@@ -316,6 +331,21 @@ EXPORT CLASS *init(CALLBACKS *fntable, void *module, int argc, char *argv[])
 			PT_KEYWORD, "DEFAULT", LU_DEFAULT,
 			PT_KEYWORD, "ALL", LU_ALL,
 			PT_KEYWORD, "NONE", LU_NONE,
+		PT_enumeration, "compression", ((char*)&(my1.compression) - (char *)&my1),
+			PT_DESCRIPTION, "method used to omit rows that can be reconstructed within the deadband",
+			PT_DEFAULT, "NONE",
+			PT_KEYWORD, "NONE", RC_NONE,
+			PT_KEYWORD, "DEADBAND", RC_DEADBAND,
+			PT_KEYWORD, "SWINGDOOR", RC_SWINGDOOR,
+		PT_char1024, "deadband", ((char*)&(my1.deadband) - (char *)&my1),
+			PT_DESCRIPTION, "compression tolerance of each property (a value is absolute, a value with % is relative)",
+			PT_DEFAULT, "0",
+		PT_int64, "compressed_rows", ((char*)&(my1.compressed_rows) - (char *)&my1),
+			PT_ACCESS, PA_REFERENCE,
+			PT_DESCRIPTION, "number of rows omitted by compression",
+		PT_int64, "compressed_bytes", ((char*)&(my1.compressed_bytes) - (char *)&my1),
+			PT_ACCESS, PA_REFERENCE,
+			PT_DESCRIPTION, "number of bytes omitted by compression",
 			NULL) < 1)
 		GL_THROW("Could not publish property output for recorder");
 
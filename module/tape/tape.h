@@ -23,6 +23,8 @@ typedef enum {UNKNOWN=0, PLAYER=1, RECORDER=2, GROUPRECORDER=3} DELTATAPEOBJ;
 /* recorder-specific enums */
 typedef enum {HU_DEFAULT, HU_ALL, HU_NONE} HEADERUNITS;
 typedef enum {LU_DEFAULT, LU_ALL, LU_NONE} LINEUNITS;
+typedef enum {RC_NONE, RC_DEADBAND, RC_SWINGDOOR} RECORDERCOMPRESSION;
+typedef enum {MF_WIDE, MF_COLUMNS} MULTIFORMAT;
 
 typedef struct s_tape_operations {
 	int (*open)(void *my, char *fname, char *flags);
@@ -44,6 +46,12 @@ typedef struct s_tape_funcs {
 	struct s_tape_funcs *next;
 } TAPEFUNCS;
 
+/* tape module options shared with the file type libraries (see get_ftable) */
+typedef struct s_tape_options {
+	int32 plot_renderers; /* maximum number of background gnuplot renderers used by plot tapes (0 renders synchronously) */
+	int32 plot_refresh; /* simulation seconds between partial renders of plot tapes (0 disables partial renders) */
+} TAPEOPTIONS;
+
 CDECL TAPEFUNCS *get_ftable(char *mode);
 
 typedef struct {
@@ -159,6 +167,9 @@ struct recorder {
 	FILE *multifp, *inputfp;
 	int16 multirun_ct;
 	char1024 multirun_header;
+	MULTIFORMAT multiformat;
+	bool multimerge;
+	FILE *indexfp;
 	int16 format; /* 0=YYYY-MM-DD HH:MM:SS or strftime_format if non-zero; 1=timestamp */
 	double dInterval;
 	TIMESTAMP interval;
@@ -196,6 +207,11 @@ struct recorder {
 	char256 strftime_format;
 	char *output_format[256];
 	double output_scalar[256];
+	RECORDERCOMPRESSION compression;
+	char1024 deadband;
+	int64 compressed_rows;
+	int64 compressed_bytes;
+	struct s_recorder_compression *compress;
 };
 /** @}
 	@addtogroup collector
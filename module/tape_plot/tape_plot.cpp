@@ -17,10 +17,21 @@
 #include <errno.h>
 #include <ctype.h>
 #include <time.h>
+#include <math.h>
+#include <fcntl.h>
+#ifndef WIN32
+#include <spawn.h>
+#include <sys/wait.h>
+extern char **environ;
+#endif
 
 #include "gridlabd.h"
 #include <tape.h>
 #include "tape_plot.h"
+
+/* set by the tape module when it loads this library (see get_ftable) */
+CALLBACKS *callback = NULL;
+TAPEOPTIONS *tape_options = NULL;
 #define MAXCOLUMNS 50
 
 /*******************************************************************
@@ -267,15 +278,245 @@ EXPORT void close_shaper(struct shaper *my)
 {
 }
 
+/*******************************************************************
+ * renderers 
+ *
+ * Plots are rendered by gnuplot processes that run in the background
+ * so that neither the simulation nor its shutdown waits for them. At
+ * most plot_renderers processes are running at any time.  Final renders
+ * are queued when no slot is free and are started as slots free up;
+ * those still queued at exit are handed to one last gnuplot process.
+ * Partial renders are dropped when no slot is free.
+ */
+#define MAXRENDERERS 64
+static pid_t renderer[MAXRENDERERS];
+static int n_renderers = 0;
+
+struct s_render {
+	char *script;
+	bool persist;
+	struct s_render *next;
+};
+static struct s_render *pending_first = NULL, *pending_last = NULL;
+
+static void reap_renderers(void)
+{
+#ifndef WIN32
+	int n = 0;
+	for ( int i = 0 ; i < n_renderers ; i++ )
+	{
+		if ( waitpid(renderer[i],NULL,WNOHANG) == 0 )
+		{
+			renderer[n++] = renderer[i];
+		}
+	}
+	n_renderers = n;
+#endif
+}
+
+#ifndef WIN32
+static bool spawn_renderer(const char **argv, const char *script)
+{
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_addopen(&actions,0,"/dev/null",O_RDONLY,0);
+	pid_t pid;
+	int rc = posix_spawnp(&pid,"gnuplot",&actions,NULL,(char*const*)argv,environ);
+	posix_spawn_file_actions_destroy(&actions);
+	if ( rc != 0 )
+	{
+		gl_warning("tape_plot: unable to start gnuplot for '%s': %s", script, strerror(rc));
+		return false;
+	}
+	if ( n_renderers < MAXRENDERERS )
+	{
+		renderer[n_renderers++] = pid;
+	}
+	return true;
+}
+
+/* start queued final renders while slots are free */
+static void start_pending_renderers(int max)
+{
+	while ( pending_first != NULL && n_renderers < max )
+	{
+		struct s_render *item = pending_first;
+		pending_first = item->next;
+		if ( pending_first == NULL )
+		{
+			pending_last = NULL;
+		}
+		const char *argv[] = {"gnuplot", item->persist ? "-persist" : item->script, item->persist ? item->script : NULL, NULL};
+		spawn_renderer(argv,item->script);
+		free(item->script);
+		free(item);
+	}
+}
+#endif
+
+/* hand the final renders still queued at exit to one gnuplot process per persist mode */
+static void flush_renderers(void)
+{
+#ifndef WIN32
+	reap_renderers();
+	start_pending_renderers(tape_options->plot_renderers < MAXRENDERERS ? tape_options->plot_renderers : MAXRENDERERS);
+	for ( int persist = 0 ; persist < 2 ; persist++ )
+	{
+		size_t n = 0;
+		for ( struct s_render *item = pending_first ; item != NULL ; item = item->next )
+		{
+			if ( item->persist == (persist!=0) ) n++;
+		}
+		if ( n == 0 )
+		{
+			continue;
+		}
+		const char **argv = (const char**)malloc(sizeof(const char*)*(n+3));
+		if ( argv == NULL )
+		{
+			gl_warning("tape_plot: unable to start the remaining %d gnuplot renders", (int)n);
+			return;
+		}
+		size_t argc = 0;
+		argv[argc++] = "gnuplot";
+		if ( persist )
+		{
+			argv[argc++] = "-persist";
+		}
+		for ( struct s_render *item = pending_first ; item != NULL ; item = item->next )
+		{
+			if ( item->persist == (persist!=0) ) argv[argc++] = item->script;
+		}
+		argv[argc] = NULL;
+		spawn_renderer(argv,argv[persist?2:1]);
+		free(argv);
+	}
+	while ( pending_first != NULL )
+	{
+		struct s_render *item = pending_first;
+		pending_first = item->next;
+		free(item->script);
+		free(item);
+	}
+	pending_last = NULL;
+#endif
+}
+
+/* make sure queued final renders are started at exit (call before registering other exit handlers that close files) */
+static void register_flush_renderers(void)
+{
+	static bool registered = false;
+	if ( ! registered )
+	{
+		atexit(flush_renderers);
+		registered = true;
+	}
+}
+
+static bool start_renderer(const char *script, bool persist, bool partial)
+{
+	int max = tape_options->plot_renderers < MAXRENDERERS ? tape_options->plot_renderers : MAXRENDERERS;
+#ifdef WIN32
+	char command[4096];
+	snprintf(command,sizeof(command)-1,"%s %s %s", max > 0 ? "start wgnuplot" : "wgnuplot", persist ? "-persist" : "", script);
+	return system(command) == 0;
+#else
+	if ( max <= 0 )
+	{
+		char command[4096];
+		snprintf(command,sizeof(command)-1,"gnuplot %s %s", persist ? "-persist" : "", script);
+		return system(command) == 0;
+	}
+	reap_renderers();
+	start_pending_renderers(max);
+	if ( n_renderers >= max )
+	{
+		if ( partial )
+		{
+			return false;
+		}
+		struct s_render *item = (struct s_render*)malloc(sizeof(struct s_render));
+		if ( item == NULL || (item->script=strdup(script)) == NULL )
+		{
+			gl_warning("tape_plot: unable to queue gnuplot render of '%s'", script);
+			free(item);
+			return false;
+		}
+		item->persist = persist;
+		item->next = NULL;
+		if ( pending_last != NULL )
+		{
+			pending_last->next = item;
+		}
+		else
+		{
+			pending_first = item;
+		}
+		pending_last = item;
+		return true;
+	}
+	const char *argv[] = {"gnuplot", persist ? "-persist" : script, persist ? script : NULL, NULL};
+	return spawn_renderer(argv,script);
+#endif
+}
+
 /*******************************************************************
  * recorders 
+ *
+ * Unless plotcommands are given, recorder samples are written to a 
+ * binary file of float64 records (time followed by one value per 
+ * property) and the gnuplot script reads that file directly.  Because
+ * the script is complete when the recorder opens, it can be rendered
+ * at any time, which is how the partial renders work.  When plotcommands
+ * are given the data is written inline after those commands as before.
  */
+struct s_plotstate {
+	struct recorder *rec;
+	bool binary; /* data is in binary file (otherwise inline in script) */
+	unsigned int ncols; /* number of values per record */
+	char script[1025]; /* gnuplot script file name */
+	TIMESTAMP next_refresh; /* time of next partial render */
+	bool complex_warned; /* complex values have been reported */
+	struct s_plotstate *next;
+} *plotstate = NULL;
+
+static struct s_plotstate *get_plotstate(struct recorder *my)
+{
+	struct s_plotstate *state;
+	for ( state = plotstate ; state != NULL ; state = state->next )
+	{
+		if ( state->rec == my )
+		{
+			return state;
+		}
+	}
+	state = (struct s_plotstate*)malloc(sizeof(struct s_plotstate));
+	memset(state,0,sizeof(struct s_plotstate));
+	state->rec = my;
+	state->next = plotstate;
+	plotstate = state;
+	return state;
+}
+
+/* split a script file name into the base name used for the data and image files */
+static void get_basename(const char *fname, char *base, size_t size)
+{
+	const char *dot = strrchr(fname,'.');
+	const char *slash = strrchr(fname,'/');
+	size_t len = ( dot != NULL && ( slash == NULL || dot > slash ) ) ? dot-fname : strlen(fname);
+	if ( len >= size )
+	{
+		len = size-1;
+	}
+	memcpy(base,fname,len);
+	base[len] = '\0';
+}
 
 EXPORT void write_default_plot_commands_rec(struct recorder *my, char32 extension)
 {
-	char fname[sizeof(char32)];
-	char type[sizeof(char32)];
-	char ext[sizeof(char32)];
+	struct s_plotstate *state = get_plotstate(my);
+	char base[1025];
+	char format[MAXCOLUMNS*8+1] = "";
 	char buf[sizeof(char1024)];
 	char plotcommands[sizeof(char1024)];
 	char *item;
@@ -283,36 +524,42 @@ EXPORT void write_default_plot_commands_rec(struct recorder *my, char32 extensio
 
 	int i, j, k;	
 	i = j = k = 0;
-	sscanf(my->file,"%32[^:]:%32[^.].%[^\n;:]",type,fname,ext);
+	get_basename(state->script,base,sizeof(base));
+	for ( unsigned int n = 0 ; n <= state->ncols ; n++ )
+	{
+		strcat(format,"%float64");
+	}
 
 	/////////////////////////////////////////////////////////////////////////////
 	// Default behavior for directive plotcommands
 	/////////////////////////////////////////////////////////////////////////////
 	if (my->plotcommands[0]=='\0' || strcmp(my->plotcommands,"")==0) {
 		j= strlen(my->columns)>0 ? 0: fprintf(my->fp, "set xdata time;\n");
-		fprintf(my->fp, "set datafile separator \",\";\n");
 		if(my->output != SCR){
-			fprintf(my->fp, "set output \"%s.%s\"; \n", fname,extension.get_string());
+			fprintf(my->fp, "set output \"%s.%s\"; \n", base,extension.get_string());
 		}
 		fprintf(my->fp, "show output; \n");
-		fprintf(my->fp, "set timefmt \"%%Y-%%m-%%d %%H:%%M:%%S\";\n");
-		fprintf(my->fp, "set datafile missing 'NaN'\n");
-		//j = strlen(my->columns)>0  ? 0: fprintf(my->fp, "plot \'-\' using 1:2 title '%s' with lines;\n", my->property);
+		if ( state->binary ) {
+			fprintf(my->fp, "set timefmt \"%%s\";\n");
+		} else {
+			fprintf(my->fp, "set datafile separator \",\";\n");
+			fprintf(my->fp, "set timefmt \"%%Y-%%m-%%d %%H:%%M:%%S\";\n");
+			fprintf(my->fp, "set datafile missing 'NaN'\n");
+		}
 		if(strlen(my->columns) > 0){
 			j = 0;
+		} else if ( ! state->binary ) {
+			/* inline data only handles one column */
+			char *last;
+			strcpy(list,my->property);
+			item = strtok_r(list,",",&last);
+			fprintf(my->fp, "plot \'-\' using 1:2 title \'%s\' with lines\n", item ? item : "");
 		} else {
 			strcpy(list,my->property); /* avoid destroying orginal list */
 			k = 2;
 			char *last;
-			for (item=strtok_r(list,",",&last); item!=NULL; item=strtok_r(NULL,",",&last)){
-				if(k == 2){
-					fprintf(my->fp, "plot \'-\' using 1:%i title \'%s\' with lines", k, item);
-					/* only handles one column properly as-is, will be fixed with the tape module update -MH */
-					fprintf(my->fp, "\n");
-					break;
-				}// else {
-				//	fprintf(my->fp, ", \\\n\t\'-\' using 1:%i title \'%s\' with lines", k, item);
-				//}
+			for (item=strtok_r(list,",",&last); item!=NULL && k<=(int)state->ncols+1; item=strtok_r(NULL,",",&last)){
+				fprintf(my->fp, "%s\'%s.bin\' binary format=\"%s\" using 1:%i title \'%s\' with lines", k==2?"plot ":", \\\n\t", base, format, k, item);
 				++k;
 			}
 			fprintf(my->fp, "\n");
@@ -341,10 +588,12 @@ EXPORT int open_recorder(struct recorder *my, char *fname, char *flags)
 	time_t now=time(NULL);
 	OBJECT *obj=OBJECTHDR(my);
 	static int block=0;
+	struct s_plotstate *state = get_plotstate(my);
 
 	set_recorder(my);
 
 	if (!block) {
+		register_flush_renderers(); /* runs after close_recorder_wrapper */
 		atexit(close_recorder_wrapper);
 		block=1;
 	}
@@ -367,6 +616,17 @@ EXPORT int open_recorder(struct recorder *my, char *fname, char *flags)
 	my->last.ts = TS_ZERO;
 	my->status=TS_OPEN;
 	my->samples=0;
+	strncpy(state->script,fname,sizeof(state->script)-1);
+	state->binary = ( my->plotcommands[0] == '\0' && my->fp != stdout );
+	state->ncols = 1;
+	for ( const char *p = my->property ; *p != '\0' ; p++ )
+	{
+		if ( *p == ',' && state->ncols < MAXCOLUMNS )
+		{
+			state->ncols++;
+		}
+	}
+	state->next_refresh = TS_NEVER;
 
 	/* put useful header information in file first */
 	fprintf(my->fp,"# file...... %s\n", my->file.get_string());
@@ -437,11 +697,46 @@ EXPORT int open_recorder(struct recorder *my, char *fname, char *flags)
 	write_default_plot_commands_rec(my, extension);
 	if (my->columns[0]){
 		sscanf(my->columns,"%s", columnlist);
-		fprintf(my->fp, "plot \'-\' using %s with lines;\n", columnlist);
+		if ( state->binary )
+		{
+			char base[1025];
+			get_basename(state->script,base,sizeof(base));
+			fprintf(my->fp, "plot \'%s.bin\' binary format=\"", base);
+			for ( unsigned int n = 0 ; n <= state->ncols ; n++ )
+			{
+				fprintf(my->fp, "%%float64");
+			}
+			fprintf(my->fp, "\" using %s with lines;\n", columnlist);
+		}
+		else
+		{
+			fprintf(my->fp, "plot \'-\' using %s with lines;\n", columnlist);
+		}
 	}
 	
 	free(columns);
 
+	/* the script is complete so the recorder now writes to the binary data file */
+	if ( state->binary )
+	{
+		char base[1025], datafile[1030];
+		fprintf(my->fp,"# end of tape\n");
+		fclose(my->fp);
+		get_basename(state->script,base,sizeof(base));
+		snprintf(datafile,sizeof(datafile)-1,"%s.bin",base);
+		my->fp = fopen(datafile,"wb");
+		if ( my->fp == NULL )
+		{
+			fprintf(stderr, "recorder file %s: %s", datafile, strerror(errno));
+			my->status = TS_DONE;
+			return 0;
+		}
+		if ( tape_options->plot_refresh > 0 )
+		{
+			state->next_refresh = TS_ZERO;
+		}
+	}
+
 	return 1;
 }
 
@@ -466,7 +761,64 @@ void splitString(char *propertyStr, char *columns[])
 
 EXPORT int write_recorder(struct recorder *my, char *timestamp, char *value)
 {
-	return fprintf(my->fp,"%s,%s\n", timestamp, value);
+	struct s_plotstate *state = get_plotstate(my);
+	if ( ! state->binary )
+	{
+		return fprintf(my->fp,"%s,%s\n", timestamp, value);
+	}
+
+	/* INIT samples have no time to plot against */
+	if ( my->last.ts <= TS_ZERO )
+	{
+		return 1;
+	}
+
+	/* gnuplot shows binary times as UTC so shift them to local time */
+	double record[MAXCOLUMNS+1];
+	char buffer[sizeof(my->last.value)];
+	char *item, *last;
+	unsigned int n = 1;
+	DATETIME dt;
+	gl_localtime(my->last.ts,&dt);
+	record[0] = (double)(my->last.ts - dt.tzoffset);
+	strncpy(buffer,value,sizeof(buffer)-1);
+	buffer[sizeof(buffer)-1] = '\0';
+	for ( item = strtok_r(buffer,",",&last) ; item != NULL && n <= state->ncols ; item = strtok_r(NULL,",",&last) )
+	{
+		char *end;
+		double x = strtod(item,&end);
+		if ( end != item && ( *end == '+' || *end == '-' ) )
+		{
+			/* complex values have no single value to plot */
+			if ( ! state->complex_warned )
+			{
+				gl_warning("tape_plot: recorder '%s' has complex values that cannot be plotted, use the real, imag, mag, or arg part of the property instead", my->file.get_string());
+				state->complex_warned = true;
+			}
+			x = NAN;
+		}
+		record[n++] = ( end == item ? NAN : x );
+	}
+	while ( n <= state->ncols )
+	{
+		record[n++] = NAN;
+	}
+	if ( fwrite(record,sizeof(double),state->ncols+1,my->fp) != state->ncols+1 )
+	{
+		return 0;
+	}
+
+	/* partial renders */
+	if ( state->next_refresh != TS_NEVER && my->last.ts >= state->next_refresh )
+	{
+		if ( state->next_refresh > TS_ZERO )
+		{
+			fflush(my->fp);
+			start_renderer(state->script, my->output==SCR, true);
+		}
+		state->next_refresh = my->last.ts + tape_options->plot_refresh;
+	}
+	return (int)(sizeof(double)*(state->ncols+1));
 }
  
 void set_recorder(struct recorder *my)
@@ -476,41 +828,37 @@ void set_recorder(struct recorder *my)
 
 void close_recorder_wrapper(void)
 {
-	struct recorder *my;
-	my = global_rec;
-	close_recorder(my);
+	struct s_plotstate *state;
+	for ( state = plotstate ; state != NULL ; state = state->next )
+	{
+		close_recorder(state->rec);
+	}
 }
 
 EXPORT void close_recorder(struct recorder *my)
 {
-	char gnuplot[1024];
-#ifdef WIN32
-	const char *plotcmd = "start wgnuplot";
-#else
-	const char *plotcmd = "gnuplot";
-#endif
-	if(my->output == SCR)
-		sprintf(gnuplot,"%s -persist", plotcmd);
-	else
-		strcpy(gnuplot,plotcmd);
-	char fname[sizeof(char32)];
-	char type[sizeof(char32)];
-	char command[4096];
+	struct s_plotstate *state = get_plotstate(my);
 
 	my->status = TS_DONE;
 
 	if (my->fp == NULL)
 		return;
+	else if ( state->binary ) {
+		fclose(my->fp);
+	}
 	else {
 		fprintf(my->fp,"e\n");
 		//fprintf(my->fp,"pause -1");// \"PRESS RETURN TO CONTINUE\" \n" );
 		fprintf(my->fp,"# end of tape\n");
+		if ( my->fp == stdout )
+		{
+			my->fp = NULL;
+			return;
+		}
 		fclose(my->fp);
-		sscanf(my->file,"%32[^:]:%32[^:]",type,fname);
-		snprintf(command,sizeof(command)-1,"%s %s", gnuplot, fname);
-		system( command );
 	}
  	my->fp = NULL;
+	start_renderer(state->script, my->output==SCR, false);
 }
 
 /*******************************************************************
@@ -560,6 +908,8 @@ EXPORT int open_collector(struct collector *my, char *fname, char *flags)
 	char columnlist[sizeof(char1024)];
 	char **columns;
 
+	register_flush_renderers();
+
 	columns = (char **)calloc(MAXCOLUMNS, sizeof(char *));
 	for(int i=0; i<MAXCOLUMNS; i++){
 		columns[i] = (char *)malloc(33);
@@ -657,15 +1007,10 @@ EXPORT int write_collector(struct collector *my, char *timestamp, char *value)
 EXPORT void close_collector(struct collector *my)
 {
 #ifdef WIN32
-	char gnuplot[sizeof(char32)];
-	strcpy(gnuplot,"wgnuplot ");
 	_putenv("PATH=%PATH%;C:\\wgnuplot");
-#else
-	const char *gnuplot = "gnuplot ";
 #endif
-	char fname[sizeof(char32)];
+	char fname[sizeof(char1024)];
 	char type[sizeof(char32)];
-	char command[sizeof(char1024)];
 
 	my->status = TS_DONE;
 
@@ -673,12 +1018,11 @@ EXPORT void close_collector(struct collector *my)
 		return;
 	else {
 		fprintf(my->fp,"e\n");
-		fprintf(my->fp,"pause -1");// \"PRESS RETURN TO CONTINUE\" \n" );
 		fprintf(my->fp,"# end of tape\n");
 		fclose(my->fp);
-		sscanf(my->file,"%32[^:]:%32[^:]",type,fname);
-		sprintf(command,"%s %s", gnuplot, fname);
-		system( command );
+		if ( sscanf(my->file,"%32[^:]:%1024[^:]",type,fname) < 2 )
+			strcpy(fname,my->file);
+		start_renderer(fname, my->output==SCR, false);
 	}
  	my->fp = NULL;
 }